@@ -0,0 +1,985 @@
+/*
+ * bench.c - Simulation Benchmarks
+ */
+
+#include "bench.h"
+#include "ftl.h"
+#include "sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <stdbool.h>
+
+#define BENCH_SEED          42
+#define BENCH_ERASE_ROUNDS  2000
+#define BENCH_HOT_LBAS      176         // 쓰기의 80%가 몰리는 앞쪽 LBA
+#define BENCH_ZNS_RESERVE   2           // 호스트 GC가 남겨 둘 빈 zone (온도별 open zone 교체 + GC 대상)
+
+typedef struct {
+    double seconds;
+    uint64_t host_ops;          // write + read
+    uint64_t erases;
+    uint64_t page_writes;
+    uint32_t payload_peak;      // 동시에 살아 있던 payload slot 최대치
+    uint32_t checksum;          // 마지막에 읽은 전체 LBA 값의 합 (모드 간 결과 비교용)
+} BenchResult;
+
+// stdout을 잠시 버림 (GC 로그 억제)
+int bench_quiet_begin(void) {
+    fflush(stdout);
+    int saved = dup(STDOUT_FILENO);
+    int null_fd = open("/dev/null", O_WRONLY);
+    dup2(null_fd, STDOUT_FILENO);
+    close(null_fd);
+    return saved;
+}
+
+void bench_quiet_end(int saved) {
+    fflush(stdout);
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+}
+
+static double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// 새 NAND를 가진 FTL (mount 전에 호출자가 NAND 구성을 바꿀 수 있음)
+static FTL *bench_ftl_open(void) {
+    FTL *ftl = calloc(1, sizeof(FTL));
+    if (ftl && nand_init(&ftl->nand) != 0) {
+        free(ftl);
+        return NULL;
+    }
+    return ftl;
+}
+
+// i번째 쓰기의 LBA: 처음엔 전체 LBA를 순서대로 채우고, 이후 hot 80% / cold 20% 무작위
+static uint32_t bench_next_lba(uint32_t i) {
+    if (i < TOTAL_LOGICAL_PAGES) {
+        return i;
+    }
+    return (rand() % 100 < 80) ? (uint32_t)rand() % BENCH_HOT_LBAS : (uint32_t)rand() % TOTAL_LOGICAL_PAGES;
+}
+
+// 전체 LBA를 채운 뒤 hot 80% / cold 20% 무작위 덮어쓰기, 쓰기 4번마다 읽기 1번
+static BenchResult bench_workload(FTL *ftl, uint32_t writes) {
+    BenchResult r = {0};
+    uint8_t buf[PAGE_SIZE];
+    int saved = bench_quiet_begin();
+    double start = bench_now();
+
+    ftl_mount(ftl);
+    srand(BENCH_SEED);
+    for (uint32_t i = 0; i < TOTAL_LOGICAL_PAGES + writes; i++) {
+        uint32_t lba = bench_next_lba(i);
+        memset(buf, 0, PAGE_SIZE);
+        memcpy(buf, &i, sizeof(i));
+        ftl_write(ftl, lba, buf);
+        r.host_ops++;
+        if (i % 4 == 0) {
+            ftl_read(ftl, rand() % TOTAL_LOGICAL_PAGES, buf);
+            r.host_ops++;
+        }
+    }
+    ftl_sync(ftl);
+
+    r.seconds = bench_now() - start;
+    for (uint32_t lba = 0; lba < TOTAL_LOGICAL_PAGES; lba++) {
+        uint32_t value = 0;
+        if (ftl_read(ftl, lba, buf) == 0) {
+            memcpy(&value, buf, sizeof(value));
+        }
+        r.checksum += value * (lba + 1);
+    }
+    r.erases = ftl->nand.total_block_erases;
+    r.page_writes = ftl->nand.total_page_writes;
+    r.payload_peak = ftl->nand.payload ? ftl->nand.payload->peak : 0;
+    ftl_unmount(ftl);
+    bench_quiet_end(saved);
+    return r;
+}
+
+// 블록 하나를 채우고 지우기를 반복 (erase 시간만 측정)
+static double bench_erase_ns(NANDFlash *nand, uint8_t mode) {
+    uint8_t buf[PAGE_SIZE];
+    double total = 0.0;
+
+    memset(buf, 0xA5, PAGE_SIZE);
+    nand->erase_mode = mode;
+    for (uint32_t r = 0; r < BENCH_ERASE_ROUNDS; r++) {
+        for (uint32_t p = 0; p < PAGES_PER_BLOCK; p++) {
+            nand_write_page(nand, p, buf, p);
+        }
+        double start = bench_now();
+        nand_erase_block(nand, 0);
+        total += bench_now() - start;
+    }
+    return total * 1e9 / BENCH_ERASE_ROUNDS;
+}
+
+void bench_erase_modes(uint32_t writes) {
+    static const uint8_t modes[2] = { NAND_ERASE_EAGER, NAND_ERASE_LAZY };
+    static const char *names[2] = { "eager", "lazy" };
+    BenchResult res[2];
+    double erase_ns[2];
+    FTL *ftl = bench_ftl_open();
+
+    if (!ftl) {
+        return;
+    }
+    for (int m = 0; m < 2; m++) {
+        erase_ns[m] = bench_erase_ns(&ftl->nand, modes[m]);
+    }
+    nand_release(&ftl->nand);
+    free(ftl);
+
+    for (int m = 0; m < 2; m++) {
+        ftl = bench_ftl_open();
+        if (!ftl) {
+            return;
+        }
+        ftl->nand.erase_mode = modes[m];
+        res[m] = bench_workload(ftl, writes);
+        nand_release(&ftl->nand);
+        free(ftl);
+    }
+
+    printf("\n========== Erase Mode Benchmark (%u random writes) ==========\n", writes);
+    printf("%-8s %14s %10s %12s %14s\n", "Mode", "erase ns/blk", "erases", "sim time", "host ops/s");
+    for (int m = 0; m < 2; m++) {
+        printf("%-8s %14.0f %10lu %10.3f s %14.0f\n", names[m], erase_ns[m], res[m].erases,
+               res[m].seconds, res[m].seconds > 0 ? res[m].host_ops / res[m].seconds : 0.0);
+    }
+    printf("Lazy erase: %.1fx cheaper per erase, %.2fx simulation throughput\n",
+           erase_ns[1] > 0 ? erase_ns[0] / erase_ns[1] : 0.0,
+           res[1].seconds > 0 ? res[0].seconds / res[1].seconds : 0.0);
+    printf("=============================================================\n");
+}
+
+void bench_payload_store(uint32_t capacity_gb, uint32_t pages) {
+    uint64_t slots = (uint64_t)capacity_gb * (1u << 30) / PAGE_SIZE;
+    size_t rss_before = payload_process_rss();
+
+    if (slots == 0 || slots >= PAYLOAD_NO_SLOT) {
+        printf("[Bench] capacity must be 1 ~ %u GB\n", (uint32_t)((uint64_t)PAYLOAD_NO_SLOT * PAGE_SIZE >> 30) - 1);
+        return;
+    }
+    PayloadStore *ps = payload_create((uint32_t)slots, PAGE_SIZE, false);
+    if (!ps) {
+        return;
+    }
+
+    // 앞쪽 pages개를 program하고 그 절반을 erase (반납된 slot은 다시 할당에 쓰임)
+    double start = bench_now();
+    uint32_t *slot = malloc((size_t)pages * sizeof(uint32_t));
+    uint32_t written = 0;
+    for (; slot && written < pages; written++) {
+        slot[written] = payload_alloc(ps);
+        if (slot[written] == PAYLOAD_NO_SLOT) break;
+        memset(payload_ptr(ps, slot[written]), (int)(written & 0xFF), PAGE_SIZE);
+    }
+    for (uint32_t i = 0; i < written; i += 2) {
+        payload_free(ps, slot[i]);
+    }
+    double elapsed = bench_now() - start;
+    size_t rss_after = payload_process_rss();
+
+    printf("\n========== Sparse Payload Store ==========\n");
+    printf("Simulated capacity:  %u GB (%lu pages, %.1f GB reserved address space)\n",
+           capacity_gb, (unsigned long)slots, ps->map_bytes / 1073741824.0);
+    printf("Programmed:          %u pages (%.1f MB), then erased every other page\n",
+           written, (double)written * PAGE_SIZE / 1048576.0);
+    printf("Live / resident:     %u pages, %u slabs = %.1f MB%s\n", ps->used, ps->slabs_resident,
+           payload_resident_bytes(ps) / 1048576.0, ps->hugepage ? " (huge pages)" : "");
+    printf("Process RSS growth:  %.1f MB (%.4f%% of simulated capacity)\n",
+           (rss_after - rss_before) / 1048576.0,
+           100.0 * (rss_after - rss_before) / ((double)slots * PAGE_SIZE));
+    printf("Time:                %.3f s\n", elapsed);
+    printf("==========================================\n");
+
+    free(slot);
+    payload_destroy(ps);
+}
+
+void bench_payload_modes(uint32_t writes) {
+    static const char *names[2] = { "full", "meta" };
+    BenchResult res[2];
+
+    for (int m = 0; m < 2; m++) {
+        FTL *ftl = bench_ftl_open();
+        if (!ftl) {
+            return;
+        }
+        ftl->nand.metadata_only = m == 1;
+        res[m] = bench_workload(ftl, writes);
+        nand_release(&ftl->nand);
+        free(ftl);
+    }
+
+    printf("\n========== Payload Mode Benchmark (%u random writes) ==========\n", writes);
+    printf("%-6s %12s %10s %14s %16s %12s\n", "Mode", "sim time", "erases", "host ops/s", "payload peak", "checksum");
+    for (int m = 0; m < 2; m++) {
+        printf("%-6s %10.3f s %10lu %14.0f %10u pages   0x%08X\n", names[m], res[m].seconds, res[m].erases,
+               res[m].seconds > 0 ? res[m].host_ops / res[m].seconds : 0.0, res[m].payload_peak, res[m].checksum);
+    }
+    printf("Metadata-only: %.2fx simulation throughput, %.1f%% of payload memory, %s\n",
+           res[1].seconds > 0 ? res[0].seconds / res[1].seconds : 0.0,
+           res[0].payload_peak ? 100.0 * res[1].payload_peak / res[0].payload_peak : 0.0,
+           res[0].checksum == res[1].checksum && res[0].page_writes == res[1].page_writes &&
+           res[0].erases == res[1].erases ? "same FTL result" : "RESULT MISMATCH");
+    printf("================================================================\n");
+}
+
+// ==================== ZNS vs DEVICE FTL ====================
+
+// NAND 연산 수로 계산한 모델 시간 (두 인터페이스에 같은 기준 적용)
+static uint64_t bench_model_us(const NANDFlash *nand) {
+    return nand->total_page_writes * NAND_T_PROG_US + nand->total_page_reads * NAND_T_READ_US +
+           nand->total_block_erases * NAND_T_BERS_US;
+}
+
+// zone 위의 호스트 쪽 배치: LBA 온도별로 open zone을 따로 쓰고, 빈 zone이 모자라면
+// 유효 page가 가장 적은 full zone을 골라 cold zone으로 옮긴 뒤 reset
+typedef struct {
+    FTL *ftl;
+    uint32_t l2p[TOTAL_LOGICAL_PAGES];      // 호스트 LBA -> zone LBA
+    uint32_t owner[TOTAL_PAGES];            // zone LBA -> 호스트 LBA
+    uint32_t valid[ZNS_MAX_ZONES];
+    uint32_t active[2];                     // 0 = hot, 1 = cold
+    uint64_t gc_pages;
+} BenchHost;
+
+static uint32_t bench_host_empty_zones(BenchHost *h) {
+    uint32_t n = 0;
+
+    for (uint32_t z = 0; z < h->ftl->zns.zones; z++) {
+        if (h->ftl->zns.zone[z].state == ZONE_EMPTY) n++;
+    }
+    return n;
+}
+
+static int bench_host_place(BenchHost *h, uint32_t lba, const uint8_t *data, int temp) {
+    Zns *zns = &h->ftl->zns;
+    uint32_t z = h->active[temp];
+
+    if (z == 0xFFFFFFFF || zns->zone[z].state == ZONE_FULL) {
+        z = 0xFFFFFFFF;
+        for (uint32_t i = 0; i < zns->zones && z == 0xFFFFFFFF; i++) {
+            if (zns->zone[i].state == ZONE_EMPTY) z = i;
+        }
+        if (z == 0xFFFFFFFF) {
+            return -1;
+        }
+        h->active[temp] = z;
+    }
+    uint32_t zlba = zns_append(h->ftl, z, data);
+    if (zlba == 0xFFFFFFFF) {
+        return -1;
+    }
+    uint32_t old = h->l2p[lba];
+    if (old != 0xFFFFFFFF) {
+        h->owner[old] = 0xFFFFFFFF;
+        h->valid[old / zns->zone_pages]--;
+    }
+    h->l2p[lba] = zlba;
+    h->owner[zlba] = lba;
+    h->valid[z]++;
+    return 0;
+}
+
+static void bench_host_gc(BenchHost *h) {
+    Zns *zns = &h->ftl->zns;
+    uint8_t buf[PAGE_SIZE];
+
+    while (bench_host_empty_zones(h) < BENCH_ZNS_RESERVE) {
+        uint32_t victim = 0xFFFFFFFF;
+        for (uint32_t z = 0; z < zns->zones; z++) {
+            if (zns->zone[z].state != ZONE_FULL || z == h->active[0] || z == h->active[1]) continue;
+            if (victim == 0xFFFFFFFF || h->valid[z] < h->valid[victim]) victim = z;
+        }
+        if (victim == 0xFFFFFFFF) {
+            return;
+        }
+        for (uint32_t zlba = victim * zns->zone_pages; zlba < (victim + 1) * zns->zone_pages; zlba++) {
+            if (h->owner[zlba] == 0xFFFFFFFF || zns_read(h->ftl, zlba, buf) != 0) continue;
+            if (bench_host_place(h, h->owner[zlba], buf, 1) != 0) {
+                return;
+            }
+            h->gc_pages++;
+        }
+        zns_reset(h->ftl, victim);
+    }
+}
+
+typedef struct {
+    double waf;
+    uint64_t erases;
+    uint64_t model_us;
+    double avg_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+} BenchIface;
+
+static int bench_cmp_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+// 무작위 구간(채우기 이후)만 집계
+static BenchIface bench_iface_result(const NANDFlash *nand, uint64_t writes_before, uint64_t erases_before,
+                                     uint32_t *lat, uint32_t writes) {
+    BenchIface r = {0};
+    uint64_t total = 0;
+
+    for (uint32_t i = 0; i < writes; i++) total += lat[i];
+    qsort(lat, writes, sizeof(uint32_t), bench_cmp_u32);
+    r.waf = writes ? (double)(nand->total_page_writes - writes_before) / writes : 0.0;
+    r.erases = nand->total_block_erases - erases_before;
+    r.model_us = total;
+    r.avg_us = writes ? (double)total / writes : 0.0;
+    r.p99_us = writes ? lat[(uint32_t)((writes - 1) * 0.99)] : 0;
+    r.max_us = writes ? lat[writes - 1] : 0;
+    return r;
+}
+
+void bench_zns(uint32_t writes) {
+    uint32_t *lat = malloc((size_t)(writes ? writes : 1) * sizeof(uint32_t));
+    BenchHost *h = calloc(1, sizeof(BenchHost));
+    uint8_t buf[PAGE_SIZE];
+    BenchIface res[2];
+    bool ok = lat && h;
+
+    // 1) 일반 블록 인터페이스 (device FTL: 매핑 + GC)
+    FTL *ftl = ok ? bench_ftl_open() : NULL;
+    ok = ftl != NULL;
+    if (ok) {
+        int saved = bench_quiet_begin();
+        ftl_mount(ftl);
+        srand(BENCH_SEED);
+        uint64_t w0 = 0, e0 = 0;
+        for (uint32_t i = 0; i < TOTAL_LOGICAL_PAGES + writes; i++) {
+            uint32_t lba = bench_next_lba(i);
+            if (i == TOTAL_LOGICAL_PAGES) {
+                w0 = ftl->nand.total_page_writes;
+                e0 = ftl->nand.total_block_erases;
+            }
+            memset(buf, 0, PAGE_SIZE);
+            memcpy(buf, &i, sizeof(i));
+            uint64_t before = bench_model_us(&ftl->nand);
+            ftl_write(ftl, lba, buf);
+            if (i >= TOTAL_LOGICAL_PAGES) {
+                lat[i - TOTAL_LOGICAL_PAGES] = (uint32_t)(bench_model_us(&ftl->nand) - before);
+            }
+        }
+        res[0] = bench_iface_result(&ftl->nand, w0, e0, lat, writes);
+        ftl_unmount(ftl);
+        bench_quiet_end(saved);
+        nand_release(&ftl->nand);
+        free(ftl);
+    }
+
+    // 2) ZNS + 호스트 배치 (같은 LBA 순서, device GC 없음)
+    ftl = ok ? bench_ftl_open() : NULL;
+    ok = ftl != NULL;
+    if (ok) {
+        int saved = bench_quiet_begin();
+        ftl_mount(ftl);
+        ok = zns_enable(ftl, 1) == 0;
+        memset(h->l2p, 0xFF, sizeof(h->l2p));
+        memset(h->owner, 0xFF, sizeof(h->owner));
+        h->ftl = ftl;
+        h->active[0] = h->active[1] = 0xFFFFFFFF;
+        srand(BENCH_SEED);
+        uint64_t w0 = 0, e0 = 0;
+        for (uint32_t i = 0; ok && i < TOTAL_LOGICAL_PAGES + writes; i++) {
+            uint32_t lba = bench_next_lba(i);
+            if (i == TOTAL_LOGICAL_PAGES) {
+                w0 = ftl->nand.total_page_writes;
+                e0 = ftl->nand.total_block_erases;
+            }
+            memset(buf, 0, PAGE_SIZE);
+            memcpy(buf, &i, sizeof(i));
+            uint64_t before = bench_model_us(&ftl->nand);
+            ok = bench_host_place(h, lba, buf, lba < BENCH_HOT_LBAS ? 0 : 1) == 0;
+            bench_host_gc(h);
+            if (i >= TOTAL_LOGICAL_PAGES) {
+                lat[i - TOTAL_LOGICAL_PAGES] = (uint32_t)(bench_model_us(&ftl->nand) - before);
+            }
+        }
+        // 호스트 매핑으로 전체 LBA를 읽어 마지막 값 확인
+        for (uint32_t lba = 0; ok && lba < TOTAL_LOGICAL_PAGES; lba++) {
+            ok = h->l2p[lba] != 0xFFFFFFFF && zns_read(ftl, h->l2p[lba], buf) == 0;
+        }
+        res[1] = bench_iface_result(&ftl->nand, w0, e0, lat, writes);
+        ftl_unmount(ftl);
+        bench_quiet_end(saved);
+        nand_release(&ftl->nand);
+        free(ftl);
+    }
+
+    if (ok) {
+        static const char *names[2] = { "device FTL", "ZNS + host" };
+        printf("\n========== ZNS vs Device FTL (%u random writes after fill) ==========\n", writes);
+        printf("%-12s %6s %8s %10s %10s %10s %12s\n", "Interface", "WAF", "erases", "avg us", "p99 us", "max us", "model s");
+        for (int m = 0; m < 2; m++) {
+            printf("%-12s %6.2f %8lu %10.0f %10u %10u %12.2f\n", names[m], res[m].waf, res[m].erases,
+                   res[m].avg_us, res[m].p99_us, res[m].max_us, res[m].model_us / 1e6);
+        }
+        printf("Host placement: hot LBA < %d and cold data in separate zones, %lu pages moved by host GC\n",
+               BENCH_HOT_LBAS, h->gc_pages);
+        printf("======================================================================\n");
+    } else {
+        printf("[Bench] ZNS benchmark failed\n");
+    }
+    free(h);
+    free(lat);
+}
+
+// ==================== NAMESPACES / NOISY NEIGHBOUR ====================
+
+#define BENCH_NS_SEQ_PAGES      300     // tenant A: 순차 덮어쓰기
+#define BENCH_NS_RAND_PAGES     500     // tenant B: 균등 무작위 덮어쓰기 (noisy neighbour)
+#define BENCH_NS_SEQ_POOL       8       // 전용 pool 시나리오에서 A가 받는 블록
+#define BENCH_NS_RAND_RATE      200     // token bucket 시나리오에서 B의 초당 쓰기 한도
+#define BENCH_NS_SEQ_GAP_US     8000    // A 요청 평균 도착 간격 (간격 0.5x ~ 1.5x 균등)
+#define BENCH_NS_RAND_GAP_US    4000    // B 요청 평균 도착 간격 (B 한도보다 빠르게 요청)
+
+typedef struct {
+    uint32_t writes;
+    double waf;
+    uint64_t gc_moved;
+    uint64_t interference;
+    double avg_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+} BenchTenant;
+
+// A / B 요청이 tenant마다 독립적인 도착 간격으로 들어오고 (open loop, tenant별 FIFO),
+// arbiter가 모델 시간에서 도착한 요청 중 다음 명령을 고름.
+// 지연 = 각 요청의 도착 시각부터 완료까지 (다른 tenant 명령 대기 + token 대기 + 자기 program / GC)
+static int bench_ns_run(uint32_t pool_a, uint32_t rate_b, uint32_t writes, BenchTenant *res) {
+    uint32_t *lat[2] = { malloc((size_t)(writes ? writes : 1) * sizeof(uint32_t)),
+                         malloc((size_t)(writes ? writes : 1) * sizeof(uint32_t)) };
+    FTL *ftl = bench_ftl_open();
+    uint8_t buf[PAGE_SIZE];
+    int ret = -1;
+
+    if (ftl && lat[0] && lat[1]) {
+        int saved = bench_quiet_begin();
+        ftl_mount(ftl);
+        if (ns_add(ftl, BENCH_NS_SEQ_PAGES, pool_a) == 0 && ns_add(ftl, BENCH_NS_RAND_PAGES, 0) == 1) {
+            NsTable *t = &ftl->ns;
+            static const uint32_t gap_us[2] = { BENCH_NS_SEQ_GAP_US, BENCH_NS_RAND_GAP_US };
+            uint32_t count[2] = {0, 0}, seq = 0;
+            uint64_t now = 0, arrival[2];
+
+            if (rate_b) {
+                ns_set_qos(t, 1, NS_WEIGHT_DEFAULT, rate_b);
+            }
+            // 두 namespace를 한 번씩 채운 뒤 통계 초기화
+            memset(buf, 0, PAGE_SIZE);
+            for (uint32_t lba = 0; lba < BENCH_NS_SEQ_PAGES + BENCH_NS_RAND_PAGES; lba++) {
+                ftl_write(ftl, lba, buf);
+            }
+            for (uint32_t n = 0; n < 2; n++) {
+                t->ns[n].host_writes = t->ns[n].gc_migrated = t->ns[n].gc_caused = 0;
+                t->ns[n].interference = t->ns[n].latency_us = t->ns[n].latency_max_us = 0;
+            }
+
+            srand(BENCH_SEED);
+            arrival[0] = (uint64_t)rand() % gap_us[0];
+            arrival[1] = (uint64_t)rand() % gap_us[1];
+            while (count[0] + count[1] < writes) {
+                bool ready[2] = { arrival[0] <= now, arrival[1] <= now };
+                uint64_t next = UINT64_MAX;
+                uint8_t n = ns_arbitrate(t, ready, now, &next);
+                if (n == NS_NONE) {
+                    // 다음 도착 또는 token 보충까지 대기
+                    for (uint32_t k = 0; k < 2; k++) {
+                        if (!ready[k] && arrival[k] < next) next = arrival[k];
+                    }
+                    now = next;
+                    continue;
+                }
+                ns_charge(t, n);
+                uint32_t lba = n == 0 ? t->ns[0].base + seq++ % t->ns[0].pages
+                                      : t->ns[1].base + (uint32_t)rand() % t->ns[1].pages;
+                uint32_t i = count[0] + count[1];
+                memcpy(buf, &i, sizeof(i));
+                uint64_t before = bench_model_us(&ftl->nand);
+                ftl_write(ftl, lba, buf);
+                now += NAND_T_XFER_US + bench_model_us(&ftl->nand) - before;
+                lat[n][count[n]++] = (uint32_t)(now - arrival[n]);
+                arrival[n] += gap_us[n] / 2 + (uint32_t)rand() % gap_us[n];
+            }
+
+            for (uint32_t n = 0; n < 2; n++) {
+                Namespace *ns = &t->ns[n];
+                BenchIface l = bench_iface_result(&ftl->nand, 0, 0, lat[n], count[n]);
+                res[n].writes = count[n];
+                res[n].waf = ns->host_writes ? (double)(ns->host_writes + ns->gc_migrated) / ns->host_writes : 0.0;
+                res[n].gc_moved = ns->gc_migrated;
+                res[n].interference = ns->interference;
+                res[n].avg_us = l.avg_us;
+                res[n].p99_us = l.p99_us;
+                res[n].max_us = l.max_us;
+            }
+            ret = 0;
+        }
+        ftl_unmount(ftl);
+        bench_quiet_end(saved);
+        nand_release(&ftl->nand);
+    }
+    free(ftl);
+    free(lat[0]);
+    free(lat[1]);
+    return ret;
+}
+
+void bench_namespaces(uint32_t writes) {
+    static const char *names[3] = { "shared pool", "dedicated pool", "dedicated + B limit" };
+    static const char *tenants[2] = { "A seq", "B rand" };
+    BenchTenant res[3][2];
+
+    if (bench_ns_run(0, 0, writes, res[0]) != 0 ||
+        bench_ns_run(BENCH_NS_SEQ_POOL, 0, writes, res[1]) != 0 ||
+        bench_ns_run(BENCH_NS_SEQ_POOL, BENCH_NS_RAND_RATE, writes, res[2]) != 0) {
+        printf("[Bench] Namespace benchmark failed\n");
+        return;
+    }
+
+    printf("\n========== Namespaces: sequential tenant vs noisy random tenant (%u writes) ==========\n", writes);
+    printf("%-20s %-7s %7s %6s %9s %8s %9s %9s %9s\n", "Scenario", "Tenant", "writes", "WAF",
+           "GC moved", "interf", "avg ms", "p99 ms", "max ms");
+    for (int s = 0; s < 3; s++) {
+        for (int n = 0; n < 2; n++) {
+            BenchTenant *r = &res[s][n];
+            printf("%-20s %-7s %7u %6.2f %9lu %8lu %9.2f %9.2f %9.2f\n", n ? "" : names[s], tenants[n],
+                   r->writes, r->waf, r->gc_moved, r->interference, r->avg_us / 1000.0,
+                   r->p99_us / 1000.0, r->max_us / 1000.0);
+        }
+    }
+    printf("A: LBA 0-%d, B: LBA %d-%d, equal weights. Dedicated: A owns %d blocks, B shares the rest.\n",
+           BENCH_NS_SEQ_PAGES - 1, BENCH_NS_SEQ_PAGES, BENCH_NS_SEQ_PAGES + BENCH_NS_RAND_PAGES - 1,
+           BENCH_NS_SEQ_POOL);
+    printf("Arrivals: A every %.0f ms, B every %.0f ms on average; latency = arrival to completion\n",
+           BENCH_NS_SEQ_GAP_US / 1000.0, BENCH_NS_RAND_GAP_US / 1000.0);
+    printf("B limit: token bucket %d writes/s. interf = A/B pages moved by GC the other tenant triggered\n",
+           BENCH_NS_RAND_RATE);
+    printf("======================================================================================\n");
+}
+
+// ==================== I/O SCHEDULER ====================
+
+#define BENCH_SCHED_WRITE_GAP_US    5000    // 쓰기 도착 간격 (균등 무작위 LBA, GC가 잦음)
+#define BENCH_SCHED_READS_PER_WRITE 4       // 쓰기 사이에 고르게 도착하는 read 수
+
+typedef struct {
+    double read_avg_us;
+    uint32_t read_p99_us;
+    uint32_t read_p999_us;
+    uint32_t read_max_us;
+    double write_avg_us;
+    uint64_t suspends;
+    uint64_t suspend_denied;
+    uint64_t forced_bg;
+    uint32_t checksum;
+} BenchSched;
+
+// 채운 장치에 일정한 간격으로 쓰기 / read를 보내고 스케줄러 모드만 바꿔 read 지연 비교
+static int bench_sched_run(SchedMode mode, uint32_t writes, BenchSched *r) {
+    uint32_t reads = writes * BENCH_SCHED_READS_PER_WRITE;
+    uint32_t *lat = malloc((size_t)(reads ? reads : 1) * sizeof(uint32_t));
+    FTL *ftl = bench_ftl_open();
+    uint8_t buf[PAGE_SIZE];
+    uint32_t done = 0;
+
+    memset(r, 0, sizeof(BenchSched));
+    if (ftl && lat) {
+        int saved = bench_quiet_begin();
+        ftl_mount(ftl);
+        memset(buf, 0, PAGE_SIZE);
+        for (uint32_t lba = 0; lba < TOTAL_LOGICAL_PAGES; lba++) {
+            ftl_write(ftl, lba, buf);
+        }
+        sched_init(&ftl->sched, mode);
+
+        srand(BENCH_SEED);
+        uint64_t now = 0;
+        for (uint32_t i = 0; i < writes; i++) {
+            sched_set_time(&ftl->sched, now);
+            memcpy(buf, &i, sizeof(i));
+            ftl_write(ftl, (uint32_t)rand() % TOTAL_LOGICAL_PAGES, buf);
+            for (uint32_t k = 1; k <= BENCH_SCHED_READS_PER_WRITE; k++) {
+                sched_set_time(&ftl->sched, now + k * BENCH_SCHED_WRITE_GAP_US / (BENCH_SCHED_READS_PER_WRITE + 1));
+                if (ftl_read(ftl, (uint32_t)rand() % TOTAL_LOGICAL_PAGES, buf) == 0) {
+                    lat[done++] = ftl->sched.last_read_us;
+                    r->checksum += buf[0] | buf[1] << 8;
+                }
+            }
+            now += BENCH_SCHED_WRITE_GAP_US;
+        }
+        sched_drain(&ftl->sched);
+
+        IoSched *s = &ftl->sched;
+        BenchIface l = bench_iface_result(&ftl->nand, 0, 0, lat, done);
+        r->read_avg_us = l.avg_us;
+        r->read_p99_us = l.p99_us;
+        r->read_p999_us = done ? lat[(uint32_t)((done - 1) * 0.999)] : 0;
+        r->read_max_us = l.max_us;
+        r->write_avg_us = s->writes ? (double)s->write_total_us / s->writes : 0.0;
+        r->suspends = s->suspends;
+        r->suspend_denied = s->suspend_denied;
+        r->forced_bg = s->forced_bg;
+        ftl_unmount(ftl);
+        bench_quiet_end(saved);
+        nand_release(&ftl->nand);
+    }
+    free(ftl);
+    free(lat);
+    return done == reads ? 0 : -1;
+}
+
+void bench_sched(uint32_t writes) {
+    static const SchedMode modes[3] = { SCHED_FIFO, SCHED_READ_PRIORITY, SCHED_SUSPEND };
+    BenchSched res[3];
+
+    for (int m = 0; m < 3; m++) {
+        if (bench_sched_run(modes[m], writes, &res[m]) != 0) {
+            printf("[Bench] I/O scheduler benchmark failed\n");
+            return;
+        }
+    }
+
+    printf("\n========== I/O Scheduler: host read latency under GC (%u writes, %u reads) ==========\n",
+           writes, writes * BENCH_SCHED_READS_PER_WRITE);
+    printf("%-14s %9s %9s %9s %9s %10s %9s %8s %8s\n", "Mode", "read avg", "p99", "p99.9", "max",
+           "write avg", "suspends", "denied", "forced");
+    for (int m = 0; m < 3; m++) {
+        BenchSched *r = &res[m];
+        printf("%-14s %9.0f %9u %9u %9u %10.0f %9lu %8lu %8lu\n", sched_mode_name(modes[m]), r->read_avg_us,
+               r->read_p99_us, r->read_p999_us, r->read_max_us, r->write_avg_us, r->suspends,
+               r->suspend_denied, r->forced_bg);
+    }
+    printf("(us, model time) write every %d us, uniform random LBAs; same data in all modes: %s\n",
+           BENCH_SCHED_WRITE_GAP_US,
+           res[0].checksum == res[1].checksum && res[1].checksum == res[2].checksum ? "yes" : "NO");
+    printf("Limits: %d reads ahead of background, %d suspends per program / erase\n",
+           SCHED_READ_BURST_MAX, SCHED_MAX_SUSPENDS);
+    printf("======================================================================================\n");
+}
+
+// ==================== DISCRETE-EVENT SIMULATION ====================
+
+#define BENCH_SIM_MEAN_GAP_US   3000        // 요청 도착 간격 평균 (0 ~ 2배 균등)
+#define BENCH_SIM_READ_PCT      50
+#define BENCH_SIM_IDLE_US       2000        // 이 시간 동안 요청이 없으면 유휴 GC
+#define BENCH_SIM_HOSTQ         256         // device 앞에 쌓일 수 있는 요청 (넘치면 거절)
+#define BENCH_SIM_BG_TAG        0xFFFFFFFF  // 유휴 GC 완료 이벤트
+
+typedef struct {
+    uint64_t arrival_us;
+    uint32_t lba;
+    bool read;
+} BenchSimReq;
+
+typedef struct {
+    uint64_t events;
+    uint64_t vtime_us;          // 요청 구간의 가상 시간
+    double wall_s;
+    uint32_t reads;
+    uint32_t writes;
+    uint32_t rejected;
+    BenchIface read_lat;
+    BenchIface write_lat;
+    uint64_t idle_gc;
+    uint64_t fg_gc;
+    uint64_t hash;              // 최종 NAND 상태 + 모든 지연의 FNV-1a
+} BenchSim;
+
+static uint64_t bench_fnv(uint64_t h, const void *p, size_t n) {
+    const uint8_t *b = p;
+    for (size_t i = 0; i < n; i++) {
+        h = (h ^ b[i]) * 0x100000001B3ull;
+    }
+    return h;
+}
+
+// 요청 도착 / 완료 / 유휴 GC를 이벤트로 처리. device는 명령을 하나씩 처리하고,
+// 명령의 완료 시각은 NAND 가상 시각 (시작 시각 + 그 명령이 낸 NAND 연산 시간)
+static int bench_sim_run(uint32_t requests, uint64_t seed, BenchSim *r) {
+    FTL *ftl = bench_ftl_open();
+    SimEngine *sim = malloc(sizeof(SimEngine));
+    BenchSimReq *q = malloc(BENCH_SIM_HOSTQ * sizeof(BenchSimReq));
+    uint32_t *lat[2] = { malloc((size_t)(requests ? requests : 1) * sizeof(uint32_t)),
+                         malloc((size_t)(requests ? requests : 1) * sizeof(uint32_t)) };
+    uint8_t buf[PAGE_SIZE];
+    int ret = -1;
+
+    memset(r, 0, sizeof(BenchSim));
+    if (ftl && sim && q && lat[0] && lat[1]) {
+        int saved = bench_quiet_begin();
+        ftl_mount(ftl);
+        memset(buf, 0, PAGE_SIZE);
+        for (uint32_t lba = 0; lba < TOTAL_LOGICAL_PAGES; lba++) {
+            ftl_write(ftl, lba, buf);
+        }
+
+        uint64_t start = ftl->nand.vtime_us, gc_before = ftl->total_gc_count;
+        uint32_t head = 0, count = 0, issued = 0, idle_epoch = 0;
+        bool busy = false;
+        double wall = bench_now();
+        SimEvent ev;
+
+        sim_init(sim, seed);
+        sim_schedule(sim, start, SIM_EV_HOST_ARRIVAL, 0);
+        r->hash = 0xCBF29CE484222325ull;
+        while (sim_next(sim, &ev)) {
+            uint64_t now = sim->now_us;
+
+            if (ev.type == SIM_EV_HOST_ARRIVAL) {
+                BenchSimReq req = { now, 0, sim_rand(sim) % 100 < BENCH_SIM_READ_PCT };
+                uint32_t pick = sim_rand(sim);
+                req.lba = (req.read || sim_rand(sim) % 100 >= 80) ? pick % TOTAL_LOGICAL_PAGES
+                                                                   : pick % BENCH_HOT_LBAS;
+                if (count < BENCH_SIM_HOSTQ) {
+                    q[(head + count++) % BENCH_SIM_HOSTQ] = req;
+                } else {
+                    r->rejected++;
+                }
+                if (++issued < requests) {
+                    sim_schedule(sim, now + sim_rand(sim) % (2 * BENCH_SIM_MEAN_GAP_US + 1), SIM_EV_HOST_ARRIVAL, 0);
+                }
+            } else if (ev.type == SIM_EV_NAND_DONE) {
+                busy = false;
+                if (ev.arg != BENCH_SIM_BG_TAG) {
+                    BenchSimReq *done = &q[head];
+                    uint32_t us = (uint32_t)(now - done->arrival_us);
+                    if (done->read) {
+                        lat[0][r->reads++] = us;
+                    } else {
+                        lat[1][r->writes++] = us;
+                    }
+                    r->hash = bench_fnv(r->hash, &us, sizeof(us));
+                    head = (head + 1) % BENCH_SIM_HOSTQ;
+                    count--;
+                    // 요청이 끊기면 일정 시간 뒤 유휴 GC
+                    sim_schedule(sim, now + BENCH_SIM_IDLE_US, SIM_EV_BACKGROUND, ++idle_epoch);
+                }
+            } else if (ev.type == SIM_EV_BACKGROUND) {
+                uint32_t high = ftl->data_blocks * PAGES_PER_BLOCK * ftl->gc_high_watermark / 100;
+                if (!busy && count == 0 && ev.arg == idle_epoch && ftl_free_data_pages(ftl) < high) {
+                    nand_set_time(&ftl->nand, now);
+                    ftl_trigger_gc(ftl);
+                    r->idle_gc++;
+                    busy = true;
+                    sim_schedule(sim, ftl->nand.vtime_us, SIM_EV_NAND_DONE, BENCH_SIM_BG_TAG);
+                }
+            }
+
+            // device가 비면 다음 요청 시작
+            if (!busy && count > 0) {
+                BenchSimReq *req = &q[head];
+                nand_set_time(&ftl->nand, now);
+                if (req->read) {
+                    ftl_read(ftl, req->lba, buf);
+                } else {
+                    uint32_t stamp = issued;
+                    memcpy(buf, &stamp, sizeof(stamp));
+                    ftl_write(ftl, req->lba, buf);
+                }
+                busy = true;
+                sim_schedule(sim, ftl->nand.vtime_us, SIM_EV_NAND_DONE, 0);
+            }
+        }
+        r->wall_s = bench_now() - wall;
+        r->events = sim->events;
+        r->vtime_us = sim->now_us - start;
+        r->read_lat = bench_iface_result(&ftl->nand, 0, 0, lat[0], r->reads);
+        r->write_lat = bench_iface_result(&ftl->nand, 0, 0, lat[1], r->writes);
+        r->fg_gc = ftl->total_gc_count - gc_before - r->idle_gc;
+
+        for (uint32_t b = 0; b < TOTAL_BLOCKS; b++) {
+            for (uint32_t p = 0; p < PAGES_PER_BLOCK; p++) {
+                const Page *pg = &ftl->nand.blocks[b].pages[p];
+                uint32_t fields[5] = { pg->oob.state, pg->oob.lba, pg->oob.write_count, pg->oob.timestamp, pg->value };
+                r->hash = bench_fnv(r->hash, fields, sizeof(fields));
+            }
+        }
+        r->hash = bench_fnv(r->hash, &ftl->nand.vtime_us, sizeof(ftl->nand.vtime_us));
+        ret = 0;
+        ftl_unmount(ftl);
+        bench_quiet_end(saved);
+        nand_release(&ftl->nand);
+    }
+    free(ftl);
+    free(sim);
+    free(q);
+    free(lat[0]);
+    free(lat[1]);
+    return ret;
+}
+
+void bench_sim(uint32_t requests, uint64_t seed) {
+    BenchSim r[2];
+
+    // 같은 seed로 두 번 돌려 결과가 비트 단위로 같은지 확인
+    if (bench_sim_run(requests, seed, &r[0]) != 0 || bench_sim_run(requests, seed, &r[1]) != 0) {
+        printf("[Bench] Simulation failed\n");
+        return;
+    }
+
+    printf("\n========== Discrete-event simulation (%u requests, seed %lu) ==========\n", requests, seed);
+    printf("Events:              %lu (%u reads, %u writes, %u rejected by full host queue)\n",
+           r[0].events, r[0].reads, r[0].writes, r[0].rejected);
+    printf("Virtual time:        %.2f s in %.3f s wall (%.0fx faster than real time)\n",
+           r[0].vtime_us / 1e6, r[0].wall_s, r[0].wall_s > 0 ? r[0].vtime_us / 1e6 / r[0].wall_s : 0.0);
+    printf("Read latency:        avg %.2f ms, p99 %.2f ms, max %.2f ms\n", r[0].read_lat.avg_us / 1000.0,
+           r[0].read_lat.p99_us / 1000.0, r[0].read_lat.max_us / 1000.0);
+    printf("Write latency:       avg %.2f ms, p99 %.2f ms, max %.2f ms\n", r[0].write_lat.avg_us / 1000.0,
+           r[0].write_lat.p99_us / 1000.0, r[0].write_lat.max_us / 1000.0);
+    printf("GC:                  %lu idle-time, %lu in the write path\n", r[0].idle_gc, r[0].fg_gc);
+    printf("State hash:          0x%016lX / rerun 0x%016lX -> %s\n", r[0].hash, r[1].hash,
+           r[0].hash == r[1].hash ? "reproducible" : "MISMATCH");
+    printf("=======================================================================\n");
+}
+
+// ==================== GC AUTO-TUNING ====================
+
+#define BENCH_TUNE_PHASES       8
+#define BENCH_TUNE_HOT_LBAS     135         // hotspot (LBA의 15%)
+#define BENCH_TUNE_HOT_PCT      90
+
+typedef struct {
+    double waf;
+    double phase_waf[BENCH_TUNE_PHASES];
+    AutoTune tune;              // 자동 조정 실행의 결정 기록
+    char final[48];             // 끝났을 때의 정책 / watermark
+} BenchTune;
+
+// 짝수 phase는 쓰기 대부분이 hotspot으로 (hotspot 위치가 phase마다 번갈아 바뀜), 홀수 phase는 균등
+static uint32_t bench_tune_lba(uint32_t phase) {
+    if (phase % 2 == 1) {
+        return (uint32_t)rand() % TOTAL_LOGICAL_PAGES;
+    }
+    uint32_t base = (phase / 2) % 2 ? TOTAL_LOGICAL_PAGES / 2 : 0;
+    if (rand() % 100 < BENCH_TUNE_HOT_PCT) {
+        return base + (uint32_t)rand() % BENCH_TUNE_HOT_LBAS;
+    }
+    return (uint32_t)rand() % TOTAL_LOGICAL_PAGES;
+}
+
+// policy = NULL이면 기본 설정에서 자동 조정
+static int bench_tune_run(const char *policy, uint32_t low, uint32_t writes, BenchTune *r) {
+    FTL *ftl = bench_ftl_open();
+    uint8_t buf[PAGE_SIZE];
+    int ret = -1;
+
+    memset(r, 0, sizeof(BenchTune));
+    if (!ftl) {
+        return -1;
+    }
+    int saved = bench_quiet_begin();
+    ftl_mount(ftl);
+    memset(buf, 0, PAGE_SIZE);
+    for (uint32_t lba = 0; lba < TOTAL_LOGICAL_PAGES; lba++) {
+        ftl_write(ftl, lba, buf);
+    }
+    if (policy) {
+        ftl_set_gc_policy(ftl, policy, 0);
+        ftl_set_gc_watermarks(ftl, low, low + TUNE_WM_GAP);
+    } else {
+        tune_enable(ftl, true);
+    }
+
+    srand(BENCH_SEED);
+    uint64_t start = ftl->nand.total_page_writes;
+    for (uint32_t phase = 0; phase < BENCH_TUNE_PHASES; phase++) {
+        uint64_t before = ftl->nand.total_page_writes;
+        for (uint32_t i = 0; i < writes; i++) {
+            memcpy(buf, &i, sizeof(i));
+            if (ftl_write(ftl, bench_tune_lba(phase), buf) != 0) goto out;
+        }
+        r->phase_waf[phase] = (double)(ftl->nand.total_page_writes - before) / writes;
+    }
+    r->waf = (double)(ftl->nand.total_page_writes - start) / ((uint64_t)writes * BENCH_TUNE_PHASES);
+    r->tune = ftl->tune;
+    snprintf(r->final, sizeof(r->final), "%s %u-%u", ftl->gc_policy.policy->name,
+             ftl->gc_low_watermark, ftl->gc_high_watermark);
+    ret = 0;
+out:
+    ftl_unmount(ftl);
+    bench_quiet_end(saved);
+    nand_release(&ftl->nand);
+    free(ftl);
+    return ret;
+}
+
+void bench_tune(uint32_t writes) {
+    static const char *policies[] = { "greedy", "cost-benefit" };
+    static const uint32_t lows[] = { TUNE_WM_MIN, (TUNE_WM_MIN + TUNE_WM_MAX) / 2, TUNE_WM_MAX };
+    BenchTune st[6], at;
+    double best_phase[BENCH_TUNE_PHASES];
+    int best = 0, n = 0;
+
+    for (int p = 0; p < 2; p++) {
+        for (int l = 0; l < 3; l++, n++) {
+            if (bench_tune_run(policies[p], lows[l], writes, &st[n]) != 0) {
+                printf("[Bench] Static run %s %u%% failed\n", policies[p], lows[l]);
+                return;
+            }
+            if (st[n].waf < st[best].waf) best = n;
+        }
+    }
+    if (bench_tune_run(NULL, 0, writes, &at) != 0) {
+        printf("[Bench] Auto-tuned run failed\n");
+        return;
+    }
+
+    printf("\n========== GC Auto-Tuning: %d phases x %u writes (hotspot A / uniform / hotspot B / uniform) ==========\n",
+           BENCH_TUNE_PHASES, writes);
+    printf("%-22s %6s  %s\n", "Configuration", "WAF", "WAF per phase");
+    for (int i = 0; i < n; i++) {
+        char name[48];
+        snprintf(name, sizeof(name), "%s %u-%u", policies[i / 3], lows[i % 3], lows[i % 3] + TUNE_WM_GAP);
+        printf("%-22s %6.3f ", name, st[i].waf);
+        for (int ph = 0; ph < BENCH_TUNE_PHASES; ph++) {
+            printf(" %5.2f", st[i].phase_waf[ph]);
+            if (i == 0 || st[i].phase_waf[ph] < best_phase[ph]) best_phase[ph] = st[i].phase_waf[ph];
+        }
+        printf("%s\n", i == best ? "  <- best static" : "");
+    }
+    printf("%-22s %6s ", "best static per phase", "");
+    for (int ph = 0; ph < BENCH_TUNE_PHASES; ph++) {
+        printf(" %5.2f", best_phase[ph]);
+    }
+    printf("\n%-22s %6.3f ", "auto-tuned", at.waf);
+    for (int ph = 0; ph < BENCH_TUNE_PHASES; ph++) {
+        printf(" %5.2f", at.phase_waf[ph]);
+    }
+    // 뒤쪽 절반 phase: 초기 탐색이 끝난 뒤 얼마나 가까워졌는지
+    double at_late = 0.0, st_late = 0.0;
+    for (int ph = BENCH_TUNE_PHASES / 2; ph < BENCH_TUNE_PHASES; ph++) {
+        at_late += at.phase_waf[ph];
+        st_late += st[best].phase_waf[ph];
+    }
+    printf("\nAuto-tuned vs best static: %+.1f%% WAF overall, %+.1f%% over the last %d phases\n",
+           100.0 * (at.waf - st[best].waf) / st[best].waf, 100.0 * (at_late - st_late) / st_late,
+           BENCH_TUNE_PHASES / 2);
+    printf("Auto-tuned started at %s %d-%d and ended at %s\n", GC_POLICY_DEFAULT, GC_THRESHOLD,
+           GC_HIGH_WATERMARK, at.final);
+    printf("Decisions: %lu (%lu reverted) over %lu windows of %d writes\n", at.tune.decisions, at.tune.reverts,
+           at.tune.windows, TUNE_WINDOW_WRITES);
+    uint32_t first = at.tune.log_count > TUNE_LOG_MAX ? at.tune.log_count - TUNE_LOG_MAX : 0;
+    for (uint32_t i = first; i < at.tune.log_count; i++) {
+        const TuneLogEntry *e = &at.tune.log[i % TUNE_LOG_MAX];
+        printf("  [%5lu] %s\n", e->window, e->msg);
+    }
+    printf("===========================================================================================\n");
+}
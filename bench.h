@@ -0,0 +1,42 @@
+/*
+ * bench.h - Simulation Benchmarks
+ *
+ * 새 NAND 위의 별도 FTL 인스턴스에서 NAND 구성만 바꿔 같은 작업을 돌리고
+ * 시뮬레이션 자체의 비용(실제 시간, 메모리)을 비교한다.
+ * (testshell.c의 read/write가 unistd.h와 충돌하므로 별도 파일)
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+
+// 실행 동안 stdout을 버림 (FTL / GC 로그 억제). 반환값을 bench_quiet_end에 전달
+int bench_quiet_begin(void);
+void bench_quiet_end(int saved);
+
+// eager(memset) vs lazy erase: 블록당 erase 비용과 전체 시뮬레이션 처리량
+void bench_erase_modes(uint32_t writes);
+
+// 전체 payload vs metadata-only(호스트 page는 4바이트 값만): 처리량, payload 메모리, 결과 일치 여부
+void bench_payload_modes(uint32_t writes);
+
+// 같은 쓰기 순서를 일반 FTL과 ZNS + 호스트 배치(온도별 zone, 호스트 GC)로 돌려 WAF / 쓰기 지연 비교
+void bench_zns(uint32_t writes);
+
+// 순차 tenant + 무작위 noisy tenant를 공유 pool / 전용 pool / token bucket으로 돌려 tenant별 WAF, 간섭, 지연 비교
+void bench_namespaces(uint32_t writes);
+
+// GC가 잦은 쓰기 + 일정 간격 read를 FIFO / read priority / program-erase suspend로 돌려 read tail 지연 비교
+void bench_sched(uint32_t writes);
+
+// 이벤트 엔진으로 호스트 요청 도착 / device 완료 / 유휴 GC를 가상 시간에 돌리고, 같은 seed로 다시 돌려 결과 비교
+void bench_sim(uint32_t requests, uint64_t seed);
+
+// hotspot 위치와 skew가 phase마다 바뀌는 쓰기를 고정 설정(정책 x watermark)과 자동 조정으로 돌려 WAF 비교
+void bench_tune(uint32_t writes);
+
+// capacity_gb 크기의 payload 저장소에 pages개만 program했을 때 실제 메모리 사용량
+void bench_payload_store(uint32_t capacity_gb, uint32_t pages);
+
+#endif // BENCH_H
@@ -0,0 +1,144 @@
+/*
+ * compress.c - Built-in LZ Page Codec
+ */
+
+#include "compress.h"
+#include <string.h>
+
+static inline uint32_t lz_read32(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint32_t lz_hash(uint32_t seq) {
+    return (seq * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+// 255 단위 길이 확장 바이트
+static size_t lz_put_length(uint8_t *out, size_t op, size_t len) {
+    while (len >= 255) {
+        out[op++] = 255;
+        len -= 255;
+    }
+    out[op++] = (uint8_t)len;
+    return op;
+}
+
+// sequence 하나 기록 (match_len == 0이면 마지막 리터럴 sequence)
+static int lz_emit(uint8_t *out, size_t *op, size_t cap, const uint8_t *lit, size_t lit_len,
+                   size_t offset, size_t match_len) {
+    size_t need = 1 + lit_len + lit_len / 255 + 1;
+    if (match_len) need += 2 + (match_len - LZ_MIN_MATCH) / 255 + 1;
+    if (*op + need > cap) {
+        return -1;
+    }
+
+    size_t pos = *op;
+    uint8_t *token = &out[pos++];
+    *token = (uint8_t)((lit_len >= 15 ? 15 : lit_len) << 4);
+    if (lit_len >= 15) pos = lz_put_length(out, pos, lit_len - 15);
+    memcpy(out + pos, lit, lit_len);
+    pos += lit_len;
+
+    if (match_len) {
+        size_t m = match_len - LZ_MIN_MATCH;
+        out[pos++] = (uint8_t)(offset & 0xFF);
+        out[pos++] = (uint8_t)(offset >> 8);
+        *token |= (uint8_t)(m >= 15 ? 15 : m);
+        if (m >= 15) pos = lz_put_length(out, pos, m - 15);
+    }
+    *op = pos;
+    return 0;
+}
+
+int lz_compress(const uint8_t *in, size_t in_len, uint8_t *out, size_t out_cap) {
+    uint16_t table[1 << LZ_HASH_BITS];     // 위치 + 1 (0 = 없음)
+    size_t ip = 0, anchor = 0, op = 0;
+
+    if (in_len > 0xFFFF) {
+        return -1;
+    }
+    memset(table, 0, sizeof(table));
+
+    while (ip + LZ_MIN_MATCH <= in_len) {
+        uint32_t seq = lz_read32(in + ip);
+        uint32_t h = lz_hash(seq);
+        size_t cand = table[h];
+        table[h] = (uint16_t)(ip + 1);
+
+        if (cand == 0 || lz_read32(in + cand - 1) != seq) {
+            ip++;
+            continue;
+        }
+
+        // 매치 연장 (offset이 길이보다 짧은 반복 구간도 바이트 단위로 겹쳐 복사됨)
+        size_t ref = cand - 1;
+        size_t len = LZ_MIN_MATCH;
+        while (ip + len < in_len && in[ref + len] == in[ip + len]) {
+            len++;
+        }
+        if (lz_emit(out, &op, out_cap, in + anchor, ip - anchor, ip - ref, len) != 0) {
+            return -1;
+        }
+        ip += len;
+        anchor = ip;
+    }
+
+    if (lz_emit(out, &op, out_cap, in + anchor, in_len - anchor, 0, 0) != 0) {
+        return -1;
+    }
+    return (int)op;
+}
+
+// 길이 확장 바이트 읽기
+static int lz_get_length(const uint8_t *in, size_t in_len, size_t *ip, size_t *len) {
+    uint8_t b;
+    do {
+        if (*ip >= in_len) return -1;
+        b = in[(*ip)++];
+        *len += b;
+    } while (b == 255);
+    return 0;
+}
+
+int lz_decompress(const uint8_t *in, size_t in_len, uint8_t *out, size_t out_len) {
+    size_t ip = 0, op = 0;
+
+    while (ip < in_len) {
+        uint8_t token = in[ip++];
+        size_t lit = token >> 4;
+        if (lit == 15 && lz_get_length(in, in_len, &ip, &lit) != 0) {
+            return -1;
+        }
+        if (ip + lit > in_len || op + lit > out_len) {
+            return -1;
+        }
+        memcpy(out + op, in + ip, lit);
+        ip += lit;
+        op += lit;
+
+        // 마지막 sequence는 리터럴만
+        if (ip == in_len) {
+            break;
+        }
+
+        if (ip + 2 > in_len) {
+            return -1;
+        }
+        size_t offset = in[ip] | ((size_t)in[ip + 1] << 8);
+        ip += 2;
+        size_t match = token & 0x0F;
+        if (match == 15 && lz_get_length(in, in_len, &ip, &match) != 0) {
+            return -1;
+        }
+        match += LZ_MIN_MATCH;
+        if (offset == 0 || offset > op || op + match > out_len) {
+            return -1;
+        }
+        for (size_t i = 0; i < match; i++, op++) {
+            out[op] = out[op - offset];
+        }
+    }
+    return (int)op;
+}
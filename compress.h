@@ -0,0 +1,29 @@
+/*
+ * compress.h - Built-in LZ Page Codec
+ *
+ * LZ4 블록 포맷과 같은 계열의 바이트 단위 LZ77 코덱 (외부 의존성 없음).
+ * sequence = token(상위 4bit 리터럴 길이, 하위 4bit 매치 길이-4)
+ *            + 리터럴 + 2-byte offset (+ 길이 확장 바이트)
+ * 마지막 sequence는 리터럴만 가진다. 페이지 한 장(2KB) 단위로만 쓰므로
+ * offset은 16bit로 충분하다.
+ */
+
+#ifndef COMPRESS_H
+#define COMPRESS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ==================== CODEC CONFIGURATION ====================
+#define LZ_MIN_MATCH        4
+#define LZ_HASH_BITS        10
+
+// ==================== FUNCTION PROTOTYPES ====================
+
+// 압축 결과 크기, out_cap에 들어가지 않으면 -1
+int lz_compress(const uint8_t *in, size_t in_len, uint8_t *out, size_t out_cap);
+
+// 복원한 바이트 수, 입력이 깨졌거나 out_len을 넘으면 -1
+int lz_decompress(const uint8_t *in, size_t in_len, uint8_t *out, size_t out_len);
+
+#endif // COMPRESS_H
@@ -0,0 +1,194 @@
+/*
+ * crashtest.c - Crash Injection Test
+ *
+ * child 프로세스가 공유 메모리 위의 FTL로 쓰기를 하다가 NAND program 도중
+ * SIGKILL로 죽고 (nand.crash_at_write), parent가 남은 NAND 이미지만으로
+ * mount 해서 매핑/데이터/page 상태를 검증한다.
+ * (testshell.c의 read/write가 unistd.h와 충돌하므로 별도 파일)
+ */
+
+#define _GNU_SOURCE
+#include "crashtest.h"
+#include "ftl.h"
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+typedef struct {
+    FTL ftl;                                    // child가 구동 (공유 메모리라 crash 후에도 남음)
+    uint32_t issued[TOTAL_LOGICAL_PAGES];       // 마지막으로 요청한 버전
+    uint32_t acked[TOTAL_LOGICAL_PAGES];        // 쓰기 완료까지 확인된 버전
+} CrashArena;
+
+static void crash_fill(uint8_t *buf, uint32_t lba, uint32_t version) {
+    memset(buf, (uint8_t)(lba ^ version), PAGE_SIZE);
+    memcpy(buf, &lba, sizeof(lba));
+    memcpy(buf + sizeof(lba), &version, sizeof(version));
+}
+
+static void crash_child(CrashArena *a, int journal, unsigned int seed, uint32_t crash_after) {
+    FTL *ftl = &a->ftl;
+    uint8_t buf[PAGE_SIZE];
+    
+    bench_quiet_begin();
+    freopen("/dev/null", "w", stderr);
+    
+    // NAND는 parent가 fork 전에 shared payload로 초기화
+    ftl_mount(ftl);
+    if (journal) journal_enable(ftl);
+    
+    // 전체 LBA를 버전 1로 채우고 반영
+    for (uint32_t lba = 0; lba < TOTAL_LOGICAL_PAGES; lba++) {
+        a->issued[lba] = 1;
+        crash_fill(buf, lba, 1);
+        ftl_write(ftl, lba, buf);
+        a->acked[lba] = 1;
+    }
+    ftl_sync(ftl);
+    
+    // crash_after 번째 program 도중 SIGKILL
+    srand(seed);
+    ftl->nand.crash_at_write = ftl->nand.total_page_writes + crash_after;
+    for (;;) {
+        uint32_t lba = (rand() % 100 < 80) ? rand() % 176 : rand() % TOTAL_LOGICAL_PAGES;
+        uint32_t version = a->issued[lba] + 1;
+        a->issued[lba] = version;
+        crash_fill(buf, lba, version);
+        ftl_write(ftl, lba, buf);
+        a->acked[lba] = version;
+    }
+}
+
+// 복구된 FTL 검증: 모든 LBA가 읽히고, 내용이 요청했던 버전 중 하나이며 완료된 쓰기보다 오래되지 않았는지
+static int crash_verify(FTL *ftl, CrashArena *a, uint32_t *rolled_back) {
+    uint8_t buf[PAGE_SIZE];
+    int errors = 0;
+    uint32_t mapped = 0, valid = 0;
+    
+    *rolled_back = 0;
+    for (uint32_t lba = 0; lba < TOTAL_LOGICAL_PAGES; lba++) {
+        uint32_t l, v;
+        if (ftl_read(ftl, lba, buf) != 0) {
+            errors++;
+            continue;
+        }
+        mapped++;
+        memcpy(&l, buf, sizeof(l));
+        memcpy(&v, buf + sizeof(l), sizeof(v));
+        if (l != lba || v == 0 || v > a->issued[lba] || buf[PAGE_SIZE - 1] != (uint8_t)(l ^ v)) {
+            errors++;
+        } else if (v < a->acked[lba]) {
+            // 전체 스캔이든 journal replay + roll-forward든 완료된 쓰기를 잃으면 안 됨
+            (*rolled_back)++;
+            errors++;
+            a->acked[lba] = v;      // 이후 검증은 복구된 버전 기준
+        }
+    }
+    
+    // 중복 VALID 페이지 / invalid 카운터 불일치 확인
+    for (uint32_t b = 0; b < TOTAL_BLOCKS; b++) {
+        uint32_t invalid = 0;
+        for (uint32_t p = 0; p < PAGES_PER_BLOCK; p++) {
+            PageState state = nand_get_page_state(&ftl->nand, b * PAGES_PER_BLOCK + p);
+            if (state == PAGE_INVALID) invalid++;
+            uint32_t tag = ftl->nand.blocks[b].pages[p].oob.lba & LBA_TAG_MASK;
+            if (state == PAGE_VALID && b < ftl->data_blocks && tag != LBA_TAG_SUMMARY) valid++;
+        }
+        if (invalid != ftl->nand.blocks[b].invalid_page_count) errors++;
+    }
+    if (valid != mapped) errors++;
+    return errors;
+}
+
+void crash_test_run(int trials) {
+    CrashArena *a = mmap(NULL, sizeof(CrashArena), PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    FTL *rec = malloc(sizeof(FTL));
+    int failed = 0;
+    
+    if (a == MAP_FAILED || !rec) {
+        printf("[CrashTest] 메모리 할당 실패\n");
+        free(rec);
+        return;
+    }
+    
+    printf("[CrashTest] 쓰기 도중 전원 손실 후 복구 검증 (%d회 x journal off/on)\n", trials);
+    for (int t = 0; t < trials * 2; t++) {
+        int journal = t % 2;
+        unsigned int seed = 1000 + t / 2;
+        srand(seed);
+        uint32_t crash_after = 1 + rand() % 3000;
+        
+        memset(&a->ftl, 0, sizeof(FTL));
+        if (nand_init_shared(&a->ftl.nand) != 0) {
+            printf("  trial %d: NAND init failed\n", t / 2 + 1);
+            failed++;
+            continue;
+        }
+        
+        fflush(stdout);
+        pid_t pid = fork();
+        if (pid == 0) {
+            crash_child(a, journal, seed, crash_after);
+            _exit(0);
+        }
+        int status;
+        waitpid(pid, &status, 0);
+        if (!WIFSIGNALED(status) || WTERMSIG(status) != SIGKILL) {
+            printf("  trial %d: child did not crash\n", t / 2 + 1);
+            nand_release(&a->ftl.nand);
+            failed++;
+            continue;
+        }
+        
+        // 남은 NAND 이미지만으로 mount (payload 저장소는 child와 공유)
+        memset(rec, 0, sizeof(FTL));
+        memcpy(&rec->nand, &a->ftl.nand, sizeof(NANDFlash));
+        rec->nand.crash_at_write = 0;
+        
+        int saved = bench_quiet_begin();
+        int mounted = ftl_mount(rec);
+        bench_quiet_end(saved);
+        if (mounted != 0) {
+            printf("  trial %d (journal %s): crash at write %u, mount failed -> FAIL\n",
+                   t / 2 + 1, journal ? "on " : "off", crash_after);
+            failed++;
+            ftl_unmount(rec);
+            nand_release(&rec->nand);
+            continue;
+        }
+        
+        uint32_t rolled_back;
+        int errors = crash_verify(rec, a, &rolled_back);
+        
+        // 복구 후에도 정상 동작하는지 추가 쓰기 (GC 포함) 후 재검증
+        uint8_t buf[PAGE_SIZE];
+        saved = bench_quiet_begin();
+        for (int i = 0; i < 2000; i++) {
+            uint32_t lba = rand() % TOTAL_LOGICAL_PAGES;
+            a->issued[lba] = a->acked[lba] = a->issued[lba] + 1;
+            crash_fill(buf, lba, a->issued[lba]);
+            ftl_write(rec, lba, buf);
+        }
+        bench_quiet_end(saved);
+        uint32_t rolled_after;
+        errors += crash_verify(rec, a, &rolled_after);
+        errors += rolled_after;
+        
+        printf("  trial %d (journal %s): crash at write %u, rolled back %u -> %s\n",
+               t / 2 + 1, journal ? "on " : "off", crash_after, rolled_back,
+               errors ? "FAIL" : "PASS");
+        if (errors) failed++;
+        ftl_unmount(rec);
+        nand_release(&rec->nand);
+    }
+    
+    printf("[CrashTest] %s (%d/%d trials failed)\n", failed ? "FAIL" : "PASS", failed, trials * 2);
+    free(rec);
+    munmap(a, sizeof(CrashArena));
+}
@@ -0,0 +1,11 @@
+/*
+ * crashtest.h - Crash Injection Test (쓰기 도중 전원 손실 후 복구 검증)
+ */
+
+#ifndef CRASHTEST_H
+#define CRASHTEST_H
+
+// journal off/on 각각 trials회: 무작위 시점에 crash 후 mount 결과 검증
+void crash_test_run(int trials);
+
+#endif // CRASHTEST_H
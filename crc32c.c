@@ -0,0 +1,206 @@
+/*
+ * crc32c.c - CRC32C (Castagnoli) Checksum
+ */
+
+#include "crc32c.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#define CRC32C_HAVE_SSE42   1
+#endif
+
+#define CRC32C_POLY         0x82F63B78u     // reflected Castagnoli
+#define CRC32C_STRIPE       680             // 3-way 병렬 구간 길이 (2KB page = 3 x 680 + 8)
+
+static uint32_t sw_table[8][256];           // slicing-by-8
+static uint32_t shift_table[4][256];        // CRC32C_STRIPE 바이트만큼 0을 이어 붙인 효과
+static int use_hw = 0;
+static pthread_once_t crc32c_once = PTHREAD_ONCE_INIT;
+
+// ==================== SOFTWARE PATH ====================
+
+// 반전 없는 CRC 레지스터 기준 (crc32c()가 앞뒤 반전 처리)
+static uint32_t crc32c_sw_raw(uint32_t crc, const uint8_t *p, size_t len) {
+    while (len && ((uintptr_t)p & 7)) {
+        crc = sw_table[0][(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+        len--;
+    }
+    while (len >= 8) {
+        uint64_t v;
+        memcpy(&v, p, sizeof(v));
+        v ^= crc;
+        crc = sw_table[7][v & 0xFF] ^ sw_table[6][(v >> 8) & 0xFF] ^
+              sw_table[5][(v >> 16) & 0xFF] ^ sw_table[4][(v >> 24) & 0xFF] ^
+              sw_table[3][(v >> 32) & 0xFF] ^ sw_table[2][(v >> 40) & 0xFF] ^
+              sw_table[1][(v >> 48) & 0xFF] ^ sw_table[0][v >> 56];
+        p += 8;
+        len -= 8;
+    }
+    while (len--) {
+        crc = sw_table[0][(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+static uint32_t crc32c_shift(uint32_t crc) {
+    return shift_table[0][crc & 0xFF] ^ shift_table[1][(crc >> 8) & 0xFF] ^
+           shift_table[2][(crc >> 16) & 0xFF] ^ shift_table[3][crc >> 24];
+}
+
+static void crc32c_init(void) {
+    for (uint32_t n = 0; n < 256; n++) {
+        uint32_t c = n;
+        for (int k = 0; k < 8; k++) {
+            c = (c & 1) ? (c >> 1) ^ CRC32C_POLY : c >> 1;
+        }
+        sw_table[0][n] = c;
+    }
+    for (uint32_t n = 0; n < 256; n++) {
+        for (int k = 1; k < 8; k++) {
+            sw_table[k][n] = (sw_table[k - 1][n] >> 8) ^ sw_table[0][sw_table[k - 1][n] & 0xFF];
+        }
+    }
+
+    // CRC는 선형이므로 bit별 shift 결과를 XOR해서 임의 값의 shift를 구함
+    static const uint8_t zeros[CRC32C_STRIPE];
+    uint32_t bit_shift[32];
+    for (int i = 0; i < 32; i++) {
+        bit_shift[i] = crc32c_sw_raw(1u << i, zeros, CRC32C_STRIPE);
+    }
+    for (int k = 0; k < 4; k++) {
+        for (uint32_t b = 0; b < 256; b++) {
+            uint32_t v = 0;
+            for (int j = 0; j < 8; j++) {
+                if (b & (1u << j)) v ^= bit_shift[8 * k + j];
+            }
+            shift_table[k][b] = v;
+        }
+    }
+
+#ifdef CRC32C_HAVE_SSE42
+    __builtin_cpu_init();
+    use_hw = __builtin_cpu_supports("sse4.2");
+#endif
+}
+
+// ==================== HARDWARE PATH ====================
+
+#ifdef CRC32C_HAVE_SSE42
+// crc32 명령어는 latency 3 / throughput 1이므로 독립 구간 3개를 번갈아 처리한 뒤 합침
+__attribute__((target("sse4.2")))
+static uint32_t crc32c_hw_raw(uint32_t crc, const uint8_t *p, size_t len) {
+    while (len >= 3 * CRC32C_STRIPE) {
+        uint64_t c0 = crc, c1 = 0, c2 = 0;
+        const uint8_t *p1 = p + CRC32C_STRIPE, *p2 = p + 2 * CRC32C_STRIPE;
+
+        for (size_t i = 0; i < CRC32C_STRIPE; i += 8) {
+            uint64_t v0, v1, v2;
+            memcpy(&v0, p + i, 8);
+            memcpy(&v1, p1 + i, 8);
+            memcpy(&v2, p2 + i, 8);
+            c0 = _mm_crc32_u64(c0, v0);
+            c1 = _mm_crc32_u64(c1, v1);
+            c2 = _mm_crc32_u64(c2, v2);
+        }
+        // crc(A||B) = shift(crc(A)) ^ crc0(B)
+        crc = crc32c_shift(crc32c_shift((uint32_t)c0) ^ (uint32_t)c1) ^ (uint32_t)c2;
+        p += 3 * CRC32C_STRIPE;
+        len -= 3 * CRC32C_STRIPE;
+    }
+    while (len >= 8) {
+        uint64_t v;
+        memcpy(&v, p, 8);
+        crc = (uint32_t)_mm_crc32_u64(crc, v);
+        p += 8;
+        len -= 8;
+    }
+    while (len--) {
+        crc = _mm_crc32_u8(crc, *p++);
+    }
+    return crc;
+}
+#endif
+
+// ==================== PUBLIC API ====================
+
+uint32_t crc32c(uint32_t crc, const void *buf, size_t len) {
+    pthread_once(&crc32c_once, crc32c_init);
+#ifdef CRC32C_HAVE_SSE42
+    if (use_hw) {
+        return ~crc32c_hw_raw(~crc, buf, len);
+    }
+#endif
+    return ~crc32c_sw_raw(~crc, buf, len);
+}
+
+uint32_t crc32c_sw(uint32_t crc, const void *buf, size_t len) {
+    pthread_once(&crc32c_once, crc32c_init);
+    return ~crc32c_sw_raw(~crc, buf, len);
+}
+
+const char *crc32c_engine(void) {
+    pthread_once(&crc32c_once, crc32c_init);
+    return use_hw ? "sse4.2" : "slice-by-8";
+}
+
+// ==================== BENCHMARK ====================
+
+static uint64_t crc32c_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+void crc32c_benchmark(size_t page_size) {
+    const uint32_t iters = 20000;
+    uint8_t *src = malloc(page_size), *dst = malloc(page_size);
+    volatile uint32_t sink = 0;
+
+    if (!src || !dst) {
+        free(src);
+        free(dst);
+        return;
+    }
+    for (size_t i = 0; i < page_size; i++) src[i] = (uint8_t)(i * 131 + 7);
+
+    uint64_t t0 = crc32c_now_ns();
+    for (uint32_t i = 0; i < iters; i++) {
+        src[0] = (uint8_t)i;
+        memcpy(dst, src, page_size);
+        sink ^= dst[i % page_size];
+    }
+    uint64_t copy_ns = crc32c_now_ns() - t0;
+
+    t0 = crc32c_now_ns();
+    for (uint32_t i = 0; i < iters; i++) {
+        src[0] = (uint8_t)i;
+        sink ^= crc32c(0, src, page_size);
+    }
+    uint64_t fast_ns = crc32c_now_ns() - t0;
+
+    t0 = crc32c_now_ns();
+    for (uint32_t i = 0; i < iters; i++) {
+        src[0] = (uint8_t)i;
+        sink ^= crc32c_sw(0, src, page_size);
+    }
+    uint64_t sw_ns = crc32c_now_ns() - t0;
+
+    // 표준 검증 벡터
+    uint32_t check = crc32c(0, "123456789", 9);
+
+    printf("\n========== CRC32C Benchmark (%zu-byte page) ==========\n", page_size);
+    printf("%-12s %10s %10s\n", "Path", "ns/page", "GB/s");
+    printf("%-12s %10.1f %10.2f\n", "memcpy", (double)copy_ns / iters, (double)page_size * iters / copy_ns);
+    printf("%-12s %10.1f %10.2f\n", crc32c_engine(), (double)fast_ns / iters, (double)page_size * iters / fast_ns);
+    printf("%-12s %10.1f %10.2f\n", "slice-by-8", (double)sw_ns / iters, (double)page_size * iters / sw_ns);
+    printf("Check value: 0x%08X (%s)\n", check, check == 0xE3069283 ? "ok" : "MISMATCH");
+    printf("======================================================\n");
+
+    free(src);
+    free(dst);
+}
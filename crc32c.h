@@ -0,0 +1,23 @@
+/*
+ * crc32c.h - CRC32C (Castagnoli) Checksum
+ *
+ * SSE4.2 crc32 명령어가 있으면 하드웨어 경로(8바이트 단위 + 3-way 병렬),
+ * 없으면 slicing-by-8 테이블 경로. 첫 호출 시 CPU를 확인해서 고른다.
+ */
+
+#ifndef CRC32C_H
+#define CRC32C_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// crc = 이전 결과 (처음에는 0)
+uint32_t crc32c(uint32_t crc, const void *buf, size_t len);
+uint32_t crc32c_sw(uint32_t crc, const void *buf, size_t len);
+
+const char *crc32c_engine(void);     // "sse4.2" | "slice-by-8"
+
+// 페이지 크기 버퍼에 대해 hw / sw / memcpy 처리량 비교
+void crc32c_benchmark(size_t page_size);
+
+#endif // CRC32C_H
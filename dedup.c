@@ -0,0 +1,386 @@
+/*
+ * dedup.c - Content-Hash Deduplication Layer
+ */
+
+#include "dedup.h"
+#include "ftl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ==================== FINGERPRINT ====================
+
+// 32-bit lane 4개짜리 벡터 2개 (GCC vector extension -> SSE2/AVX2/NEON 명령으로 내려감)
+typedef uint32_t fp_vec __attribute__((vector_size(16)));
+
+#define FP_PRIME1   0x9E3779B1u
+#define FP_PRIME2   0x85EBCA77u
+#define FP_PRIME3   0xC2B2AE3Du
+#define FP_PRIME4   0x27D4EB2Fu
+
+static inline uint64_t fp_rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+// 8개 lane이 독립적으로 32바이트씩 섞고 마지막에 64-bit로 접는다 (xxHash 계열 round)
+uint64_t dedup_fingerprint(const uint8_t *data) {
+    fp_vec a = { FP_PRIME1, FP_PRIME2, FP_PRIME3, FP_PRIME4 };
+    fp_vec b = { FP_PRIME4, FP_PRIME3, FP_PRIME2, FP_PRIME1 };
+    
+    for (size_t i = 0; i < PAGE_SIZE; i += 2 * sizeof(fp_vec)) {
+        fp_vec x, y;
+        memcpy(&x, data + i, sizeof(fp_vec));
+        memcpy(&y, data + i + sizeof(fp_vec), sizeof(fp_vec));
+        
+        a += x * FP_PRIME2;
+        b += y * FP_PRIME2;
+        a = (a << 13) | (a >> 19);
+        b = (b << 13) | (b >> 19);
+        a *= FP_PRIME1;
+        b *= FP_PRIME1;
+    }
+    
+    uint64_t h = PAGE_SIZE;
+    for (int i = 0; i < 4; i++) {
+        uint64_t lane = ((uint64_t)a[i] << 32) | b[i];
+        h ^= fp_rotl64(lane * 0xC2B2AE3D27D4EB4FULL, 31) * 0x9E3779B185EBCA87ULL;
+        h = fp_rotl64(h, 27) * 0x9E3779B185EBCA87ULL + 0x85EBCA77C2B2AE63ULL;
+    }
+    
+    // avalanche
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// ==================== INDEX ====================
+
+static uint32_t dedup_bucket(const Dedup *d, uint64_t fp) {
+    return (uint32_t)(fp & (d->bucket_count - 1));
+}
+
+static void dedup_index_insert(Dedup *d, uint32_t slot, uint64_t fp) {
+    uint32_t b = dedup_bucket(d, fp);
+    
+    d->slots[slot].fp = fp;
+    d->slots[slot].next = d->buckets[b];
+    d->buckets[b] = (int32_t)slot;
+}
+
+static void dedup_index_remove(Dedup *d, uint32_t slot) {
+    int32_t *link = &d->buckets[dedup_bucket(d, d->slots[slot].fp)];
+    
+    while (*link != -1) {
+        if ((uint32_t)*link == slot) {
+            *link = d->slots[slot].next;
+            d->slots[slot].next = -1;
+            return;
+        }
+        link = &d->slots[*link].next;
+    }
+}
+
+// fingerprint가 같은 slot 중 내용까지 같은 것 (없으면 -1). 확인 읽기는 호스트 읽기 통계에 넣지 않음
+static int32_t dedup_index_find(Dedup *d, FTL *ftl, uint64_t fp, const uint8_t *data) {
+    uint8_t stored[PAGE_SIZE];
+    
+    for (int32_t s = d->buckets[dedup_bucket(d, fp)]; s != -1; s = d->slots[s].next) {
+        if (d->slots[s].fp != fp) continue;
+        
+        d->verify_reads++;
+        if (ftl_read_internal(ftl, (uint32_t)s, stored) == 0 && memcmp(stored, data, PAGE_SIZE) == 0) {
+            return s;
+        }
+        d->fp_collisions++;
+    }
+    return -1;
+}
+
+// 참조 하나 해제, 마지막 참조면 FTL에서 페이지 해제
+static void dedup_release(Dedup *d, FTL *ftl, uint32_t slot) {
+    if (--d->slots[slot].refcount > 0) {
+        return;
+    }
+    dedup_index_remove(d, slot);
+    ftl_trim(ftl, slot);
+    d->free_slots[d->free_count++] = slot;
+}
+
+// ==================== SETUP ====================
+
+static void dedup_free_arrays(Dedup *d) {
+    free(d->host_map);
+    free(d->slots);
+    free(d->buckets);
+    free(d->free_slots);
+    memset(d, 0, sizeof(Dedup));
+}
+
+void dedup_free(Dedup *d) {
+    dedup_free_arrays(d);
+}
+
+static int dedup_alloc_arrays(Dedup *d) {
+    memset(d, 0, sizeof(Dedup));
+    
+    d->bucket_count = 1;
+    while (d->bucket_count < 2 * TOTAL_LOGICAL_PAGES) {
+        d->bucket_count <<= 1;
+    }
+    d->host_map = malloc(TOTAL_LOGICAL_PAGES * sizeof(uint32_t));
+    d->slots = calloc(TOTAL_LOGICAL_PAGES, sizeof(DedupSlot));
+    d->buckets = malloc(d->bucket_count * sizeof(int32_t));
+    d->free_slots = malloc(TOTAL_LOGICAL_PAGES * sizeof(uint32_t));
+    
+    if (!d->host_map || !d->slots || !d->buckets || !d->free_slots) {
+        dedup_free_arrays(d);
+        return -1;
+    }
+    memset(d->host_map, 0xFF, TOTAL_LOGICAL_PAGES * sizeof(uint32_t));
+    memset(d->buckets, 0xFF, d->bucket_count * sizeof(int32_t));
+    return 0;
+}
+
+int dedup_enable(Dedup *d, FTL *ftl) {
+    uint8_t buffer[PAGE_SIZE];
+    
+    if (d->enabled) {
+        return 0;
+    }
+    if (dedup_alloc_arrays(d) != 0) {
+        return -1;
+    }
+    
+    // 기존 데이터는 호스트 LBA = slot으로 가져오고, 이미 같은 내용이 있으면 바로 합침
+    for (uint32_t lba = 0; lba < TOTAL_LOGICAL_PAGES; lba++) {
+        d->slots[lba].next = -1;
+        if (ftl_l2p_lookup(ftl, lba) == 0xFFFFFFFF || ftl_read_internal(ftl, lba, buffer) != 0) {
+            continue;
+        }
+        
+        uint64_t fp = dedup_fingerprint(buffer);
+        int32_t slot = dedup_index_find(d, ftl, fp, buffer);
+        if (slot >= 0) {
+            d->slots[slot].refcount++;
+            d->host_map[lba] = (uint32_t)slot;
+            ftl_trim(ftl, lba);
+            continue;
+        }
+        d->slots[lba].refcount = 1;
+        d->host_map[lba] = lba;
+        dedup_index_insert(d, lba, fp);
+    }
+    for (uint32_t s = TOTAL_LOGICAL_PAGES; s-- > 0; ) {
+        if (d->slots[s].refcount == 0) {
+            d->free_slots[d->free_count++] = s;
+        }
+    }
+    
+    d->enabled = true;
+    return 0;
+}
+
+int dedup_disable(Dedup *d, FTL *ftl) {
+    if (!d->enabled) {
+        return 0;
+    }
+    
+    uint8_t *pages = malloc((size_t)TOTAL_LOGICAL_PAGES * PAGE_SIZE);
+    if (!pages) {
+        return -1;
+    }
+    
+    // 호스트 내용을 모두 읽은 뒤 slot을 비우고 호스트 LBA 위치에 다시 기록
+    for (uint32_t lba = 0; lba < TOTAL_LOGICAL_PAGES; lba++) {
+        uint32_t slot = d->host_map[lba];
+        if (slot != 0xFFFFFFFF && ftl_read_internal(ftl, slot, pages + (size_t)lba * PAGE_SIZE) != 0) {
+            d->host_map[lba] = 0xFFFFFFFF;
+        }
+    }
+    for (uint32_t s = 0; s < TOTAL_LOGICAL_PAGES; s++) {
+        if (d->slots[s].refcount > 0) {
+            ftl_trim(ftl, s);
+        }
+    }
+    for (uint32_t lba = 0; lba < TOTAL_LOGICAL_PAGES; lba++) {
+        if (d->host_map[lba] != 0xFFFFFFFF) {
+            ftl_write(ftl, lba, pages + (size_t)lba * PAGE_SIZE);
+        }
+    }
+    
+    free(pages);
+    dedup_free_arrays(d);
+    return 0;
+}
+
+// ==================== I/O ====================
+
+int dedup_write(Dedup *d, FTL *ftl, uint32_t lba, const uint8_t *data) {
+    if (lba >= TOTAL_LOGICAL_PAGES) {
+        fprintf(stderr, "[DEDUP] LBA %u out of range\n", lba);
+        return -1;
+    }
+    
+    d->host_writes++;
+    uint64_t fp = dedup_fingerprint(data);
+    uint32_t old = d->host_map[lba];
+    int32_t found = dedup_index_find(d, ftl, fp, data);
+    
+    // 같은 내용이 이미 있으면 참조만 추가 (NAND 쓰기 없음)
+    if (found >= 0) {
+        d->dedup_hits++;
+        if ((uint32_t)found == old) {
+            return 0;
+        }
+        d->slots[found].refcount++;
+        d->host_map[lba] = (uint32_t)found;
+        if (old != 0xFFFFFFFF) {
+            dedup_release(d, ftl, old);
+        }
+        return 0;
+    }
+    
+    // 기존 slot을 이 LBA만 쓰고 있으면 그 자리에 덮어씀
+    if (old != 0xFFFFFFFF && d->slots[old].refcount == 1) {
+        dedup_index_remove(d, old);
+        if (ftl_write(ftl, old, data) != 0) {
+            // 기존 내용이 그대로 남으므로 fingerprint도 다시 등록
+            dedup_index_insert(d, old, d->slots[old].fp);
+            return -1;
+        }
+        dedup_index_insert(d, old, fp);
+        return 0;
+    }
+    
+    if (d->free_count == 0) {
+        fprintf(stderr, "[DEDUP] No free slot for LBA %u\n", lba);
+        return -1;
+    }
+    uint32_t slot = d->free_slots[--d->free_count];
+    if (ftl_write(ftl, slot, data) != 0) {
+        d->free_slots[d->free_count++] = slot;
+        return -1;
+    }
+    d->slots[slot].refcount = 1;
+    dedup_index_insert(d, slot, fp);
+    d->host_map[lba] = slot;
+    if (old != 0xFFFFFFFF) {
+        dedup_release(d, ftl, old);
+    }
+    return 0;
+}
+
+int dedup_read(Dedup *d, FTL *ftl, uint32_t lba, uint8_t *data) {
+    if (lba >= TOTAL_LOGICAL_PAGES) {
+        fprintf(stderr, "[DEDUP] LBA %u out of range\n", lba);
+        return -1;
+    }
+    if (d->host_map[lba] == 0xFFFFFFFF) {
+        fprintf(stderr, "[DEDUP] LBA %u not mapped (no data written)\n", lba);
+        return -1;
+    }
+    return ftl_read(ftl, d->host_map[lba], data);
+}
+
+// ==================== PERSISTENCE ====================
+
+int dedup_save(const Dedup *d, FTL *ftl, const char *filename) {
+    FILE *fp = fopen(filename, "wb");
+    if (!fp) {
+        fprintf(stderr, "[DEDUP] Failed to save to %s\n", filename);
+        return -1;
+    }
+    
+    // 바로 다음 NAND 이미지 저장이 기록할 generation
+    DedupFileHeader header = { DEDUP_MAGIC, TOTAL_LOGICAL_PAGES, ftl->nand.image_generation + 1,
+                               ftl->nand.total_page_writes };
+    fwrite(&header, sizeof(header), 1, fp);
+    fwrite(d->host_map, sizeof(uint32_t), TOTAL_LOGICAL_PAGES, fp);
+    fclose(fp);
+    return 0;
+}
+
+int dedup_load(Dedup *d, FTL *ftl, const char *filename) {
+    uint8_t buffer[PAGE_SIZE];
+    DedupFileHeader header;
+    FILE *fp = fopen(filename, "rb");
+    
+    if (!fp) {
+        return -1;
+    }
+    if (dedup_alloc_arrays(d) != 0) {
+        fclose(fp);
+        return -1;
+    }
+    
+    size_t ok = fread(&header, sizeof(header), 1, fp);
+    ok = ok && header.magic == DEDUP_MAGIC && header.logical_pages == TOTAL_LOGICAL_PAGES &&
+         header.image_generation == ftl->nand.image_generation &&
+         header.nand_writes == ftl->nand.total_page_writes &&
+         fread(d->host_map, sizeof(uint32_t), TOTAL_LOGICAL_PAGES, fp) == TOTAL_LOGICAL_PAGES;
+    fclose(fp);
+    
+    // refcount는 호스트 매핑에서, fingerprint는 slot 내용에서 재구성
+    for (uint32_t lba = 0; ok && lba < TOTAL_LOGICAL_PAGES; lba++) {
+        uint32_t slot = d->host_map[lba];
+        if (slot == 0xFFFFFFFF) continue;
+        if (slot >= TOTAL_LOGICAL_PAGES) ok = 0;
+        else d->slots[slot].refcount++;
+    }
+    for (uint32_t s = TOTAL_LOGICAL_PAGES; ok && s-- > 0; ) {
+        d->slots[s].next = -1;
+        if (d->slots[s].refcount == 0) {
+            if (ftl_l2p_lookup(ftl, s) != 0xFFFFFFFF) ftl_trim(ftl, s);
+            d->free_slots[d->free_count++] = s;
+            continue;
+        }
+        if (ftl_read_internal(ftl, s, buffer) != 0) {
+            ok = 0;
+            break;
+        }
+        dedup_index_insert(d, s, dedup_fingerprint(buffer));
+    }
+    
+    if (!ok) {
+        fprintf(stderr, "[DEDUP] Ignoring stale dedup map %s\n", filename);
+        dedup_free_arrays(d);
+        return -1;
+    }
+    d->enabled = true;
+    return 0;
+}
+
+// ==================== STATISTICS ====================
+
+size_t dedup_memory_bytes(const Dedup *d) {
+    if (!d->enabled) {
+        return 0;
+    }
+    return (size_t)TOTAL_LOGICAL_PAGES * (2 * sizeof(uint32_t) + sizeof(DedupSlot)) +
+           (size_t)d->bucket_count * sizeof(int32_t);
+}
+
+void dedup_print_statistics(const Dedup *d, FTL *ftl) {
+    uint32_t mapped = 0, unique = 0;
+    
+    for (uint32_t i = 0; i < TOTAL_LOGICAL_PAGES; i++) {
+        if (d->host_map[i] != 0xFFFFFFFF) mapped++;
+        if (d->slots[i].refcount > 0) unique++;
+    }
+    uint64_t nand_writes = ftl->nand.total_page_writes - ftl->mount_nand_writes;
+    
+    printf("---------- Deduplication ----------\n");
+    printf("Host Writes:         %lu (dedup hits: %lu, %.1f%%)\n", d->host_writes, d->dedup_hits,
+           d->host_writes ? 100.0 * d->dedup_hits / d->host_writes : 0.0);
+    printf("Mapped LBAs:         %u -> Unique Pages: %u (dedup ratio %.2f:1)\n",
+           mapped, unique, unique ? (double)mapped / unique : 1.0);
+    printf("Capacity Saved:      %u pages (%u KB)\n",
+           mapped - unique, (mapped - unique) * (PAGE_SIZE / 1024));
+    printf("Verify Reads:        %lu (fingerprint collisions: %lu)\n", d->verify_reads, d->fp_collisions);
+    printf("Effective WAF:       %.2fx (NAND writes since mount / dedup host writes)\n",
+           d->host_writes ? (double)nand_writes / d->host_writes : 1.0);
+    printf("Dedup Memory:        %zu bytes\n", dedup_memory_bytes(d));
+}
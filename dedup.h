@@ -0,0 +1,83 @@
+/*
+ * dedup.h - Content-Hash Deduplication Layer
+ *
+ * ssd.c와 FTL 사이의 선택적 계층. 호스트 LBA를 내용이 같은 페이지끼리
+ * 하나의 내부 slot(= FTL LBA)으로 모은다.
+ * - fingerprint: 페이지 전체에 대한 64-bit 해시 (SIMD lane 병렬)
+ * - index: fingerprint -> slot 해시 체인 (일치하면 실제 내용까지 비교)
+ * - refcount: slot마다 참조하는 호스트 LBA 수. 0이 되면 FTL에서 trim
+ *
+ * slot의 물리 위치(PBA)는 FTL 매핑이 관리하므로 GC가 페이지를 옮겨도
+ * index는 그대로이고, 참조가 남아 있는 페이지는 invalid가 되지 않는다.
+ * 호스트 매핑은 종료 시 이미지 옆의 파일(DEDUP_MAP_FILE)에 저장한다.
+ */
+
+#ifndef DEDUP_H
+#define DEDUP_H
+
+#include "nand_flash.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ==================== DEDUP CONFIGURATION ====================
+#define DEDUP_MAP_SUFFIX    ".dedup"    // 호스트 매핑 파일 = 이미지 경로 + suffix
+#define DEDUP_MAGIC         0x44445550  // "DDUP"
+
+// ==================== DATA STRUCTURES ====================
+
+// 호스트 매핑 파일 헤더: 같이 저장한 NAND 이미지의 generation / program 수가 다르면 (저장 도중 crash,
+// 다른 이미지의 파일) slot 번호가 다른 내용을 가리킬 수 있으므로 로드하지 않음
+typedef struct {
+    uint32_t magic;
+    uint32_t logical_pages;
+    uint64_t image_generation;
+    uint64_t nand_writes;
+} DedupFileHeader;
+
+typedef struct {
+    uint64_t fp;            // 내용 fingerprint
+    uint32_t refcount;      // 이 slot을 가리키는 호스트 LBA 수 (0 = 빈 slot)
+    int32_t  next;          // 해시 체인 (-1 = 끝)
+} DedupSlot;
+
+typedef struct {
+    bool enabled;
+    uint32_t *host_map;         // 호스트 LBA -> slot (0xFFFFFFFF = 없음)
+    DedupSlot *slots;           // slot = FTL LBA
+    int32_t  *buckets;          // fingerprint 해시 -> slot
+    uint32_t bucket_count;
+    uint32_t *free_slots;       // 빈 slot 스택
+    uint32_t free_count;
+    
+    // 통계
+    uint64_t host_writes;
+    uint64_t dedup_hits;        // NAND 쓰기 없이 기존 slot 참조
+    uint64_t fp_collisions;     // fingerprint는 같지만 내용이 다른 경우
+    uint64_t verify_reads;      // 일치 확인용 페이지 읽기
+} Dedup;
+
+struct FTL;
+
+// ==================== FUNCTION PROTOTYPES ====================
+
+// 현재 FTL 내용을 identity 매핑으로 가져옴 (데이터 이동 없음)
+int dedup_enable(Dedup *d, struct FTL *ftl);
+// 호스트 LBA = FTL LBA 배치로 되돌림
+int dedup_disable(Dedup *d, struct FTL *ftl);
+void dedup_free(Dedup *d);          // 데이터는 그대로 두고 메모리만 해제 (instance 종료)
+
+int dedup_write(Dedup *d, struct FTL *ftl, uint32_t lba, const uint8_t *data);
+int dedup_read(Dedup *d, struct FTL *ftl, uint32_t lba, uint8_t *data);
+
+uint64_t dedup_fingerprint(const uint8_t *data);
+
+// 호스트 매핑 저장/로드 (로드 성공 시 index 재구성 후 enabled).
+// 저장은 ftl_sync 뒤, NAND 이미지 저장 직전에 해야 헤더가 그 이미지와 맞음
+int dedup_save(const Dedup *d, struct FTL *ftl, const char *filename);
+int dedup_load(Dedup *d, struct FTL *ftl, const char *filename);
+
+size_t dedup_memory_bytes(const Dedup *d);
+void dedup_print_statistics(const Dedup *d, struct FTL *ftl);
+
+#endif // DEDUP_H
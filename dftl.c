@@ -0,0 +1,378 @@
+/*
+ * dftl.c - Demand-based FTL (DFTL) Cached Mapping Table
+ */
+
+#include "dftl.h"
+#include "ftl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ==================== INITIALIZATION ====================
+
+static int dftl_alloc_cmt(DFTL *d, uint32_t cmt_entries) {
+    if (cmt_entries == 0) {
+        cmt_entries = 1;
+    }
+
+    d->capacity = cmt_entries;
+    d->bucket_count = cmt_entries * 2;
+    d->cmt = calloc(d->capacity, sizeof(CMTEntry));
+    d->buckets = malloc(d->bucket_count * sizeof(int32_t));
+    if (!d->cmt || !d->buckets) {
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < d->bucket_count; i++) {
+        d->buckets[i] = -1;
+    }
+    d->used = 0;
+    d->clock_hand = 0;
+    d->spare = -1;
+    return 0;
+}
+
+static void dftl_free_cmt(DFTL *d) {
+    free(d->cmt);
+    free(d->buckets);
+    d->cmt = NULL;
+    d->buckets = NULL;
+    d->capacity = 0;
+    d->used = 0;
+    d->spare = -1;
+}
+
+int dftl_init(DFTL *d, uint32_t cmt_entries) {
+    memset(d, 0, sizeof(DFTL));
+
+    d->tpage_count = (TOTAL_LOGICAL_PAGES + DFTL_ENTRIES_PER_TPAGE - 1) / DFTL_ENTRIES_PER_TPAGE;
+    d->gtd = malloc(d->tpage_count * sizeof(uint32_t));
+    if (!d->gtd || dftl_alloc_cmt(d, cmt_entries) != 0) {
+        fprintf(stderr, "[DFTL] Out of memory\n");
+        dftl_cleanup(d);
+        return -1;
+    }
+
+    for (uint32_t t = 0; t < d->tpage_count; t++) {
+        d->gtd[t] = 0xFFFFFFFF;
+    }
+    return 0;
+}
+
+void dftl_cleanup(DFTL *d) {
+    dftl_free_cmt(d);
+    free(d->gtd);
+    d->gtd = NULL;
+    d->tpage_count = 0;
+}
+
+// ==================== TRANSLATION PAGES ====================
+
+int dftl_read_tpage(FTL *ftl, uint32_t tvpn, uint32_t *entries) {
+    DFTL *d = &ftl->dftl;
+
+    if (d->gtd[tvpn] == 0xFFFFFFFF) {
+        // 아직 기록된 적 없는 translation page = 전부 unmapped
+        memset(entries, 0xFF, DFTL_ENTRIES_PER_TPAGE * sizeof(uint32_t));
+        return 0;
+    }
+
+    uint8_t buffer[PAGE_SIZE];
+    if (nand_read_page(&ftl->nand, d->gtd[tvpn], buffer) != 0) {
+        fprintf(stderr, "[DFTL] Failed to read translation page %u\n", tvpn);
+        return -1;
+    }
+
+    memcpy(entries, buffer, DFTL_ENTRIES_PER_TPAGE * sizeof(uint32_t));
+    d->tpage_reads++;
+    return 0;
+}
+
+int dftl_write_tpage(FTL *ftl, uint32_t tvpn, const uint32_t *entries) {
+    DFTL *d = &ftl->dftl;
+    uint32_t tag = LBA_TAG_TPAGE | tvpn;
+
+    uint32_t new_pba = ftl_find_free_page(ftl, tag);
+    if (new_pba == 0xFFFFFFFF) {
+        fprintf(stderr, "[DFTL] CRITICAL: No free page for translation page %u\n", tvpn);
+        return -1;
+    }
+
+    uint8_t buffer[PAGE_SIZE];
+    memset(buffer, 0xFF, PAGE_SIZE);
+    memcpy(buffer, entries, DFTL_ENTRIES_PER_TPAGE * sizeof(uint32_t));
+
+    if (ftl_program_page(ftl, new_pba, buffer, tag) != 0) {
+        return -1;
+    }
+
+    // 이전 버전의 translation page는 invalid
+    if (d->gtd[tvpn] != 0xFFFFFFFF) {
+        nand_set_page_state(&ftl->nand, d->gtd[tvpn], PAGE_INVALID);
+    }
+    d->gtd[tvpn] = new_pba;
+    d->tpage_writes++;
+    metrics_inc(&ftl->metrics, MET_TRANS_PAGE_WRITES, 1);
+    return 0;
+}
+
+// 같은 translation page에 속한 dirty 엔트리를 모아서 한 번에 기록
+static int dftl_writeback(FTL *ftl, uint32_t tvpn) {
+    DFTL *d = &ftl->dftl;
+    uint32_t entries[DFTL_ENTRIES_PER_TPAGE];
+
+    if (dftl_read_tpage(ftl, tvpn, entries) != 0) {
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < d->used; i++) {
+        CMTEntry *e = &d->cmt[i];
+        if (e->in_use && e->dirty && e->lba / DFTL_ENTRIES_PER_TPAGE == tvpn) {
+            entries[e->lba % DFTL_ENTRIES_PER_TPAGE] = e->pba;
+        }
+    }
+
+    if (dftl_write_tpage(ftl, tvpn, entries) != 0) {
+        return -1;
+    }
+
+    // 기록 성공 후에만 clean 처리
+    for (uint32_t i = 0; i < d->used; i++) {
+        CMTEntry *e = &d->cmt[i];
+        if (e->in_use && e->dirty && e->lba / DFTL_ENTRIES_PER_TPAGE == tvpn) {
+            e->dirty = 0;
+            d->batched_entries++;
+        }
+    }
+    return 0;
+}
+
+// ==================== CACHED MAPPING TABLE ====================
+
+static int32_t dftl_find(DFTL *d, uint32_t lba) {
+    int32_t idx = d->buckets[lba % d->bucket_count];
+
+    while (idx >= 0) {
+        if (d->cmt[idx].lba == lba) {
+            return idx;
+        }
+        idx = d->cmt[idx].next;
+    }
+    return -1;
+}
+
+static void dftl_unlink(DFTL *d, int32_t idx) {
+    int32_t *link = &d->buckets[d->cmt[idx].lba % d->bucket_count];
+
+    while (*link >= 0) {
+        if (*link == idx) {
+            *link = d->cmt[idx].next;
+            return;
+        }
+        link = &d->cmt[*link].next;
+    }
+}
+
+// CLOCK로 victim 선택, dirty면 write-back 후 슬롯 반환
+static int32_t dftl_evict(FTL *ftl) {
+    DFTL *d = &ftl->dftl;
+
+    for (;;) {
+        CMTEntry *e = &d->cmt[d->clock_hand];
+        int32_t idx = (int32_t)d->clock_hand;
+        d->clock_hand = (d->clock_hand + 1) % d->capacity;
+
+        if (e->referenced) {
+            e->referenced = 0;
+            continue;
+        }
+
+        if (e->dirty) {
+            if (dftl_writeback(ftl, e->lba / DFTL_ENTRIES_PER_TPAGE) != 0) {
+                return -1;
+            }
+            d->dirty_evictions++;
+        }
+
+        dftl_unlink(d, idx);
+        e->in_use = 0;
+        d->evictions++;
+        return idx;
+    }
+}
+
+static int32_t dftl_insert(FTL *ftl, uint32_t lba, uint32_t pba, bool dirty) {
+    DFTL *d = &ftl->dftl;
+    int32_t idx;
+
+    if (d->spare >= 0) {
+        idx = d->spare;
+        d->spare = -1;
+    } else if (d->used < d->capacity) {
+        idx = (int32_t)d->used++;
+    } else {
+        idx = dftl_evict(ftl);
+        if (idx < 0) {
+            return -1;
+        }
+    }
+
+    CMTEntry *e = &d->cmt[idx];
+    uint32_t bucket = lba % d->bucket_count;
+
+    e->lba = lba;
+    e->pba = pba;
+    e->dirty = dirty;
+    e->referenced = 1;
+    e->in_use = 1;
+    e->next = d->buckets[bucket];
+    d->buckets[bucket] = idx;
+    return idx;
+}
+
+uint32_t dftl_lookup(FTL *ftl, uint32_t lba) {
+    DFTL *d = &ftl->dftl;
+    int32_t idx = dftl_find(d, lba);
+
+    if (idx >= 0) {
+        d->hits++;
+        metrics_inc(&ftl->metrics, MET_MAP_CACHE_HITS, 1);
+        d->cmt[idx].referenced = 1;
+        return d->cmt[idx].pba;
+    }
+
+    d->misses++;
+    metrics_inc(&ftl->metrics, MET_MAP_CACHE_MISSES, 1);
+
+    uint32_t entries[DFTL_ENTRIES_PER_TPAGE];
+    if (dftl_read_tpage(ftl, lba / DFTL_ENTRIES_PER_TPAGE, entries) != 0) {
+        return 0xFFFFFFFF;
+    }
+
+    uint32_t pba = entries[lba % DFTL_ENTRIES_PER_TPAGE];
+    dftl_insert(ftl, lba, pba, false);
+    return pba;
+}
+
+int dftl_update(FTL *ftl, uint32_t lba, uint32_t pba) {
+    DFTL *d = &ftl->dftl;
+    int32_t idx = dftl_find(d, lba);
+
+    if (idx >= 0) {
+        d->cmt[idx].pba = pba;
+        d->cmt[idx].dirty = 1;
+        d->cmt[idx].referenced = 1;
+        return 0;
+    }
+
+    // 갱신은 translation page를 미리 읽을 필요 없음 (write-back 시 병합)
+    if (dftl_insert(ftl, lba, pba, true) < 0) {
+        fprintf(stderr, "[DFTL] CRITICAL: Mapping update for LBA %u failed (no space for write-back)\n", lba);
+        return -1;
+    }
+    return 0;
+}
+
+int dftl_reserve(FTL *ftl, uint32_t lba) {
+    DFTL *d = &ftl->dftl;
+
+    if (d->spare >= 0 || d->used < d->capacity || dftl_find(d, lba) >= 0) {
+        return 0;
+    }
+    d->spare = dftl_evict(ftl);
+    return d->spare >= 0 ? 0 : -1;
+}
+
+uint32_t dftl_peek(FTL *ftl, uint32_t lba) {
+    DFTL *d = &ftl->dftl;
+    int32_t idx = dftl_find(d, lba);
+
+    if (idx >= 0) {
+        return d->cmt[idx].pba;
+    }
+
+    uint32_t tvpn = lba / DFTL_ENTRIES_PER_TPAGE;
+    if (d->gtd[tvpn] == 0xFFFFFFFF) {
+        return 0xFFFFFFFF;
+    }
+
+    uint8_t buffer[PAGE_SIZE];
+    if (nand_read_page(&ftl->nand, d->gtd[tvpn], buffer) != 0) {
+        return 0xFFFFFFFF;
+    }
+
+    uint32_t pba;
+    memcpy(&pba, buffer + (lba % DFTL_ENTRIES_PER_TPAGE) * sizeof(uint32_t), sizeof(uint32_t));
+    return pba;
+}
+
+void dftl_flush(FTL *ftl) {
+    DFTL *d = &ftl->dftl;
+
+    for (uint32_t i = 0; i < d->used; i++) {
+        if (d->cmt[i].in_use && d->cmt[i].dirty) {
+            dftl_writeback(ftl, d->cmt[i].lba / DFTL_ENTRIES_PER_TPAGE);
+        }
+    }
+}
+
+int dftl_resize_cmt(FTL *ftl, uint32_t cmt_entries) {
+    DFTL *d = &ftl->dftl;
+
+    dftl_flush(ftl);
+    dftl_free_cmt(d);
+    return dftl_alloc_cmt(d, cmt_entries);
+}
+
+// ==================== GARBAGE COLLECTION ====================
+
+int dftl_migrate_tpage(FTL *ftl, uint32_t old_pba, uint32_t tvpn) {
+    DFTL *d = &ftl->dftl;
+
+    if (tvpn >= d->tpage_count || d->gtd[tvpn] != old_pba) {
+        // GTD가 가리키지 않는 오래된 버전
+        nand_set_page_state(&ftl->nand, old_pba, PAGE_INVALID);
+        return 0;
+    }
+
+    uint32_t entries[DFTL_ENTRIES_PER_TPAGE];
+    if (dftl_read_tpage(ftl, tvpn, entries) != 0) {
+        return -1;
+    }
+
+    // dftl_write_tpage가 이전 위치를 invalid로 바꾸고 GTD를 갱신
+    if (dftl_write_tpage(ftl, tvpn, entries) != 0) {
+        return -1;
+    }
+
+    printf("[GC] Migrated translation page %u: PBA %u -> %u\n", tvpn, old_pba, d->gtd[tvpn]);
+    return 0;
+}
+
+// ==================== STATISTICS ====================
+
+size_t dftl_memory_bytes(const DFTL *d) {
+    return d->capacity * sizeof(CMTEntry)
+         + d->bucket_count * sizeof(int32_t)
+         + d->tpage_count * sizeof(uint32_t);
+}
+
+void dftl_print_statistics(const DFTL *d) {
+    uint64_t lookups = d->hits + d->misses;
+    uint32_t dirty = 0;
+
+    for (uint32_t i = 0; i < d->used; i++) {
+        if (d->cmt[i].in_use && d->cmt[i].dirty) dirty++;
+    }
+
+    printf("---------- DFTL (Cached Mapping) ----------\n");
+    printf("CMT Capacity:        %u entries (%u used, %u dirty)\n", d->capacity, d->used, dirty);
+    printf("Translation Pages:   %u (%u entries/page)\n",
+           d->tpage_count, (uint32_t)DFTL_ENTRIES_PER_TPAGE);
+    printf("CMT Hit Ratio:       %.2f%% (%lu hits / %lu lookups)\n",
+           lookups ? 100.0 * d->hits / lookups : 0.0, d->hits, lookups);
+    printf("TPage Reads/Writes:  %lu / %lu\n", d->tpage_reads, d->tpage_writes);
+    printf("Evictions:           %lu (dirty: %lu, avg batch: %.2f entries)\n",
+           d->evictions, d->dirty_evictions,
+           d->tpage_writes ? (double)d->batched_entries / d->tpage_writes : 0.0);
+}
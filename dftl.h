@@ -0,0 +1,87 @@
+/*
+ * dftl.h - Demand-based FTL (DFTL) Cached Mapping Table
+ *
+ * 전체 L2P를 DRAM에 두지 않고, 매핑을 NAND의 translation page에 저장한다.
+ * - GTD (Global Translation Directory): tvpn -> translation page PBA
+ * - CMT (Cached Mapping Table): 용량이 제한된 LBA -> PBA 캐시 (CLOCK 교체)
+ * - dirty 엔트리는 evict 시 같은 translation page 단위로 모아서 write-back
+ *
+ * translation page 쓰기는 일반 NAND 쓰기이므로 WAF에 그대로 반영된다.
+ */
+
+#ifndef DFTL_H
+#define DFTL_H
+
+#include "nand_flash.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ==================== DFTL CONFIGURATION ====================
+#define DFTL_ENTRIES_PER_TPAGE  (PAGE_SIZE / sizeof(uint32_t))  // translation page 당 매핑 수
+#define DFTL_CMT_ENTRIES        64      // 기본 CMT 용량 (엔트리 수)
+
+// ==================== DATA STRUCTURES ====================
+
+typedef struct {
+    uint32_t lba;
+    uint32_t pba;
+    int32_t  next;          // 해시 체인 (-1 = 끝)
+    uint8_t  dirty;         // translation page에 아직 반영되지 않음
+    uint8_t  referenced;    // CLOCK second-chance 비트
+    uint8_t  in_use;
+} CMTEntry;
+
+typedef struct {
+    uint32_t *gtd;              // tvpn -> translation page PBA (0xFFFFFFFF = 없음)
+    uint32_t tpage_count;
+
+    CMTEntry *cmt;
+    int32_t  *buckets;          // lba 해시 -> CMT 인덱스
+    uint32_t capacity;
+    uint32_t bucket_count;
+    uint32_t used;
+    uint32_t clock_hand;
+    int32_t  spare;             // dftl_reserve가 미리 비워 둔 슬롯 (-1 = 없음)
+
+    // 통계
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t tpage_reads;
+    uint64_t tpage_writes;
+    uint64_t evictions;
+    uint64_t dirty_evictions;
+    uint64_t batched_entries;   // write-back 한 번에 함께 반영된 dirty 엔트리 수
+} DFTL;
+
+struct FTL;
+
+// ==================== FUNCTION PROTOTYPES ====================
+
+int dftl_init(DFTL *d, uint32_t cmt_entries);
+void dftl_cleanup(DFTL *d);
+
+// 매핑 조회/갱신 (miss 시 translation page 로드, 필요하면 evict)
+uint32_t dftl_lookup(struct FTL *ftl, uint32_t lba);
+int dftl_update(struct FTL *ftl, uint32_t lba, uint32_t pba);     // 자리를 못 만들면 -1 (갱신 안 됨)
+// 호스트 data page를 쓰기 전에 lba의 CMT 자리를 확보 (dirty victim write-back 실패 시 -1)
+int dftl_reserve(struct FTL *ftl, uint32_t lba);
+
+// CMT를 거치지 않는 조회 (디버깅 출력용, 캐시 상태 불변)
+uint32_t dftl_peek(struct FTL *ftl, uint32_t lba);
+
+// translation page 단위 일괄 기록 (mount 시 재구성, 모드 전환용)
+int dftl_write_tpage(struct FTL *ftl, uint32_t tvpn, const uint32_t *entries);
+int dftl_read_tpage(struct FTL *ftl, uint32_t tvpn, uint32_t *entries);
+
+// 모든 dirty 엔트리를 translation page에 반영
+void dftl_flush(struct FTL *ftl);
+int dftl_resize_cmt(struct FTL *ftl, uint32_t cmt_entries);
+
+// GC: victim 블록에 있던 translation page 이동
+int dftl_migrate_tpage(struct FTL *ftl, uint32_t old_pba, uint32_t tvpn);
+
+size_t dftl_memory_bytes(const DFTL *d);
+void dftl_print_statistics(const DFTL *d);
+
+#endif // DFTL_H
@@ -0,0 +1,178 @@
+/*
+ * extent_map.c - Extent-based L2P Mapping
+ */
+
+#include "extent_map.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define EXTENT_MAP_INITIAL_CAPACITY     16
+
+// ==================== INITIALIZATION ====================
+
+int extent_map_init(ExtentMap *map) {
+    memset(map, 0, sizeof(ExtentMap));
+
+    map->extents = malloc(EXTENT_MAP_INITIAL_CAPACITY * sizeof(Extent));
+    if (!map->extents) {
+        return -1;
+    }
+    map->capacity = EXTENT_MAP_INITIAL_CAPACITY;
+    return 0;
+}
+
+void extent_map_cleanup(ExtentMap *map) {
+    free(map->extents);
+    map->extents = NULL;
+    map->count = 0;
+    map->capacity = 0;
+}
+
+// ==================== INTERNAL HELPERS ====================
+
+// lba보다 시작 LBA가 큰 첫 구간의 인덱스
+static uint32_t extent_upper_bound(const ExtentMap *map, uint32_t lba) {
+    uint32_t lo = 0, hi = map->count;
+
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (map->extents[mid].lba <= lba) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static int extent_insert_at(ExtentMap *map, uint32_t idx, Extent e) {
+    if (map->count == map->capacity) {
+        uint32_t new_cap = map->capacity * 2;
+        Extent *grown = realloc(map->extents, new_cap * sizeof(Extent));
+        if (!grown) {
+            fprintf(stderr, "[EXTENT] Out of memory\n");
+            return -1;
+        }
+        map->extents = grown;
+        map->capacity = new_cap;
+    }
+
+    memmove(&map->extents[idx + 1], &map->extents[idx], (map->count - idx) * sizeof(Extent));
+    map->extents[idx] = e;
+    map->count++;
+    return 0;
+}
+
+static void extent_remove_at(ExtentMap *map, uint32_t idx) {
+    memmove(&map->extents[idx], &map->extents[idx + 1], (map->count - idx - 1) * sizeof(Extent));
+    map->count--;
+}
+
+// ==================== LOOKUP & UPDATE ====================
+
+uint32_t extent_map_lookup(const ExtentMap *map, uint32_t lba) {
+    uint32_t idx = extent_upper_bound(map, lba);
+
+    if (idx == 0) {
+        return 0xFFFFFFFF;
+    }
+
+    const Extent *e = &map->extents[idx - 1];
+    if (lba < e->lba + e->len) {
+        return e->pba + (lba - e->lba);
+    }
+    return 0xFFFFFFFF;
+}
+
+int extent_map_update(ExtentMap *map, uint32_t lba, uint32_t pba) {
+    uint32_t idx = extent_upper_bound(map, lba);
+
+    // Step 1: lba를 포함하는 기존 구간에서 lba 제거 (필요하면 분할)
+    if (idx > 0) {
+        Extent *e = &map->extents[idx - 1];
+
+        if (lba < e->lba + e->len) {
+            if (e->len == 1) {
+                extent_remove_at(map, idx - 1);
+            } else if (lba == e->lba) {
+                e->lba++;
+                e->pba++;
+                e->len--;
+            } else if (lba == e->lba + e->len - 1) {
+                e->len--;
+            } else {
+                uint32_t head = lba - e->lba;
+                Extent tail = { lba + 1, e->pba + head + 1, e->len - head - 1 };
+                // tail을 먼저 넣어야 삽입이 실패해도 기존 구간이 그대로 남음 (삽입 중 realloc으로 e는 무효)
+                if (extent_insert_at(map, idx, tail) != 0) {
+                    return -1;
+                }
+                map->extents[idx - 1].len = head;
+                map->splits++;
+            }
+        }
+    }
+
+    if (pba == 0xFFFFFFFF) {
+        return 0;
+    }
+
+    // Step 2: 새 매핑 삽입, 앞뒤 구간과 이어지면 병합
+    idx = extent_upper_bound(map, lba);
+    uint32_t cur;
+
+    if (idx > 0 &&
+        map->extents[idx - 1].lba + map->extents[idx - 1].len == lba &&
+        map->extents[idx - 1].pba + map->extents[idx - 1].len == pba) {
+        cur = idx - 1;
+        map->extents[cur].len++;
+        map->merges++;
+    } else {
+        Extent e = { lba, pba, 1 };
+        if (extent_insert_at(map, idx, e) != 0) {
+            return -1;
+        }
+        cur = idx;
+    }
+
+    if (cur + 1 < map->count) {
+        Extent *c = &map->extents[cur];
+        Extent *n = &map->extents[cur + 1];
+        if (c->lba + c->len == n->lba && c->pba + c->len == n->pba) {
+            c->len += n->len;
+            extent_remove_at(map, cur + 1);
+            map->merges++;
+        }
+    }
+    return 0;
+}
+
+// ==================== STATISTICS ====================
+
+size_t extent_map_memory_bytes(const ExtentMap *map) {
+    return (size_t)map->capacity * sizeof(Extent);
+}
+
+void extent_map_print_statistics(const ExtentMap *map, uint32_t logical_pages) {
+    uint64_t mapped = 0;
+    uint32_t longest = 0;
+
+    for (uint32_t i = 0; i < map->count; i++) {
+        mapped += map->extents[i].len;
+        if (map->extents[i].len > longest) longest = map->extents[i].len;
+    }
+
+    size_t full_bytes = (size_t)logical_pages * sizeof(uint32_t);
+    size_t used_bytes = (size_t)map->count * sizeof(Extent);
+
+    printf("---------- Extent Mapping ----------\n");
+    printf("Extents:             %u (capacity %u, %lu LBAs mapped)\n",
+           map->count, map->capacity, mapped);
+    printf("Avg / Max Length:    %.2f / %u pages\n",
+           map->count ? (double)mapped / map->count : 0.0, longest);
+    printf("Memory:              %zu bytes used vs %zu bytes full table (saved %.1f%%)\n",
+           used_bytes, full_bytes,
+           full_bytes ? 100.0 * (1.0 - (double)used_bytes / full_bytes) : 0.0);
+    printf("Splits / Merges:     %lu / %lu\n", map->splits, map->merges);
+}
@@ -0,0 +1,46 @@
+/*
+ * extent_map.h - Extent-based L2P Mapping
+ *
+ * 연속된 LBA가 연속된 PBA에 매핑된 구간을 (lba, pba, len) 하나로 저장한다.
+ * 순차 쓰기 워크로드에서는 LBA 당 4바이트 대신 구간 당 12바이트만 사용.
+ *
+ * - LBA 순으로 정렬된 배열 + 이진 탐색 (조회 O(log n))
+ * - 갱신 시 기존 구간을 분할하고, 인접 구간과 이어지면 병합
+ */
+
+#ifndef EXTENT_MAP_H
+#define EXTENT_MAP_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ==================== DATA STRUCTURES ====================
+
+typedef struct {
+    uint32_t lba;           // 구간 시작 LBA
+    uint32_t pba;           // 구간 시작 PBA
+    uint32_t len;           // 구간 길이 (페이지 수)
+} Extent;
+
+typedef struct {
+    Extent *extents;        // lba 오름차순
+    uint32_t count;
+    uint32_t capacity;
+
+    // 통계
+    uint64_t splits;
+    uint64_t merges;
+} ExtentMap;
+
+// ==================== FUNCTION PROTOTYPES ====================
+
+int extent_map_init(ExtentMap *map);
+void extent_map_cleanup(ExtentMap *map);
+
+uint32_t extent_map_lookup(const ExtentMap *map, uint32_t lba);
+int extent_map_update(ExtentMap *map, uint32_t lba, uint32_t pba);  // pba=0xFFFFFFFF: unmap
+
+size_t extent_map_memory_bytes(const ExtentMap *map);
+void extent_map_print_statistics(const ExtentMap *map, uint32_t logical_pages);
+
+#endif // EXTENT_MAP_H
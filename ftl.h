@@ -9,51 +9,150 @@
 #define FTL_H
 
 #include "nand_flash.h"
+#include "metrics.h"
+#include "dftl.h"
+#include "extent_map.h"
+#include "journal.h"
+#include "summary.h"
+#include "scan.h"
+#include "pack.h"
+#include "slc.h"
+#include "zns.h"
+#include "ns.h"
+#include "sched.h"
+#include "gc_policy.h"
+#include "tune.h"
 #include <stdint.h>
 #include <stdbool.h>
 
 // ==================== FTL CONFIGURATION ====================
 #define TOTAL_LOGICAL_PAGES     900     
-#define GC_THRESHOLD            10      // Free pages가 10% 이하일 때 GC 발동
+#define GC_THRESHOLD            10      // Free pages가 10% 이하일 때 GC 발동 (low watermark 기본값)
+#define GC_HIGH_WATERMARK       15      // GC가 발동하면 free pages가 15%가 될 때까지 회수
+#define GC_BATCH_MAX            4       // victim 선택 한 번에 고르는 최대 블록 수
+#define GC_BATCH_RESERVE        (PAGES_PER_BLOCK / 4)   // batch 이동 중 남겨 둘 free page (tpage/summary용)
+#define METRICS_SAMPLE_INTERVAL 1000    // host write 1000회마다 시계열 샘플
+#define TPAGE_COUNT             ((TOTAL_LOGICAL_PAGES + DFTL_ENTRIES_PER_TPAGE - 1) / DFTL_ENTRIES_PER_TPAGE)
+
+// OOB lba 태그: 호스트 LBA가 아닌 FTL 메타데이터 페이지 구분 (하위 비트 = 인덱스)
+#define LBA_TAG_MASK            0xFF000000
+#define LBA_TAG_TPAGE           0x80000000      // DFTL translation page
+#define LBA_TAG_META            0x90000000      // journal / checkpoint page (하위 비트 = MetaPageType)
+#define LBA_TAG_SUMMARY         0xA0000000      // block summary page (하위 비트 = block 번호)
+#define LBA_TAG_PACK            0xB0000000      // 압축 페이지 여러 장을 담은 packed page (하위 비트 = slot 수)
+#define LBA_TAG_ZONE            0x40000000      // ZNS zone page (하위 비트 = zone LBA, 호스트 데이터라 최상위 비트 없음)
+
+#define FTL_IMAGE_FILE_DEFAULT  "nand_flash.bin"
+#define FTL_IMAGE_PATH_MAX      256
 
 // ==================== DATA STRUCTURES ====================
 
-typedef struct {
+// L2P 매핑 방식
+typedef enum {
+    MAP_MODE_PAGE = 0,      // 전체 L2P 테이블을 DRAM에 상주
+    MAP_MODE_DFTL = 1,      // translation page + 제한된 CMT
+    MAP_MODE_EXTENT = 2     // (lba, pba, len) 구간 배열
+} FTLMapMode;
+
+typedef struct FTL {
     NANDFlash nand;                     // 물리적 NAND Flash
-    uint32_t l2p_table[TOTAL_LOGICAL_PAGES];  // LBA -> PBA 매핑 테이블
+    char image_path[FTL_IMAGE_PATH_MAX];// 이미지 파일 ("" = 저장하지 않는 메모리 전용 instance)
+    FTLMapMode map_mode;
+    uint32_t *l2p_table;                // LBA -> PBA 매핑 테이블 (MAP_MODE_PAGE)
+    DFTL dftl;                          // MAP_MODE_DFTL
+    ExtentMap extents;                  // MAP_MODE_EXTENT
+    uint32_t gc_victim_block;           // GC 중인 블록 (할당 제외)
+    GcPolicyState gc_policy;            // victim 선택 정책 (registry에서 실행 중 교체)
+    AutoTune tune;                      // 관찰한 workload로 정책 / watermark 자동 조정
+    bool gc_batch[TOTAL_BLOCKS];        // 이번 batch에서 지울 블록 (할당 제외)
+    uint32_t gc_low_watermark;          // free page % (이하이면 GC 시작)
+    uint32_t gc_high_watermark;         // free page % (이상이 될 때까지 회수)
+    uint32_t data_blocks;               // 호스트 데이터/GC 대상 블록 수 (meta 영역 제외)
+    Journal journal;                    // 매핑 journal + checkpoint
+    bool summary_enabled;               // 블록 마지막 page에 summary 기록
+    uint32_t scan_threads;              // mount 스캔 worker 수 (0 = 코어 수)
+    Pack pack;                          // 인라인 압축 + packed page 매핑 보조 정보
+    SlcCache slc;                       // SLC 쓰기 캐시 (data_blocks 바로 뒤 블록들)
+    Zns zns;                            // ZNS 모드 (켜져 있으면 호스트가 zone을 직접 관리, FTL 우회)
+    NsTable ns;                         // namespace / 블록 pool / tenant별 통계
+    IoSched sched;                      // NAND 명령 순서 / 시간 모델 (read priority, suspend)
     uint32_t next_free_page;            // 다음 쓰기 위치 (순차 할당)
     
     // 통계
     uint64_t total_host_writes;         // 호스트가 요청한 쓰기 수
     uint64_t total_gc_count;            // GC 발동 횟수
+    uint64_t gc_blocks_reclaimed;       // GC로 지운 블록 수
+    uint64_t gc_pages_migrated;
+    uint64_t gc_select_passes;          // victim 선택 스캔 횟수
+    uint64_t gc_ns;                     // GC에 쓴 시간 합계
+    uint64_t gc_copybacks;              // copyback으로 옮긴 page
+    uint64_t gc_copies;                 // 컨트롤러 버퍼로 읽고 다시 쓴 page
+    uint64_t gc_copyback_ns;            // page 이동에 쓴 CPU 시간 (copyback / copy)
+    uint64_t gc_copy_ns;
+    uint64_t gc_model_us;               // GC 모델 시간 (이동 + erase)
+    uint64_t host_model_us;             // 호스트 데이터 program 모델 시간 (스테이징만 된 쓰기는 0)
+    uint64_t summary_pages;             // 기록한 summary page 수 (WAF에 포함)
     uint32_t next_free_hot;
     uint32_t next_free_cold;
 
+    // 메트릭 (mount 이후 증가분 기준)
+    Metrics metrics;
+    uint64_t mount_nand_writes;         // mount 시점의 NAND 누적 카운터
+    uint64_t mount_nand_reads;
+    uint64_t mount_block_erases;
+
 } FTL;
 
 // ==================== FUNCTION PROTOTYPES ====================
 
 // 초기화 및 종료
-void ftl_init(FTL *ftl);
-void ftl_cleanup(FTL *ftl);
+int ftl_init(FTL *ftl);                             // 기본 이미지 파일 (FTL_IMAGE_FILE_DEFAULT)
+int ftl_init_at(FTL *ftl, const char *image_path);  // instance별 이미지 (NULL / "" = 메모리 전용)
+void ftl_cleanup(FTL *ftl);                         // 이미지가 있으면 저장 후 해제
+int ftl_mount(FTL *ftl);                // ftl->nand 내용만으로 휘발성 상태 복구 (실패 -1)
+void ftl_sync(FTL *ftl);                // 버퍼된 매핑 갱신을 NAND에 반영
+void ftl_unmount(FTL *ftl);             // 휘발성 상태 해제 (저장 없음)
 
 // 기본 I/O (기존 ssd.c 인터페이스와 호환)
 int ftl_write(FTL *ftl, uint32_t lba, const uint8_t *data);
 int ftl_read(FTL *ftl, uint32_t lba, uint8_t *data);
+int ftl_trim(FTL *ftl, uint32_t lba);   // LBA 해제 (기존 페이지 invalid + 매핑 제거)
+// 호스트 읽기로 세지 않는 내부 읽기 (read 메트릭 / 스케줄러 제외, dedup 검증 등)
+int ftl_read_internal(FTL *ftl, uint32_t lba, uint8_t *data);
+
+// data 영역 page program (블록이 닫히면 summary 기록)
+int ftl_program_page(FTL *ftl, uint32_t pba, const uint8_t *data, uint32_t lba);
 
 // Garbage Collection
 void ftl_trigger_gc(FTL *ftl);
-uint32_t ftl_select_victim_block_greedy(FTL *ftl);
-uint32_t ftl_select_victim_block_cost(FTL *ftl);
+uint32_t ftl_select_victim_batch(FTL *ftl, uint32_t *victims, uint32_t max_victims, uint32_t need_pages);
+int ftl_set_gc_watermarks(FTL *ftl, uint32_t low, uint32_t high);
+int ftl_set_gc_policy(FTL *ftl, const char *name, uint32_t param);  // param = window / d (0 = 그대로)
 void ftl_gc_one_block(FTL *ftl, uint32_t victim_block_idx);
+uint32_t ftl_count_valid_pages(FTL *ftl, uint32_t block_idx);   // summary page 제외
+
+// L2P 매핑 (매핑 방식에 무관한 접근 경로)
+uint32_t ftl_l2p_lookup(FTL *ftl, uint32_t lba);
+int ftl_l2p_update(FTL *ftl, uint32_t lba, uint32_t pba);     // 매핑 구조에 자리가 없으면 -1
+int ftl_set_map_mode(FTL *ftl, FTLMapMode mode, uint32_t cmt_entries);
+size_t ftl_mapping_memory_bytes(FTL *ftl);
+const char *ftl_map_mode_name(FTLMapMode mode);
 
 // 내부 유틸리티
 uint32_t ftl_find_free_page(FTL *ftl,uint32_t lba);
+uint32_t ftl_alloc_host_page(FTL *ftl, uint32_t lba);  // 호스트 데이터 위치 (SLC 캐시 우선)
+uint32_t ftl_free_data_pages(FTL *ftl);
 void ftl_invalidate_old_page(FTL *ftl, uint32_t lba);
+void ftl_charge_program(FTL *ftl, uint32_t pba);   // 호스트 데이터 page program을 scheduler / 모델 시간에 반영
 double ftl_calculate_waf(FTL *ftl);
 
 // 통계 및 디버깅
 void ftl_print_statistics(FTL *ftl);
 void ftl_print_l2p_table(FTL *ftl);
+void ftl_recovery_benchmark(FTL *ftl);  // 전체 OOB 스캔 vs checkpoint+journal 복구 비교
+
+// 메트릭
+void ftl_metrics_refresh(FTL *ftl);     // counter/gauge를 현재 상태로 갱신
+void ftl_metrics_sample(FTL *ftl);      // 갱신 후 시계열에 한 행 기록
 
 #endif // FTL_H
@@ -0,0 +1,276 @@
+/*
+ * gc_policy.c - GC Victim Policies
+ */
+
+#include "gc_policy.h"
+#include "ftl.h"
+#include "sim.h"
+#include <stdio.h>
+#include <string.h>
+
+// ==================== INTERNAL HELPERS ====================
+
+// 지금 GC 중인 pool 밖의 블록은 후보가 아님 (나이 리스트에는 SLC / journal로 떼어 준 블록이 남을 수 있음)
+static bool gc_in_pool(FTL *ftl, uint32_t b) {
+    return b < ftl->data_blocks && ftl->ns.pool[b] == ftl->ns.gc_pool;
+}
+
+// 블록 카운터만 보는 정책의 후보 (invalid page가 있어야 회수할 것이 있음)
+static bool gc_greedy_candidate(FTL *ftl, uint32_t b, GcCandidate *c) {
+    uint32_t invalid = nand_get_invalid_page_count(&ftl->nand, b);
+
+    if (!gc_in_pool(ftl, b) || invalid == 0) {
+        return false;
+    }
+    c->block = b;
+    c->valid = ftl->nand.blocks[b].valid_page_count;
+    c->score = invalid;
+    return true;
+}
+
+// ==================== BLOCK AGE LIST ====================
+
+static void gc_age_unlink(GcPolicyState *st, uint32_t b) {
+    if (!st->age_linked[b]) return;
+
+    uint32_t prev = st->age_prev[b], next = st->age_next[b];
+    if (prev != 0xFFFFFFFF) st->age_next[prev] = next; else st->age_head = next;
+    if (next != 0xFFFFFFFF) st->age_prev[next] = prev; else st->age_tail = prev;
+    st->age_linked[b] = false;
+}
+
+static void gc_age_append(GcPolicyState *st, uint32_t b) {
+    gc_age_unlink(st, b);
+    st->age_prev[b] = st->age_tail;
+    st->age_next[b] = 0xFFFFFFFF;
+    if (st->age_tail != 0xFFFFFFFF) st->age_next[st->age_tail] = b; else st->age_head = b;
+    st->age_tail = b;
+    st->age_linked[b] = true;
+}
+
+// 열린 블록을 첫 page의 쓰기 순번 순으로 다시 연결
+static void gc_age_init(FTL *ftl) {
+    GcPolicyState *st = &ftl->gc_policy;
+    uint32_t order[TOTAL_BLOCKS];
+    uint32_t n = 0;
+
+    memset(st->age_linked, 0, sizeof(st->age_linked));
+    st->age_head = st->age_tail = 0xFFFFFFFF;
+    for (uint32_t b = 0; b < ftl->data_blocks; b++) {
+        if (nand_get_page_state(&ftl->nand, b * PAGES_PER_BLOCK) == PAGE_FREE) continue;
+
+        uint32_t seq = ftl->nand.blocks[b].pages[0].oob.write_count;
+        uint32_t i = n++;
+        while (i > 0 && ftl->nand.blocks[order[i - 1]].pages[0].oob.write_count > seq) {
+            order[i] = order[i - 1];
+            i--;
+        }
+        order[i] = b;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        gc_age_append(st, order[i]);
+    }
+}
+
+static void gc_age_update(FTL *ftl, uint32_t block, GcEvent ev) {
+    if (ev == GC_EV_OPEN) {
+        gc_age_append(&ftl->gc_policy, block);
+    } else {
+        gc_age_unlink(&ftl->gc_policy, block);
+    }
+}
+
+// ==================== POLICIES ====================
+
+static uint32_t gc_greedy_select(FTL *ftl, GcCandidate *cand) {
+    uint32_t n = 0;
+
+    for (uint32_t b = 0; b < ftl->data_blocks; b++) {
+        if (gc_greedy_candidate(ftl, b, &cand[n])) n++;
+    }
+    ftl->gc_policy.scored += ftl->data_blocks;
+    return n;
+}
+
+// Cost-Benefit 점수 (회수할 것이 없으면 음수). valid = 이동해야 할 page 수
+static double gc_cost_benefit_score(FTL *ftl, uint32_t b, uint32_t *valid) {
+    if (!gc_in_pool(ftl, b)) {
+        *valid = 0;
+        return -1.0;
+    }
+    uint32_t invalid_count = nand_get_invalid_page_count(&ftl->nand, b);
+
+    // packed page는 slot valid bitmap 비율만큼만 유효 (나머지는 회수 가능)
+    double valid_count = 0.0;
+    uint32_t valid_pages = 0;
+    uint32_t last_write_time = 0;
+
+    for (uint32_t p = 0; p < PAGES_PER_BLOCK; p++) {
+        uint32_t pba = b * PAGES_PER_BLOCK + p;
+        if (nand_get_page_state(&ftl->nand, pba) == PAGE_VALID) {
+            valid_pages++;
+            valid_count += pack_live_fraction(ftl, pba);
+            uint32_t ts = ftl->nand.blocks[b].pages[p].oob.write_count;
+            if (ts > last_write_time) last_write_time = ts;
+        }
+    }
+    *valid = valid_pages;
+
+    double dead = invalid_count + (valid_pages - valid_count);
+    if (dead <= 0.0) return -1.0;
+
+    // score = (회수 공간 / 이동 비용) * 블록 나이
+    double reclaim = dead / PAGES_PER_BLOCK;
+    double cost = 1.0 + valid_count / PAGES_PER_BLOCK;
+    double age = (double)(ftl->nand.total_page_writes - last_write_time + 1);
+    return (reclaim / cost) * age;
+}
+
+static uint32_t gc_cost_benefit_select(FTL *ftl, GcCandidate *cand) {
+    uint32_t n = 0;
+
+    for (uint32_t b = 0; b < ftl->data_blocks; b++) {
+        double score = gc_cost_benefit_score(ftl, b, &cand[n].valid);
+        if (score >= 0.0) {
+            cand[n].block = b;
+            cand[n].score = score;
+            n++;
+        }
+    }
+    ftl->gc_policy.scored += ftl->data_blocks;
+    return n;
+}
+
+// 오래된 쪽부터 window개 블록 중 greedy. 창 안에 회수할 블록이 없으면 후보가 나올 때까지 넓힘
+static uint32_t gc_windowed_select(FTL *ftl, GcCandidate *cand) {
+    GcPolicyState *st = &ftl->gc_policy;
+    uint32_t n = 0, seen = 0;
+
+    for (uint32_t b = st->age_head; b != 0xFFFFFFFF; b = st->age_next[b]) {
+        if (!gc_in_pool(ftl, b)) continue;
+        if (seen >= st->window && n > 0) break;
+        seen++;
+        if (gc_greedy_candidate(ftl, b, &cand[n])) n++;
+    }
+    st->scored += seen;
+    return n;
+}
+
+// 가장 먼저 열린 블록부터 batch 크기만큼 (점수 = 열린 순서)
+static uint32_t gc_fifo_select(FTL *ftl, GcCandidate *cand) {
+    GcPolicyState *st = &ftl->gc_policy;
+    uint32_t n = 0;
+
+    for (uint32_t b = st->age_head; b != 0xFFFFFFFF && n < GC_BATCH_MAX; b = st->age_next[b]) {
+        st->scored++;
+        if (gc_greedy_candidate(ftl, b, &cand[n])) {
+            cand[n].score = TOTAL_BLOCKS - n;
+            n++;
+        }
+    }
+    return n;
+}
+
+// 무작위 d개 블록(중복 제외) 중 greedy. 표본에 회수할 블록이 하나도 없으면 전체 스캔
+static uint32_t gc_dchoices_select(FTL *ftl, GcCandidate *cand) {
+    GcPolicyState *st = &ftl->gc_policy;
+    uint32_t n = 0;
+
+    if (++st->seen_stamp == 0) {
+        memset(st->seen, 0, sizeof(st->seen));
+        st->seen_stamp = 1;
+    }
+    for (uint32_t draw = 0; n < st->d && draw < st->d * GC_DCHOICES_DRAWS; draw++) {
+        uint32_t b = sim_rand_next(&st->rng) % ftl->data_blocks;
+        if (st->seen[b] == st->seen_stamp) continue;
+        st->seen[b] = st->seen_stamp;
+        st->scored++;
+        if (gc_greedy_candidate(ftl, b, &cand[n])) n++;
+    }
+    if (n == 0) {
+        st->fallbacks++;
+        return gc_greedy_select(ftl, cand);
+    }
+    return n;
+}
+
+// ==================== REGISTRY ====================
+
+static const GcPolicy gc_policies[] = {
+    { "greedy",          NULL,     NULL,        gc_greedy_select,       NULL },
+    { "cost-benefit",    NULL,     NULL,        gc_cost_benefit_select, NULL },
+    { "windowed-greedy", "window", gc_age_init, gc_windowed_select,     gc_age_update },
+    { "fifo",            NULL,     gc_age_init, gc_fifo_select,         gc_age_update },
+    { "d-choices",       "d",      NULL,        gc_dchoices_select,     NULL },
+};
+
+// 정책 인자가 들어가는 자리 (인자 없는 정책은 NULL)
+static uint32_t *gc_param_of(GcPolicyState *st, const GcPolicy *p) {
+    if (p->select == gc_windowed_select) return &st->window;
+    if (p->select == gc_dchoices_select) return &st->d;
+    return NULL;
+}
+
+uint32_t gc_policy_count(void) {
+    return sizeof(gc_policies) / sizeof(gc_policies[0]);
+}
+
+const GcPolicy *gc_policy_at(uint32_t idx) {
+    return idx < gc_policy_count() ? &gc_policies[idx] : NULL;
+}
+
+const GcPolicy *gc_policy_find(const char *name) {
+    for (uint32_t i = 0; i < gc_policy_count(); i++) {
+        if (strcmp(gc_policies[i].name, name) == 0) return &gc_policies[i];
+    }
+    return NULL;
+}
+
+void gc_policy_reset(FTL *ftl) {
+    GcPolicyState *st = &ftl->gc_policy;
+
+    memset(st, 0, sizeof(GcPolicyState));
+    st->window = GC_WINDOW_DEFAULT;
+    st->d = GC_DCHOICES_DEFAULT;
+    st->rng = GC_POLICY_SEED;
+    gc_policy_set(ftl, GC_POLICY_DEFAULT, 0);
+}
+
+int gc_policy_set(FTL *ftl, const char *name, uint32_t param) {
+    GcPolicyState *st = &ftl->gc_policy;
+    const GcPolicy *p = gc_policy_find(name);
+
+    if (!p) {
+        return -1;
+    }
+    if (param && gc_param_of(st, p)) {
+        *gc_param_of(st, p) = param < ftl->data_blocks ? param : ftl->data_blocks;
+    }
+    st->policy = p;
+    if (p->init) {
+        p->init(ftl);
+    }
+    return 0;
+}
+
+void gc_policy_update(FTL *ftl, uint32_t block, GcEvent ev) {
+    const GcPolicy *p = ftl->gc_policy.policy;
+
+    if (p && p->update && block < ftl->data_blocks) {
+        p->update(ftl, block, ev);
+    }
+}
+
+// ==================== STATISTICS ====================
+
+void gc_policy_print(FTL *ftl) {
+    GcPolicyState *st = &ftl->gc_policy;
+
+    printf("GC victim policies (current: %s):\n", st->policy->name);
+    for (uint32_t i = 0; i < gc_policy_count(); i++) {
+        const GcPolicy *p = &gc_policies[i];
+        char param[32] = "";
+        if (p->param) snprintf(param, sizeof(param), "%s=%u", p->param, *gc_param_of(st, p));
+        printf("  %c %-16s %s\n", p == st->policy ? '*' : ' ', p->name, param);
+    }
+}
@@ -0,0 +1,90 @@
+/*
+ * gc_policy.h - GC Victim Policies
+ *
+ * GC victim 선택을 정책 인터페이스(init / select / update)로 나누고, 이름으로 찾는
+ * registry에서 실행 중에 바꾼다.
+ * - select: 후보 블록에 점수를 매겨 돌려줌. batch 구성(점수 순, 이동량 예산)은 FTL 공통
+ * - update: 블록이 열리거나(첫 page program) GC로 지워질 때 (나이 순서가 필요한 정책만)
+ * - init: 정책을 고를 때 / mount 후 NAND 상태로 정책 상태를 다시 만듦
+ *
+ * 정책:
+ * - greedy:          invalid page가 가장 많은 블록 (블록 카운터만 봄, O(blocks))
+ * - cost-benefit:    (회수량 / 이동 비용) x 나이 (page 단위 스캔, O(blocks x pages))
+ * - windowed-greedy: 가장 먼저 열린 W개 블록 중 greedy
+ * - fifo:            가장 먼저 열린 블록부터 (log-structured)
+ * - d-choices:       무작위로 d개 블록을 뽑아 그중 greedy (O(d))
+ */
+
+#ifndef GC_POLICY_H
+#define GC_POLICY_H
+
+#include "nand_flash.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// ==================== POLICY CONFIGURATION ====================
+#define GC_POLICY_DEFAULT       "cost-benefit"
+#define GC_WINDOW_DEFAULT       8           // windowed-greedy 창 크기 (블록)
+#define GC_DCHOICES_DEFAULT     8           // d-choices 표본 수
+#define GC_DCHOICES_DRAWS       4           // 후보가 d개 모일 때까지 최대 d x 이 수만큼 뽑음
+#define GC_POLICY_SEED          42
+
+// ==================== DATA STRUCTURES ====================
+
+typedef enum {
+    GC_EV_OPEN = 0,             // 블록 첫 page program
+    GC_EV_ERASE                 // GC가 블록을 지움
+} GcEvent;
+
+typedef struct {
+    uint32_t block;
+    uint32_t valid;             // 옮겨야 할 page 수 (batch 이동량 예산)
+    double score;               // 클수록 먼저
+} GcCandidate;
+
+struct FTL;
+
+typedef struct {
+    const char *name;
+    const char *param;          // 인자 이름 (NULL = 인자 없음)
+    void (*init)(struct FTL *ftl);                                  // NULL 가능
+    uint32_t (*select)(struct FTL *ftl, GcCandidate *cand);         // 후보 수 (최대 TOTAL_BLOCKS)
+    void (*update)(struct FTL *ftl, uint32_t block, GcEvent ev);    // NULL 가능
+} GcPolicy;
+
+typedef struct {
+    const GcPolicy *policy;
+    uint32_t window;            // windowed-greedy
+    uint32_t d;                 // d-choices
+
+    // 블록이 열린 순서 (fifo / windowed-greedy): 오래된 것이 head인 이중 연결 리스트
+    uint32_t age_prev[TOTAL_BLOCKS];
+    uint32_t age_next[TOTAL_BLOCKS];
+    bool age_linked[TOTAL_BLOCKS];
+    uint32_t age_head;
+    uint32_t age_tail;
+
+    // d-choices 표본 (같은 선택에서 중복 제외)
+    uint64_t rng;
+    uint32_t seen[TOTAL_BLOCKS];
+    uint32_t seen_stamp;
+
+    // 통계
+    uint64_t select_ns;         // victim 선택에 쓴 CPU 시간
+    uint64_t scored;            // 점수를 매기려고 본 블록 수
+    uint64_t fallbacks;         // d-choices 표본에 후보가 없어 greedy 전체 스캔
+} GcPolicyState;
+
+// ==================== FUNCTION PROTOTYPES ====================
+
+uint32_t gc_policy_count(void);
+const GcPolicy *gc_policy_at(uint32_t idx);
+const GcPolicy *gc_policy_find(const char *name);
+
+void gc_policy_reset(struct FTL *ftl);                              // mount: 기본 정책 + 기본 인자
+int gc_policy_set(struct FTL *ftl, const char *name, uint32_t param);  // param 0 = 그대로, 없는 이름 -1
+void gc_policy_update(struct FTL *ftl, uint32_t block, GcEvent ev);
+
+void gc_policy_print(struct FTL *ftl);
+
+#endif // GC_POLICY_H
@@ -0,0 +1,450 @@
+/*
+ * journal.c - Mapping Journal & L2P Checkpoint
+ */
+
+#include "journal.h"
+#include "ftl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CKPT_PARTS  ((TOTAL_LOGICAL_PAGES + CKPT_ENTRIES_PER_PAGE - 1) / CKPT_ENTRIES_PER_PAGE)
+
+// ==================== INTERNAL HELPERS ====================
+
+static uint32_t journal_meta_pba(const Journal *j, uint32_t blk, uint32_t page) {
+    return (j->first_block + blk) * PAGES_PER_BLOCK + page;
+}
+
+static bool journal_block_is_erased(FTL *ftl, uint32_t block_idx) {
+    for (uint32_t p = 0; p < PAGES_PER_BLOCK; p++) {
+        if (nand_get_page_state(&ftl->nand, block_idx * PAGES_PER_BLOCK + p) != PAGE_FREE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void journal_erase_block(FTL *ftl, uint32_t block_idx) {
+    if (!journal_block_is_erased(ftl, block_idx)) {
+        nand_erase_block(&ftl->nand, block_idx);
+        ftl->journal.meta_erases++;
+    }
+}
+
+// 이 meta page 이후에 program이 들어올 수 있는 data 블록: free page가 남았거나 지금 GC가 비우는 중
+// (GC는 journal flush 후 victim을 erase하고 다시 쓰므로 지금은 가득 차 있어도 포함)
+static uint32_t journal_open_blocks(FTL *ftl) {
+    uint32_t mask = 0;
+
+    for (uint32_t b = 0; b < ftl->journal.first_block; b++) {
+        bool open = ftl->gc_batch[b] || b == ftl->gc_victim_block;
+        for (uint32_t p = 0; !open && p < PAGES_PER_BLOCK; p++) {
+            open = nand_get_page_state(&ftl->nand, b * PAGES_PER_BLOCK + p) == PAGE_FREE;
+        }
+        if (open) mask |= 1u << b;
+    }
+    return mask;
+}
+
+static int journal_write_meta(FTL *ftl, const MetaPageHeader *hdr, const void *payload, size_t len) {
+    Journal *j = &ftl->journal;
+    uint8_t buffer[PAGE_SIZE];
+    MetaPageHeader stamped = *hdr;
+
+    if (j->next_page >= PAGES_PER_BLOCK) {
+        fprintf(stderr, "[JOURNAL] Meta block %u is full\n", j->first_block + j->active);
+        return -1;
+    }
+
+    stamped.open_blocks = journal_open_blocks(ftl);
+    memset(buffer, 0xFF, PAGE_SIZE);
+    memcpy(buffer, &stamped, sizeof(MetaPageHeader));
+    memcpy(buffer + sizeof(MetaPageHeader), payload, len);
+
+    uint32_t pba = journal_meta_pba(j, j->active, j->next_page);
+    if (nand_write_page(&ftl->nand, pba, buffer, LBA_TAG_META | hdr->type) != 0) {
+        return -1;
+    }
+    j->next_page++;
+    return 0;
+}
+
+// 다음 meta 블록으로 이동 (이전 내용은 새 checkpoint로 대체되므로 erase)
+static void journal_switch_block(FTL *ftl) {
+    Journal *j = &ftl->journal;
+
+    j->active = (j->active + 1) % META_BLOCKS;
+    j->next_page = 0;
+    journal_erase_block(ftl, j->first_block + j->active);
+}
+
+// ==================== ENABLE / DISABLE ====================
+
+int journal_enable(FTL *ftl) {
+    Journal *j = &ftl->journal;
+
+    if (ftl->map_mode == MAP_MODE_DFTL) {
+        fprintf(stderr, "[JOURNAL] DFTL mode already persists mapping in translation pages\n");
+        return -1;
+    }
+    if (j->enabled) {
+        return 0;
+    }
+    if (ftl->slc.blocks) {
+        fprintf(stderr, "[JOURNAL] Turn the SLC cache off first (it sits at the end of the data area)\n");
+        return -1;
+    }
+
+    // 이후 할당/GC는 data 영역만 사용
+    j->first_block = TOTAL_BLOCKS - META_BLOCKS;
+    ftl->data_blocks = j->first_block;
+
+    // meta 블록에 남아 있던 데이터는 data 영역으로 이동
+    for (uint32_t b = j->first_block; b < TOTAL_BLOCKS; b++) {
+        ftl->gc_victim_block = b;
+        ftl_gc_one_block(ftl, b);
+        journal_erase_block(ftl, b);
+    }
+    ftl->gc_victim_block = 0xFFFFFFFF;
+
+    j->enabled = true;
+    j->active = 0;
+    j->next_page = 0;
+    j->buffered = 0;
+    j->pages_since_ckpt = 0;
+
+    printf("[JOURNAL] Enabled (meta blocks %u~%u)\n", j->first_block, TOTAL_BLOCKS - 1);
+    return journal_checkpoint(ftl);
+}
+
+int journal_disable(FTL *ftl) {
+    Journal *j = &ftl->journal;
+
+    if (!j->enabled) {
+        return 0;
+    }
+    if (ftl->slc.blocks) {
+        fprintf(stderr, "[JOURNAL] Turn the SLC cache off first (it sits at the end of the data area)\n");
+        return -1;
+    }
+
+    // mount 시 journal로 오인하지 않도록 meta 영역을 비우고 data 영역으로 반환
+    for (uint32_t b = j->first_block; b < TOTAL_BLOCKS; b++) {
+        journal_erase_block(ftl, b);
+    }
+    j->enabled = false;
+    j->buffered = 0;
+    ftl->data_blocks = TOTAL_BLOCKS;
+
+    printf("[JOURNAL] Disabled\n");
+    return 0;
+}
+
+// ==================== LOGGING ====================
+
+void journal_append(FTL *ftl, uint32_t lba, uint32_t pba) {
+    Journal *j = &ftl->journal;
+
+    if (!j->enabled) {
+        return;
+    }
+
+    j->buffer[j->buffered].lba = lba;
+    j->buffer[j->buffered].pba = pba;
+    j->buffered++;
+    j->entries++;
+
+    if (j->buffered == JOURNAL_ENTRIES_PER_PAGE) {
+        journal_flush(ftl);
+    }
+}
+
+// packed page는 program 뒤에 slot 수만큼 매핑을 갱신하므로, 중간에 journal page가 차서 flush되면
+// 나머지 slot은 그 meta page보다 먼저 program된 page를 가리켜 roll-forward 대상에서 빠짐
+void journal_reserve(FTL *ftl, uint32_t n) {
+    Journal *j = &ftl->journal;
+
+    if (j->enabled && j->buffered + n > JOURNAL_ENTRIES_PER_PAGE) {
+        journal_flush(ftl);
+    }
+}
+
+int journal_flush(FTL *ftl) {
+    Journal *j = &ftl->journal;
+
+    if (!j->enabled || j->buffered == 0) {
+        return 0;
+    }
+
+    // active 블록이 가득 찼으면 새 checkpoint가 버퍼 내용을 포함
+    if (j->next_page >= PAGES_PER_BLOCK) {
+        return journal_checkpoint(ftl);
+    }
+
+    MetaPageHeader hdr = {
+        .magic = META_MAGIC,
+        .type = META_PAGE_JOURNAL,
+        .ckpt_id = j->ckpt_id,
+        .part = 0,
+        .parts = 0,
+        .count = j->buffered
+    };
+
+    if (journal_write_meta(ftl, &hdr, j->buffer, j->buffered * sizeof(JournalEntry)) != 0) {
+        return -1;
+    }
+
+    j->buffered = 0;
+    j->journal_pages++;
+    j->pages_since_ckpt++;
+
+    if (j->pages_since_ckpt >= JOURNAL_CKPT_INTERVAL) {
+        return journal_checkpoint(ftl);
+    }
+    return 0;
+}
+
+int journal_checkpoint(FTL *ftl) {
+    Journal *j = &ftl->journal;
+
+    if (!j->enabled) {
+        return 0;
+    }
+
+    if (j->next_page + CKPT_PARTS > PAGES_PER_BLOCK) {
+        journal_switch_block(ftl);
+    }
+
+    j->ckpt_id++;
+
+    for (uint32_t part = 0; part < CKPT_PARTS; part++) {
+        uint32_t entries[CKPT_ENTRIES_PER_PAGE];
+        uint32_t base = part * CKPT_ENTRIES_PER_PAGE;
+        uint32_t count = 0;
+
+        for (uint32_t i = 0; i < CKPT_ENTRIES_PER_PAGE && base + i < TOTAL_LOGICAL_PAGES; i++) {
+            entries[i] = ftl_l2p_lookup(ftl, base + i);
+            count++;
+        }
+
+        MetaPageHeader hdr = {
+            .magic = META_MAGIC,
+            .type = META_PAGE_CHECKPOINT,
+            .ckpt_id = j->ckpt_id,
+            .part = part,
+            .parts = CKPT_PARTS,
+            .count = count
+        };
+        if (journal_write_meta(ftl, &hdr, entries, count * sizeof(uint32_t)) != 0) {
+            return -1;
+        }
+        j->checkpoint_pages++;
+    }
+
+    // checkpoint가 현재 매핑 전체를 담으므로 버퍼는 비워도 됨
+    j->buffered = 0;
+    j->pages_since_ckpt = 0;
+    j->checkpoints++;
+    return 0;
+}
+
+// ==================== RECOVERY ====================
+
+typedef struct {
+    uint32_t pba;
+    uint32_t seq;
+} MetaPageRef;
+
+static int meta_ref_compare(const void *a, const void *b) {
+    uint32_t sa = ((const MetaPageRef *)a)->seq;
+    uint32_t sb = ((const MetaPageRef *)b)->seq;
+    return (sa > sb) - (sa < sb);
+}
+
+static int journal_read_meta(FTL *ftl, uint32_t pba, uint8_t *buffer, MetaPageHeader *hdr) {
+    if (nand_read_page(&ftl->nand, pba, buffer) != 0) {
+        return -1;
+    }
+    memcpy(hdr, buffer, sizeof(MetaPageHeader));
+    return (hdr->magic == META_MAGIC) ? 0 : -1;
+}
+
+// flush_seq보다 나중에 program된 data page를 쓰기 순서대로 매핑에 반영.
+// 덮어쓰기 / trim / GC 이동으로 밀린 사본은 INVALID이므로 VALID page만 본다
+// (새 page program 후 이전 page 무효화 전에 끊긴 경우는 순서상 새 page가 이김)
+static uint32_t journal_roll_forward(FTL *ftl, uint32_t *table, uint32_t flush_seq, uint32_t open_blocks) {
+    uint32_t data_blocks = TOTAL_BLOCKS - META_BLOCKS;
+    MetaPageRef pages[(TOTAL_BLOCKS - META_BLOCKS) * PAGES_PER_BLOCK];
+    uint32_t count = 0;
+    uint8_t page[PAGE_SIZE];
+    PackHeader hdr;
+
+    for (uint32_t b = 0; b < data_blocks; b++) {
+        if (!(open_blocks & (1u << b))) continue;
+
+        for (uint32_t pba = b * PAGES_PER_BLOCK; pba < (b + 1) * PAGES_PER_BLOCK; pba++) {
+            OOB oob;
+            if (nand_get_page_state(&ftl->nand, pba) == PAGE_FREE) continue;
+            if (nand_read_oob(&ftl->nand, pba, &oob) != 0 || oob.state != PAGE_VALID) continue;
+            if (oob.write_count <= flush_seq) continue;
+            if (oob.lba < TOTAL_LOGICAL_PAGES || (oob.lba & LBA_TAG_MASK) == LBA_TAG_PACK) {
+                pages[count].pba = pba;
+                pages[count].seq = oob.write_count;
+                count++;
+            }
+        }
+    }
+
+    qsort(pages, count, sizeof(MetaPageRef), meta_ref_compare);
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t pba = pages[i].pba;
+        uint32_t lba = ftl->nand.blocks[pba / PAGES_PER_BLOCK].pages[pba % PAGES_PER_BLOCK].oob.lba;
+
+        if ((lba & LBA_TAG_MASK) != LBA_TAG_PACK) {
+            table[lba] = pba;
+        } else if (pack_read_header(&ftl->nand, pba, page, &hdr) == 0) {
+            for (uint32_t s = 0; s < hdr.count; s++) {
+                if (hdr.slots[s].lba < TOTAL_LOGICAL_PAGES) table[hdr.slots[s].lba] = pba;
+            }
+        }
+    }
+    return count;
+}
+
+int journal_recover(FTL *ftl, uint32_t *table, JournalRecovery *rec) {
+    uint32_t first_block = TOTAL_BLOCKS - META_BLOCKS;
+    MetaPageRef ckpt_pages[META_BLOCKS * PAGES_PER_BLOCK];
+    MetaPageRef jrnl_pages[META_BLOCKS * PAGES_PER_BLOCK];
+    uint32_t ckpt_count = 0, jrnl_count = 0;
+    uint32_t last_seq = 0, last_pba = 0xFFFFFFFF;
+    uint8_t buffer[PAGE_SIZE];
+    MetaPageHeader hdr;
+
+    memset(rec, 0, sizeof(JournalRecovery));
+
+    // Step 1: meta 영역의 OOB만 읽어서 checkpoint / journal page 분류
+    for (uint32_t pba = first_block * PAGES_PER_BLOCK; pba < TOTAL_PAGES; pba++) {
+        OOB oob;
+        if (nand_read_oob(&ftl->nand, pba, &oob) != 0 || oob.state == PAGE_FREE) {
+            continue;
+        }
+        if ((oob.lba & LBA_TAG_MASK) != LBA_TAG_META) {
+            continue;
+        }
+
+        MetaPageRef ref = { pba, oob.write_count };
+        if ((oob.lba & ~LBA_TAG_MASK) == META_PAGE_CHECKPOINT) {
+            ckpt_pages[ckpt_count++] = ref;
+        } else {
+            jrnl_pages[jrnl_count++] = ref;
+        }
+        if (last_pba == 0xFFFFFFFF || oob.write_count > last_seq) {
+            last_seq = oob.write_count;
+            last_pba = pba;
+        }
+    }
+
+    // Step 2: 모든 조각이 있는 가장 최근 checkpoint 선택
+    uint32_t best_id = 0, best_seq = 0, max_id = 0;
+    uint32_t flush_seq, open_blocks = 0;
+    uint32_t parts_seen[META_BLOCKS * PAGES_PER_BLOCK];
+    uint32_t ids[META_BLOCKS * PAGES_PER_BLOCK];
+    uint32_t id_count = 0;
+
+    for (uint32_t i = 0; i < ckpt_count; i++) {
+        if (journal_read_meta(ftl, ckpt_pages[i].pba, buffer, &hdr) != 0) continue;
+        if (hdr.ckpt_id > max_id) max_id = hdr.ckpt_id;
+
+        uint32_t k = 0;
+        while (k < id_count && ids[k] != hdr.ckpt_id) k++;
+        if (k == id_count) {
+            ids[id_count] = hdr.ckpt_id;
+            parts_seen[id_count] = 0;
+            id_count++;
+        }
+        parts_seen[k]++;
+        if (parts_seen[k] == hdr.parts && hdr.ckpt_id > best_id) {
+            best_id = hdr.ckpt_id;
+        }
+    }
+    if (best_id == 0) {
+        return -1;
+    }
+
+    // Step 3: checkpoint 로드
+    for (uint32_t lba = 0; lba < TOTAL_LOGICAL_PAGES; lba++) {
+        table[lba] = 0xFFFFFFFF;
+    }
+    for (uint32_t i = 0; i < ckpt_count; i++) {
+        if (journal_read_meta(ftl, ckpt_pages[i].pba, buffer, &hdr) != 0) continue;
+        if (hdr.ckpt_id != best_id) continue;
+
+        const uint32_t *entries = (const uint32_t *)(buffer + sizeof(MetaPageHeader));
+        uint32_t base = hdr.part * CKPT_ENTRIES_PER_PAGE;
+        for (uint32_t e = 0; e < hdr.count && base + e < TOTAL_LOGICAL_PAGES; e++) {
+            table[base + e] = entries[e];
+        }
+        if (ckpt_pages[i].seq > best_seq) {
+            best_seq = ckpt_pages[i].seq;
+            open_blocks = hdr.open_blocks;
+        }
+    }
+    flush_seq = best_seq;
+
+    // Step 4: checkpoint 이후 journal을 기록 순서대로 replay
+    qsort(jrnl_pages, jrnl_count, sizeof(MetaPageRef), meta_ref_compare);
+    for (uint32_t i = 0; i < jrnl_count; i++) {
+        if (jrnl_pages[i].seq < best_seq) continue;
+        if (journal_read_meta(ftl, jrnl_pages[i].pba, buffer, &hdr) != 0) continue;
+        if (hdr.ckpt_id != best_id) continue;
+
+        const JournalEntry *entries = (const JournalEntry *)(buffer + sizeof(MetaPageHeader));
+        for (uint32_t e = 0; e < hdr.count; e++) {
+            if (entries[e].lba < TOTAL_LOGICAL_PAGES) {
+                table[entries[e].lba] = entries[e].pba;
+            }
+        }
+        rec->journal_pages_replayed++;
+        rec->entries_replayed += hdr.count;
+        flush_seq = jrnl_pages[i].seq;
+        open_blocks = hdr.open_blocks;
+    }
+
+    // Step 5: 마지막으로 반영된 meta page 이후의 program (buffer에만 있던 갱신) roll-forward
+    rec->pages_rolled_forward = journal_roll_forward(ftl, table, flush_seq, open_blocks);
+
+    // 이어 쓸 위치 = 가장 마지막에 기록된 meta page 다음
+    rec->ckpt_id = max_id;
+    rec->active = last_pba / PAGES_PER_BLOCK - first_block;
+    rec->next_page = last_pba % PAGES_PER_BLOCK + 1;
+    return 0;
+}
+
+void journal_resume(FTL *ftl, const JournalRecovery *rec) {
+    Journal *j = &ftl->journal;
+
+    j->enabled = true;
+    j->first_block = TOTAL_BLOCKS - META_BLOCKS;
+    j->active = rec->active;
+    j->next_page = rec->next_page;
+    j->ckpt_id = rec->ckpt_id;
+    j->buffered = 0;
+    j->pages_since_ckpt = 0;
+    ftl->data_blocks = j->first_block;
+}
+
+// ==================== STATISTICS ====================
+
+void journal_print_statistics(const Journal *j) {
+    printf("---------- Mapping Journal ----------\n");
+    printf("Meta Blocks:         %u~%u (active: %u, next page: %u)\n",
+           j->first_block, j->first_block + META_BLOCKS - 1,
+           j->first_block + j->active, j->next_page);
+    printf("Journal Entries:     %lu (%u buffered, %u/page)\n",
+           j->entries, j->buffered, (uint32_t)JOURNAL_ENTRIES_PER_PAGE);
+    printf("Journal Pages:       %lu\n", j->journal_pages);
+    printf("Checkpoints:         %lu (%lu pages, last id %u)\n",
+           j->checkpoints, j->checkpoint_pages, j->ckpt_id);
+    printf("Meta Block Erases:   %lu\n", j->meta_erases);
+}
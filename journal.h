@@ -0,0 +1,109 @@
+/*
+ * journal.h - Mapping Journal & L2P Checkpoint
+ *
+ * 매핑 변경(lba -> pba)을 예약된 meta 블록에 순차 기록하고,
+ * 주기적으로 전체 L2P를 checkpoint로 남긴다.
+ * mount 시에는 "마지막 checkpoint 로드 + 이후 journal replay"만 하면 되므로
+ * 전체 OOB 스캔이 필요 없다.
+ *
+ * - meta 영역: 디바이스 마지막 META_BLOCKS개 블록 (GC/할당 대상에서 제외)
+ * - 블록 erase 전에는 항상 journal을 flush 해서, 복구된 매핑이
+ *   이미 지워진 페이지를 가리키지 않도록 한다.
+ * - flush 되지 않은 갱신은 mount 때 OOB로 roll-forward 한다. meta page마다 기록 시점에
+ *   program이 더 들어올 수 있던 data 블록 bitmap을 남기므로, 그 블록에서 마지막 meta page보다
+ *   나중에 program된 page만 쓰기 순서대로 반영하면 된다 (전체 OOB 스캔 불필요).
+ */
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include "nand_flash.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// ==================== JOURNAL CONFIGURATION ====================
+#define META_BLOCKS                 2       // journal / checkpoint 전용 블록 수
+#define JOURNAL_CKPT_INTERVAL       32      // journal page 32장마다 checkpoint
+#define META_MAGIC                  0x4A524E4C  // "JRNL"
+
+#if TOTAL_BLOCKS > 32
+#error "MetaPageHeader.open_blocks bitmap holds at most 32 blocks"
+#endif
+
+// ==================== DATA STRUCTURES ====================
+
+typedef enum {
+    META_PAGE_CHECKPOINT = 1,
+    META_PAGE_JOURNAL = 2
+} MetaPageType;
+
+// meta page 앞부분 헤더 (나머지는 checkpoint 엔트리 또는 journal 엔트리)
+typedef struct {
+    uint32_t magic;
+    uint32_t type;          // MetaPageType
+    uint32_t ckpt_id;       // checkpoint 번호 (journal page는 기준 checkpoint 번호)
+    uint32_t part;          // checkpoint 조각 번호
+    uint32_t parts;         // checkpoint 전체 조각 수
+    uint32_t count;         // 유효 엔트리 수
+    uint32_t open_blocks;   // 기록 시점에 이후 program이 들어올 수 있는 data 블록 (roll-forward 범위)
+} MetaPageHeader;
+
+typedef struct {
+    uint32_t lba;
+    uint32_t pba;
+} JournalEntry;
+
+#define JOURNAL_ENTRIES_PER_PAGE    ((PAGE_SIZE - sizeof(MetaPageHeader)) / sizeof(JournalEntry))
+#define CKPT_ENTRIES_PER_PAGE       ((PAGE_SIZE - sizeof(MetaPageHeader)) / sizeof(uint32_t))
+
+typedef struct {
+    bool enabled;
+    uint32_t first_block;           // meta 영역 시작 블록
+    uint32_t active;                // 기록 중인 meta 블록 (0 ~ META_BLOCKS-1)
+    uint32_t next_page;             // active 블록에서 다음에 쓸 page
+    uint32_t ckpt_id;               // 마지막으로 기록한 checkpoint 번호
+    uint32_t pages_since_ckpt;
+
+    JournalEntry buffer[JOURNAL_ENTRIES_PER_PAGE];
+    uint32_t buffered;
+
+    // 통계
+    uint64_t entries;
+    uint64_t journal_pages;
+    uint64_t checkpoints;
+    uint64_t checkpoint_pages;
+    uint64_t meta_erases;
+} Journal;
+
+// 복구 결과 (journal_recover가 채움)
+typedef struct {
+    uint32_t ckpt_id;
+    uint32_t active;
+    uint32_t next_page;
+    uint32_t journal_pages_replayed;
+    uint64_t entries_replayed;
+    uint32_t pages_rolled_forward;  // 마지막 meta page 이후 program되어 OOB로 반영한 page
+} JournalRecovery;
+
+struct FTL;
+
+// ==================== FUNCTION PROTOTYPES ====================
+
+int journal_enable(struct FTL *ftl);
+int journal_disable(struct FTL *ftl);
+
+// 매핑 변경 기록 (버퍼가 차면 flush)
+void journal_append(struct FTL *ftl, uint32_t lba, uint32_t pba);
+// page 한 장의 매핑 변경 n개가 같은 journal page에 들어가도록 자리가 모자라면 미리 flush
+void journal_reserve(struct FTL *ftl, uint32_t n);
+int journal_flush(struct FTL *ftl);
+int journal_checkpoint(struct FTL *ftl);
+
+// meta 영역에서 매핑 복구 (checkpoint가 없으면 -1). 상태는 바꾸지 않음
+int journal_recover(struct FTL *ftl, uint32_t *table, JournalRecovery *rec);
+// 복구 결과 위치부터 journal 기록 재개
+void journal_resume(struct FTL *ftl, const JournalRecovery *rec);
+
+void journal_print_statistics(const Journal *j);
+
+#endif // JOURNAL_H
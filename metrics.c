@@ -0,0 +1,292 @@
+/*
+ * metrics.c - Metrics Registry & Time-Series Sampler
+ */
+
+#include "metrics.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ==================== METRIC DESCRIPTORS ====================
+
+typedef struct {
+    const char *name;
+    const char *help;
+} MetricDesc;
+
+static const MetricDesc counter_desc[MET_COUNTER_COUNT] = {
+    [MET_HOST_WRITES]       = { "ssd_host_writes_total",       "Host page writes" },
+    [MET_HOST_READS]        = { "ssd_host_reads_total",        "Host page reads" },
+    [MET_NAND_WRITES]       = { "ssd_nand_writes_total",       "NAND page programs" },
+    [MET_NAND_READS]        = { "ssd_nand_reads_total",        "NAND page reads" },
+    [MET_BLOCK_ERASES]      = { "ssd_block_erases_total",      "NAND block erases" },
+    [MET_GC_INVOCATIONS]    = { "ssd_gc_invocations_total",    "Garbage collection invocations" },
+    [MET_GC_PAGES_MIGRATED] = { "ssd_gc_pages_migrated_total", "Valid pages migrated by GC" },
+    [MET_MAP_CACHE_HITS]    = { "ssd_map_cache_hits_total",    "Cached mapping table hits" },
+    [MET_MAP_CACHE_MISSES]  = { "ssd_map_cache_misses_total",  "Cached mapping table misses" },
+    [MET_TRANS_PAGE_WRITES] = { "ssd_trans_page_writes_total", "Translation page programs" },
+};
+
+static const MetricDesc gauge_desc[MET_GAUGE_COUNT] = {
+    [MET_FREE_BLOCKS]     = { "ssd_free_blocks",     "Fully erased blocks" },
+    [MET_FREE_PAGES]      = { "ssd_free_pages",      "Free (erased) pages" },
+    [MET_VALID_PAGES]     = { "ssd_valid_pages",     "Valid pages" },
+    [MET_INVALID_PAGES]   = { "ssd_invalid_pages",   "Invalid pages" },
+    [MET_ERASE_COUNT_MIN] = { "ssd_erase_count_min", "Minimum block erase count" },
+    [MET_ERASE_COUNT_MAX] = { "ssd_erase_count_max", "Maximum block erase count" },
+    [MET_ERASE_COUNT_AVG] = { "ssd_erase_count_avg", "Average block erase count" },
+    [MET_WAF]             = { "ssd_waf",             "Cumulative write amplification" },
+};
+
+static const MetricDesc hist_desc[MET_HIST_COUNT] = {
+    [MET_H_GC_PAGES_PER_GC]    = { "ssd_gc_pages_per_gc",      "Pages migrated per GC invocation" },
+    [MET_H_VICTIM_VALID_RATIO] = { "ssd_gc_victim_valid_ratio", "Valid ratio of GC victim blocks" },
+    [MET_H_WRITE_LATENCY_NS]   = { "ssd_write_latency_ns",     "Host write latency (ns)" },
+    [MET_H_READ_LATENCY_NS]    = { "ssd_read_latency_ns",      "Host read latency (ns)" },
+};
+
+// 버킷 상한 (le). 마지막 +Inf 버킷은 암묵적
+static double hist_bound(MetricHistogram h, uint32_t i) {
+    switch (h) {
+        case MET_H_GC_PAGES_PER_GC:
+            return (i == 0) ? 0.0 : (double)(1u << (i - 1));     // 0,1,2,4,...
+        case MET_H_VICTIM_VALID_RATIO:
+            return 0.1 * (i + 1);                               // 0.1 ~ 1.0
+        case MET_H_WRITE_LATENCY_NS:
+        case MET_H_READ_LATENCY_NS:
+            return (double)(1ull << (i + 6));                   // 64ns ~ 1s
+        default:
+            return 0.0;
+    }
+}
+
+static uint32_t hist_bucket_count(MetricHistogram h) {
+    switch (h) {
+        case MET_H_GC_PAGES_PER_GC:    return 12;
+        case MET_H_VICTIM_VALID_RATIO: return 10;
+        case MET_H_WRITE_LATENCY_NS:
+        case MET_H_READ_LATENCY_NS:    return 25;
+        default:                       return 0;
+    }
+}
+
+// ==================== INITIALIZATION ====================
+
+uint64_t metrics_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+void metrics_init(Metrics *m, uint32_t sample_interval, uint64_t now_us) {
+    memset(m, 0, sizeof(Metrics));
+    m->enabled = true;
+
+    for (int h = 0; h < MET_HIST_COUNT; h++) {
+        m->hists[h].bucket_count = hist_bucket_count((MetricHistogram)h);
+    }
+
+    m->sample_interval = sample_interval;
+    m->next_sample_at = sample_interval;
+    m->start_us = now_us;
+}
+
+void metrics_cleanup(Metrics *m) {
+    free(m->samples);
+    m->samples = NULL;
+    m->sample_count = 0;
+    m->sample_capacity = 0;
+}
+
+void metrics_reset(Metrics *m, uint64_t now_us) {
+    uint32_t interval = m->sample_interval;
+    bool enabled = m->enabled;
+
+    metrics_cleanup(m);
+    metrics_init(m, interval, now_us);
+    m->enabled = enabled;
+}
+
+void metrics_set_interval(Metrics *m, uint32_t sample_interval) {
+    m->sample_interval = sample_interval;
+    m->next_sample_at = m->counters[MET_HOST_WRITES] + sample_interval;
+}
+
+// ==================== COLLECTION ====================
+
+void metrics_observe(Metrics *m, MetricHistogram h, double v) {
+    Histogram *hist = &m->hists[h];
+    uint32_t i = 0;
+
+    // 버킷 수가 작으므로 선형 탐색으로 충분
+    while (i < hist->bucket_count && v > hist_bound(h, i)) {
+        i++;
+    }
+
+    hist->buckets[i]++;
+    hist->count++;
+    hist->sum += v;
+}
+
+void metrics_record_sample(Metrics *m, uint64_t now_us) {
+    if (m->sample_count == m->sample_capacity) {
+        uint32_t new_cap = m->sample_capacity ? m->sample_capacity * 2 : 64;
+        MetricSample *grown = realloc(m->samples, new_cap * sizeof(MetricSample));
+        if (!grown) {
+            fprintf(stderr, "[METRICS] Out of memory, sample dropped\n");
+            return;
+        }
+        m->samples = grown;
+        m->sample_capacity = new_cap;
+    }
+
+    MetricSample *s = &m->samples[m->sample_count];
+    // wall clock이 아닌 가상 시각 기준이라 같은 입력이면 실행마다 같은 시계열이 나옴
+    s->elapsed_ms = (now_us - m->start_us) / 1000ull;
+    memcpy(s->counters, m->counters, sizeof(s->counters));
+    memcpy(s->gauges, m->gauges, sizeof(s->gauges));
+
+    // 직전 샘플 대비 WAF
+    uint64_t prev_host = 0, prev_nand = 0;
+    if (m->sample_count > 0) {
+        prev_host = m->samples[m->sample_count - 1].counters[MET_HOST_WRITES];
+        prev_nand = m->samples[m->sample_count - 1].counters[MET_NAND_WRITES];
+    }
+    uint64_t dh = s->counters[MET_HOST_WRITES] - prev_host;
+    uint64_t dn = s->counters[MET_NAND_WRITES] - prev_nand;
+    s->interval_waf = dh ? (double)dn / (double)dh : 0.0;
+
+    m->sample_count++;
+}
+
+// ==================== EXPORT ====================
+
+int metrics_export_csv(const Metrics *m, const char *filename) {
+    FILE *fp = fopen(filename, "w");
+    if (!fp) {
+        fprintf(stderr, "[METRICS] Failed to open %s\n", filename);
+        return -1;
+    }
+
+    fprintf(fp, "elapsed_ms");
+    for (int c = 0; c < MET_COUNTER_COUNT; c++) fprintf(fp, ",%s", counter_desc[c].name);
+    for (int g = 0; g < MET_GAUGE_COUNT; g++) fprintf(fp, ",%s", gauge_desc[g].name);
+    fprintf(fp, ",ssd_interval_waf\n");
+
+    for (uint32_t i = 0; i < m->sample_count; i++) {
+        const MetricSample *s = &m->samples[i];
+        fprintf(fp, "%lu", s->elapsed_ms);
+        for (int c = 0; c < MET_COUNTER_COUNT; c++) fprintf(fp, ",%lu", s->counters[c]);
+        for (int g = 0; g < MET_GAUGE_COUNT; g++) fprintf(fp, ",%.4f", s->gauges[g]);
+        fprintf(fp, ",%.4f\n", s->interval_waf);
+    }
+
+    fclose(fp);
+    return 0;
+}
+
+int metrics_export_json(const Metrics *m, const char *filename) {
+    FILE *fp = fopen(filename, "w");
+    if (!fp) {
+        fprintf(stderr, "[METRICS] Failed to open %s\n", filename);
+        return -1;
+    }
+
+    fprintf(fp, "{\n  \"samples\": [\n");
+    for (uint32_t i = 0; i < m->sample_count; i++) {
+        const MetricSample *s = &m->samples[i];
+        fprintf(fp, "    {\"elapsed_ms\": %lu", s->elapsed_ms);
+        for (int c = 0; c < MET_COUNTER_COUNT; c++)
+            fprintf(fp, ", \"%s\": %lu", counter_desc[c].name, s->counters[c]);
+        for (int g = 0; g < MET_GAUGE_COUNT; g++)
+            fprintf(fp, ", \"%s\": %.4f", gauge_desc[g].name, s->gauges[g]);
+        fprintf(fp, ", \"ssd_interval_waf\": %.4f}%s\n",
+                s->interval_waf, (i + 1 < m->sample_count) ? "," : "");
+    }
+    fprintf(fp, "  ],\n  \"histograms\": {\n");
+
+    for (int h = 0; h < MET_HIST_COUNT; h++) {
+        const Histogram *hist = &m->hists[h];
+        fprintf(fp, "    \"%s\": {\"count\": %lu, \"sum\": %.4f, \"buckets\": [",
+                hist_desc[h].name, hist->count, hist->sum);
+        for (uint32_t i = 0; i <= hist->bucket_count; i++) {
+            if (i < hist->bucket_count) {
+                fprintf(fp, "{\"le\": %g, \"count\": %lu}, ",
+                        hist_bound((MetricHistogram)h, i), hist->buckets[i]);
+            } else {
+                fprintf(fp, "{\"le\": \"+Inf\", \"count\": %lu}", hist->buckets[i]);
+            }
+        }
+        fprintf(fp, "]}%s\n", (h + 1 < MET_HIST_COUNT) ? "," : "");
+    }
+
+    fprintf(fp, "  }\n}\n");
+    fclose(fp);
+    return 0;
+}
+
+int metrics_export_prometheus(const Metrics *m, const char *filename) {
+    // 부분적으로 쓰인 파일을 scraper가 읽지 않도록 임시 파일 후 rename
+    char tmp_name[512];
+    snprintf(tmp_name, sizeof(tmp_name), "%s.tmp", filename);
+
+    FILE *fp = fopen(tmp_name, "w");
+    if (!fp) {
+        fprintf(stderr, "[METRICS] Failed to open %s\n", tmp_name);
+        return -1;
+    }
+
+    for (int c = 0; c < MET_COUNTER_COUNT; c++) {
+        fprintf(fp, "# HELP %s %s\n# TYPE %s counter\n%s %lu\n",
+                counter_desc[c].name, counter_desc[c].help,
+                counter_desc[c].name, counter_desc[c].name, m->counters[c]);
+    }
+    for (int g = 0; g < MET_GAUGE_COUNT; g++) {
+        fprintf(fp, "# HELP %s %s\n# TYPE %s gauge\n%s %.4f\n",
+                gauge_desc[g].name, gauge_desc[g].help,
+                gauge_desc[g].name, gauge_desc[g].name, m->gauges[g]);
+    }
+    for (int h = 0; h < MET_HIST_COUNT; h++) {
+        const Histogram *hist = &m->hists[h];
+        const char *name = hist_desc[h].name;
+        uint64_t cumulative = 0;
+
+        fprintf(fp, "# HELP %s %s\n# TYPE %s histogram\n", name, hist_desc[h].help, name);
+        for (uint32_t i = 0; i < hist->bucket_count; i++) {
+            cumulative += hist->buckets[i];
+            fprintf(fp, "%s_bucket{le=\"%g\"} %lu\n",
+                    name, hist_bound((MetricHistogram)h, i), cumulative);
+        }
+        cumulative += hist->buckets[hist->bucket_count];
+        fprintf(fp, "%s_bucket{le=\"+Inf\"} %lu\n", name, cumulative);
+        fprintf(fp, "%s_sum %.4f\n%s_count %lu\n", name, hist->sum, name, hist->count);
+    }
+
+    fclose(fp);
+    if (rename(tmp_name, filename) != 0) {
+        fprintf(stderr, "[METRICS] Failed to rename %s -> %s\n", tmp_name, filename);
+        return -1;
+    }
+    return 0;
+}
+
+// ==================== DEBUGGING ====================
+
+void metrics_print(const Metrics *m) {
+    printf("\n========== Metrics ==========\n");
+    for (int c = 0; c < MET_COUNTER_COUNT; c++) {
+        printf("%-30s %lu\n", counter_desc[c].name, m->counters[c]);
+    }
+    for (int g = 0; g < MET_GAUGE_COUNT; g++) {
+        printf("%-30s %.2f\n", gauge_desc[g].name, m->gauges[g]);
+    }
+    for (int h = 0; h < MET_HIST_COUNT; h++) {
+        const Histogram *hist = &m->hists[h];
+        printf("%-30s count=%lu avg=%.2f\n", hist_desc[h].name, hist->count,
+               hist->count ? hist->sum / hist->count : 0.0);
+    }
+    printf("Samples recorded:              %u (interval: %u host writes)\n",
+           m->sample_count, m->sample_interval);
+    printf("=============================\n");
+}
@@ -0,0 +1,119 @@
+/*
+ * metrics.h - Metrics Registry & Time-Series Sampler
+ *
+ * FTL/NAND 동작을 counter / gauge / histogram 으로 수집하고,
+ * 주기적으로 샘플링한 시계열을 CSV / JSON / Prometheus 텍스트로 내보낸다.
+ *
+ * 레지스트리는 FTL 인스턴스마다 하나씩 존재하며, 한 인스턴스는 한 스레드가
+ * 구동하므로 카운터는 atomic 없이 단순 증가만 한다 (= per-thread counter).
+ */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ==================== METRIC IDS ====================
+
+// 단조 증가 카운터
+typedef enum {
+    MET_HOST_WRITES = 0,
+    MET_HOST_READS,
+    MET_NAND_WRITES,
+    MET_NAND_READS,
+    MET_BLOCK_ERASES,
+    MET_GC_INVOCATIONS,
+    MET_GC_PAGES_MIGRATED,
+    MET_MAP_CACHE_HITS,             // DFTL CMT hit
+    MET_MAP_CACHE_MISSES,
+    MET_TRANS_PAGE_WRITES,          // DFTL translation page 기록
+    MET_COUNTER_COUNT
+} MetricCounter;
+
+// 샘플 시점의 순간 값
+typedef enum {
+    MET_FREE_BLOCKS = 0,
+    MET_FREE_PAGES,
+    MET_VALID_PAGES,
+    MET_INVALID_PAGES,
+    MET_ERASE_COUNT_MIN,
+    MET_ERASE_COUNT_MAX,
+    MET_ERASE_COUNT_AVG,
+    MET_WAF,
+    MET_GAUGE_COUNT
+} MetricGauge;
+
+// 분포
+typedef enum {
+    MET_H_GC_PAGES_PER_GC = 0,      // GC 1회당 이동한 valid page 수
+    MET_H_VICTIM_VALID_RATIO,       // victim 블록의 valid 비율 (0.0 ~ 1.0)
+    MET_H_WRITE_LATENCY_NS,         // ftl_write 지연 (wall-clock)
+    MET_H_READ_LATENCY_NS,          // ftl_read 지연 (wall-clock)
+    MET_HIST_COUNT
+} MetricHistogram;
+
+#define METRICS_MAX_BUCKETS     32
+
+// ==================== DATA STRUCTURES ====================
+
+typedef struct {
+    uint32_t bucket_count;                  // +Inf 버킷 제외
+    uint64_t buckets[METRICS_MAX_BUCKETS + 1];
+    uint64_t count;
+    double   sum;
+} Histogram;
+
+// 시계열의 한 행
+typedef struct {
+    uint64_t elapsed_ms;                    // 레지스트리 생성 이후 NAND 가상 시간
+    uint64_t counters[MET_COUNTER_COUNT];
+    double   gauges[MET_GAUGE_COUNT];
+    double   interval_waf;                  // 직전 샘플 대비 WAF
+} MetricSample;
+
+typedef struct {
+    bool     enabled;
+    uint64_t counters[MET_COUNTER_COUNT];
+    double   gauges[MET_GAUGE_COUNT];
+    Histogram hists[MET_HIST_COUNT];
+
+    // 시계열 샘플러
+    uint32_t sample_interval;               // host write N회마다 샘플 (0 = off)
+    uint64_t next_sample_at;                // 다음 샘플 시점 (host write 수)
+    uint64_t start_us;                      // 레지스트리 생성 시 NAND 가상 시각
+    MetricSample *samples;
+    uint32_t sample_count;
+    uint32_t sample_capacity;
+} Metrics;
+
+// ==================== FUNCTION PROTOTYPES ====================
+
+void metrics_init(Metrics *m, uint32_t sample_interval, uint64_t now_us);
+void metrics_cleanup(Metrics *m);
+void metrics_reset(Metrics *m, uint64_t now_us);
+
+uint64_t metrics_now_ns(void);
+
+static inline void metrics_inc(Metrics *m, MetricCounter c, uint64_t n) {
+    m->counters[c] += n;
+}
+
+static inline void metrics_set(Metrics *m, MetricGauge g, double v) {
+    m->gauges[g] = v;
+}
+
+void metrics_observe(Metrics *m, MetricHistogram h, double v);
+
+// 현재 counter/gauge 값을 시계열에 한 행으로 추가 (now_us = NAND 가상 시각)
+void metrics_record_sample(Metrics *m, uint64_t now_us);
+void metrics_set_interval(Metrics *m, uint32_t sample_interval);
+
+// 내보내기 (성공 시 0, 실패 시 -1)
+int metrics_export_csv(const Metrics *m, const char *filename);
+int metrics_export_json(const Metrics *m, const char *filename);
+int metrics_export_prometheus(const Metrics *m, const char *filename);
+
+void metrics_print(const Metrics *m);
+
+#endif // METRICS_H
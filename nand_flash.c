@@ -4,66 +4,228 @@
  * 실제 NAND Flash 동작을 충실히 재현
  */
 
+#define _GNU_SOURCE
 #include "nand_flash.h"
+#include "crc32c.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 // ==================== INITIALIZATION ====================
 
-void nand_init(NANDFlash *nand) {
+static int nand_init_store(NANDFlash *nand, bool shared) {
     memset(nand, 0, sizeof(NANDFlash));
+    nand->image_fd = -1;
+    nand->payload = payload_create(TOTAL_PAGES, PAGE_SIZE, shared);
+    if (!nand->payload) {
+        fprintf(stderr, "[NAND] Failed to create payload store\n");
+        return -1;
+    }
     
     // 모든 페이지를 FREE 상태로 초기화
     for (uint32_t b = 0; b < TOTAL_BLOCKS; b++) {
         nand->blocks[b].erase_count = 0;
         nand->blocks[b].invalid_page_count = 0;
+        nand->blocks[b].valid_page_count = 0;
         
         for (uint32_t p = 0; p < PAGES_PER_BLOCK; p++) {
             nand->blocks[b].pages[p].oob.state = PAGE_FREE;
             nand->blocks[b].pages[p].oob.lba = 0xFFFFFFFF;
             nand->blocks[b].pages[p].oob.write_count = 0;
             nand->blocks[b].pages[p].oob.timestamp = 0;
+            nand->blocks[b].pages[p].slot = PAYLOAD_NO_SLOT;
+            nand->blocks[b].pages[p].value = 0;
         }
     }
     
     nand->total_page_writes = 0;
+    nand->total_page_reads = 0;
+    nand->total_oob_reads = 0;
     nand->total_block_erases = 0;
+    nand->crash_at_write = 0;
+    nand->crc_enabled = NAND_CRC_DEFAULT;
+    nand->copyback_enabled = NAND_COPYBACK_DEFAULT;
+    nand->erase_mode = NAND_ERASE_MODE_DEFAULT;
+    nand->metadata_only = NAND_METADATA_ONLY_DEFAULT;
+    return 0;
+}
+
+int nand_init(NANDFlash *nand) {
+    return nand_init_store(nand, false);
+}
+
+int nand_init_shared(NANDFlash *nand) {
+    return nand_init_store(nand, true);
 }
 
-void nand_cleanup(NANDFlash *nand) {
+void nand_cleanup(NANDFlash *nand, const char *filename) {
     // 영속성을 위해 파일에 저장
-    nand_save_to_file(nand, "nand_flash.bin");
+    nand_save_to_file(nand, filename);
+}
+
+void nand_release(NANDFlash *nand) {
+    payload_destroy(nand->payload);
+    nand->payload = NULL;
+    if (nand->image_fd >= 0) {
+        close(nand->image_fd);
+        nand->image_fd = -1;
+    }
 }
 
 // ==================== PERSISTENCE ====================
 
+static off_t nand_image_data_offset(void) {
+    size_t header = 2 * sizeof(uint32_t) + sizeof(NANDFlash);
+    return (off_t)((header + NAND_IMAGE_ALIGN - 1) / NAND_IMAGE_ALIGN * NAND_IMAGE_ALIGN);
+}
+
+static off_t nand_image_page_offset(uint32_t pba) {
+    return nand_image_data_offset() + (off_t)pba * PAGE_SIZE;
+}
+
+// 저장된 OOB 중 payload가 있던 page만 새 저장소에 다시 채움
+static bool nand_load_payloads(NANDFlash *nand, int fd) {
+    for (uint32_t b = 0; b < TOTAL_BLOCKS; b++) {
+        for (uint32_t p = 0; p < PAGES_PER_BLOCK; p++) {
+            Page *page = &nand->blocks[b].pages[p];
+            bool has_payload = page->slot != PAYLOAD_NO_SLOT;
+            page->slot = PAYLOAD_NO_SLOT;
+            if (page->oob.state == PAGE_FREE || !has_payload) continue;
+            
+            page->slot = payload_alloc(nand->payload);
+            if (pread(fd, payload_ptr(nand->payload, page->slot), PAGE_SIZE,
+                      nand_image_page_offset(b * PAGES_PER_BLOCK + p)) != PAGE_SIZE) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 bool nand_load_from_file(NANDFlash *nand, const char *filename) {
-    FILE *fp = fopen(filename, "rb");
-    if (!fp) {
+    int fd = open(filename, O_RDWR);
+    if (fd < 0) {
+        return false;
+    }
+    
+    // 구조체 크기가 다른(이전 버전) 이미지는 새로 초기화
+    uint32_t header[2] = {0, 0};
+    if (pread(fd, header, sizeof(header), 0) != sizeof(header) ||
+        header[0] != NAND_IMAGE_MAGIC || header[1] != sizeof(NANDFlash) ||
+        pread(fd, nand, sizeof(NANDFlash), sizeof(header)) != sizeof(NANDFlash)) {
+        close(fd);
+        memset(nand, 0, sizeof(NANDFlash));
         return false;
     }
     
-    size_t read_bytes = fread(nand, sizeof(NANDFlash), 1, fp);
-    fclose(fp);
+    // 저장된 포인터 / fd는 의미가 없으므로 새로 만듦. 파일은 열어 둔 채로 다음 저장에서 바뀐 부분만 갱신
+    nand->image_fd = -1;
+    nand->payload = payload_create(TOTAL_PAGES, PAGE_SIZE, false);
+    bool ok = nand->payload != NULL && nand_load_payloads(nand, fd);
     
-    return (read_bytes == 1);
+    if (!ok) {
+        close(fd);
+        nand_release(nand);
+        memset(nand, 0, sizeof(NANDFlash));
+        return false;
+    }
+    nand->image_fd = fd;
+    memset(nand->image_dirty, 0, sizeof(nand->image_dirty));
+    memset(nand->image_erased, 0, sizeof(nand->image_erased));
+    return true;
 }
 
 void nand_save_to_file(NANDFlash *nand, const char *filename) {
-    FILE *fp = fopen(filename, "wb");
-    if (!fp) {
-        fprintf(stderr, "[NAND] Failed to save to %s\n", filename);
-        return;
+    // 처음 저장하는 파일은 비우고 전체 page를 바뀐 것으로 취급
+    if (nand->image_fd < 0) {
+        nand->image_fd = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (nand->image_fd < 0) {
+            fprintf(stderr, "[NAND] Failed to save to %s\n", filename);
+            return;
+        }
+        memset(nand->image_dirty, true, sizeof(nand->image_dirty));
+        memset(nand->image_erased, 0, sizeof(nand->image_erased));
+        if (ftruncate(nand->image_fd, nand_image_page_offset(TOTAL_PAGES)) != 0) {
+            fprintf(stderr, "[NAND] Failed to size %s\n", filename);
+        }
+    }
+    int fd = nand->image_fd;
+    
+    // 지난 저장 이후 erase된 블록은 hole로 반납 (다시 program된 page는 아래에서 새로 씀)
+    nand->image_blocks_punched = 0;
+    for (uint32_t b = 0; b < TOTAL_BLOCKS; b++) {
+        if (!nand->image_erased[b]) continue;
+        nand->image_erased[b] = false;
+        if (fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                      nand_image_page_offset(b * PAGES_PER_BLOCK), (off_t)PAGES_PER_BLOCK * PAGE_SIZE) == 0) {
+            nand->image_blocks_punched++;
+        }
+    }
+    
+    nand->image_pages_written = 0;
+    for (uint32_t pba = 0; pba < TOTAL_PAGES; pba++) {
+        const Page *page = &nand->blocks[pba / PAGES_PER_BLOCK].pages[pba % PAGES_PER_BLOCK];
+        if (!nand->image_dirty[pba]) continue;
+        nand->image_dirty[pba] = false;
+        if (page->oob.state == PAGE_FREE || page->slot == PAYLOAD_NO_SLOT) continue;
+        
+        if (pwrite(fd, payload_ptr(nand->payload, page->slot), PAGE_SIZE, nand_image_page_offset(pba)) != PAGE_SIZE) {
+            fprintf(stderr, "[NAND] Failed to write PBA %u to %s\n", pba, filename);
+        }
+        nand->image_pages_written++;
     }
     
-    fwrite(nand, sizeof(NANDFlash), 1, fp);
-    fclose(fp);
+    // OOB(전체 page 상태)는 page 내용을 모두 쓴 뒤 마지막에 갱신
+    nand->image_generation++;
+    uint32_t header[2] = { NAND_IMAGE_MAGIC, sizeof(NANDFlash) };
+    if (pwrite(fd, header, sizeof(header), 0) != sizeof(header) ||
+        pwrite(fd, nand, sizeof(NANDFlash), sizeof(header)) != sizeof(NANDFlash)) {
+        fprintf(stderr, "[NAND] Failed to write header to %s\n", filename);
+    }
 }
 
 // ==================== CORE NAND OPERATIONS ====================
 
+// lba까지 포함해서 다른 LBA의 page가 잘못 매핑된 경우도 검출
+static uint32_t nand_page_crc(const uint8_t *data, uint32_t lba) {
+    return crc32c(crc32c(0, data, PAGE_SIZE), &lba, sizeof(lba));
+}
+
+// metadata-only page는 보관 중인 4바이트 값으로 같은 검증을 함
+static uint32_t nand_value_crc(uint32_t value, uint32_t lba) {
+    return crc32c(crc32c(0, &value, sizeof(value)), &lba, sizeof(lba));
+}
+
+static uint64_t nand_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+// page 내용과 OOB의 CRC 비교 (CRC 없이 쓴 page나 검증 off면 통과)
+static int nand_verify_crc(NANDFlash *nand, uint32_t pba, const Page *page) {
+    if (!nand->crc_enabled || !page->oob.has_crc) {
+        return 0;
+    }
+    
+    uint64_t start_ns = nand_now_ns();
+    uint32_t crc = page->slot != PAYLOAD_NO_SLOT ? nand_page_crc(payload_ptr(nand->payload, page->slot), page->oob.lba)
+                                                 : nand_value_crc(page->value, page->oob.lba);
+    bool ok = crc == page->oob.crc;
+    __atomic_add_fetch(&nand->crc_ns, nand_now_ns() - start_ns, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&nand->crc_checks, 1, __ATOMIC_RELAXED);
+    if (!ok) {
+        __atomic_add_fetch(&nand->crc_errors, 1, __ATOMIC_RELAXED);
+        fprintf(stderr, "[NAND] CRC mismatch at PBA %u (LBA 0x%08X)\n", pba, page->oob.lba);
+        return NAND_ERR_CRC;
+    }
+    return 0;
+}
+
 int nand_write_page(NANDFlash *nand, uint32_t pba, const uint8_t *data, uint32_t lba) {
     if (pba >= TOTAL_PAGES) {
         fprintf(stderr, "[NAND] PBA %u out of range\n", pba);
@@ -81,8 +243,29 @@ int nand_write_page(NANDFlash *nand, uint32_t pba, const uint8_t *data, uint32_t
         return -1;
     }
     
-    // 데이터 쓰기
-    memcpy(page->data, data, PAGE_SIZE);
+    // 데이터 쓰기 (crash로 남은 slot이 있으면 재사용)
+    bool keep_payload = !nand->metadata_only || (lba & NAND_LBA_META_BIT);
+    memcpy(&page->value, data, sizeof(page->value));
+    if (!keep_payload) {
+        if (page->slot != PAYLOAD_NO_SLOT) {
+            payload_free(nand->payload, page->slot);
+            page->slot = PAYLOAD_NO_SLOT;
+        }
+    } else {
+        if (page->slot == PAYLOAD_NO_SLOT) {
+            page->slot = payload_alloc(nand->payload);
+            if (page->slot == PAYLOAD_NO_SLOT) {
+                fprintf(stderr, "[NAND] Payload store full at PBA %u\n", pba);
+                return -1;
+            }
+        }
+        memcpy(payload_ptr(nand->payload, page->slot), data, PAGE_SIZE);
+    }
+    
+    // 장애 주입: 데이터는 기록됐지만 OOB는 아직인 상태에서 전원 손실
+    if (nand->crash_at_write && nand->total_page_writes + 1 == nand->crash_at_write) {
+        raise(SIGKILL);
+    }
     
     // OOB 메타데이터 업데이트
     page->oob.state = PAGE_VALID;
@@ -90,9 +273,21 @@ int nand_write_page(NANDFlash *nand, uint32_t pba, const uint8_t *data, uint32_t
     //page->oob.write_count++;
     page->oob.write_count = nand->total_page_writes;
     
-    page->oob.timestamp = (uint32_t)time(NULL);
+    nand->vtime_us += NAND_T_XFER_US + nand_t_prog_us(nand, pba);
+    page->oob.timestamp = (uint32_t)(nand->vtime_us / 1000);
+    page->oob.has_crc = nand->crc_enabled;
+    if (!nand->crc_enabled) {
+        page->oob.crc = 0;
+    } else {
+        page->oob.crc = keep_payload ? nand_page_crc(data, lba) : nand_value_crc(page->value, lba);
+    }
     
+    nand->blocks[block_idx].valid_page_count++;
     nand->total_page_writes++;
+    nand->image_dirty[pba] = true;
+    if (!keep_payload) {
+        nand->total_meta_programs++;
+    }
     
     return 0;
 }
@@ -112,7 +307,44 @@ int nand_read_page(NANDFlash *nand, uint32_t pba, uint8_t *data) {
         return -1;
     }
     
-    memcpy(data, page->data, PAGE_SIZE);
+    if (page->slot != PAYLOAD_NO_SLOT) {
+        memcpy(data, payload_ptr(nand->payload, page->slot), PAGE_SIZE);
+    } else {
+        // metadata-only page: 저장한 값 뒤는 0 (호스트 쓰기와 같은 형태)
+        memcpy(data, &page->value, sizeof(page->value));
+        memset(data + sizeof(page->value), 0, PAGE_SIZE - sizeof(page->value));
+    }
+    
+    int ret = nand_verify_crc(nand, pba, page);
+    if (ret != 0) {
+        return ret;
+    }
+    // mount 스캔은 여러 스레드가 동시에 읽으므로 읽기 카운터와 가상 시각은 atomic (합이라 순서와 무관)
+    __atomic_add_fetch(&nand->total_page_reads, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&nand->vtime_us, nand_t_read_us(nand, pba) + NAND_T_XFER_US, __ATOMIC_RELAXED);
+    return 0;
+}
+
+int nand_read_oob(NANDFlash *nand, uint32_t pba, OOB *oob) {
+    if (pba >= TOTAL_PAGES) {
+        fprintf(stderr, "[NAND] PBA %u out of range\n", pba);
+        return -1;
+    }
+    
+    *oob = nand->blocks[pba / PAGES_PER_BLOCK].pages[pba % PAGES_PER_BLOCK].oob;
+    __atomic_add_fetch(&nand->total_oob_reads, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&nand->vtime_us, nand_t_read_us(nand, pba), __ATOMIC_RELAXED);
+    return 0;
+}
+
+// page 읽기 (spare 영역의 OOB도 같은 read로 함께 전달)
+int nand_read_page_oob(NANDFlash *nand, uint32_t pba, uint8_t *data, OOB *oob) {
+    int ret = nand_read_page(nand, pba, data);
+    if (ret != 0) {
+        return ret;
+    }
+    
+    *oob = nand->blocks[pba / PAGES_PER_BLOCK].pages[pba % PAGES_PER_BLOCK].oob;
     return 0;
 }
 
@@ -124,17 +356,134 @@ void nand_erase_block(NANDFlash *nand, uint32_t block_idx) {
     
     Block *block = &nand->blocks[block_idx];
     
-    // 모든 페이지를 FREE 상태로 초기화
+    // 모든 페이지를 FREE 상태로 초기화.
+    // eager: 내용을 0xFF로 지우고 slot은 붙여 둠 (다음 program이 재사용), lazy: 내용은 두고 slot만 반납
     for (uint32_t p = 0; p < PAGES_PER_BLOCK; p++) {
-        memset(&block->pages[p], 0xFF, sizeof(Page)); // 물리적 삭제 시뮬레이션
+        Page *page = &block->pages[p];
+        if (page->slot != PAYLOAD_NO_SLOT) {
+            if (nand->erase_mode == NAND_ERASE_EAGER) {
+                memset(payload_ptr(nand->payload, page->slot), 0xFF, PAGE_SIZE); // 물리적 삭제 시뮬레이션
+            } else {
+                payload_free(nand->payload, page->slot);
+                page->slot = PAYLOAD_NO_SLOT;
+            }
+        }
+        if (nand->erase_mode == NAND_ERASE_EAGER) {
+            memset(&page->oob, 0xFF, sizeof(OOB));
+        }
         block->pages[p].oob.state = PAGE_FREE;
         block->pages[p].oob.lba = 0xFFFFFFFF;
         block->pages[p].oob.write_count = 0;
+        block->pages[p].oob.timestamp = 0;
+        block->pages[p].oob.has_crc = false;
     }
     
+    memset(&nand->image_dirty[block_idx * PAGES_PER_BLOCK], 0, PAGES_PER_BLOCK * sizeof(bool));
+    nand->image_erased[block_idx] = true;
+    
     block->erase_count++;
     block->invalid_page_count = 0;
+    block->valid_page_count = 0;
     nand->total_block_erases++;
+    nand->vtime_us += NAND_T_BERS_US;
+}
+
+void nand_set_time(NANDFlash *nand, uint64_t now_us) {
+    if (now_us > nand->vtime_us) {
+        nand->vtime_us = now_us;
+    }
+}
+
+uint32_t nand_t_read_us(const NANDFlash *nand, uint32_t pba) {
+    return nand->blocks[pba / PAGES_PER_BLOCK].slc_mode ? NAND_T_READ_SLC_US : NAND_T_READ_US;
+}
+
+uint32_t nand_t_prog_us(const NANDFlash *nand, uint32_t pba) {
+    return nand->blocks[pba / PAGES_PER_BLOCK].slc_mode ? NAND_T_PROG_SLC_US : NAND_T_PROG_US;
+}
+
+bool nand_same_plane(uint32_t pba_a, uint32_t pba_b) {
+    return (pba_a / PAGES_PER_BLOCK) % NAND_PLANES == (pba_b / PAGES_PER_BLOCK) % NAND_PLANES;
+}
+
+int nand_copyback_page(NANDFlash *nand, uint32_t src_pba, uint32_t dst_pba) {
+    if (src_pba >= TOTAL_PAGES || dst_pba >= TOTAL_PAGES) {
+        fprintf(stderr, "[NAND] PBA %u / %u out of range\n", src_pba, dst_pba);
+        return -1;
+    }
+    if (!nand_same_plane(src_pba, dst_pba)) {
+        fprintf(stderr, "[NAND] Copyback across planes (PBA %u -> %u)\n", src_pba, dst_pba);
+        return -1;
+    }
+    
+    uint32_t block_idx = dst_pba / PAGES_PER_BLOCK;
+    Page *src = &nand->blocks[src_pba / PAGES_PER_BLOCK].pages[src_pba % PAGES_PER_BLOCK];
+    Page *dst = &nand->blocks[block_idx].pages[dst_pba % PAGES_PER_BLOCK];
+    
+    if (src->oob.state != PAGE_VALID || dst->oob.state != PAGE_FREE) {
+        fprintf(stderr, "[NAND] Copyback PBA %u -> %u: bad page state (%d -> %d)\n",
+                src_pba, dst_pba, src->oob.state, dst->oob.state);
+        return -1;
+    }
+    
+    // 손상된 page를 그대로 퍼뜨리지 않도록 제자리에서 CRC만 확인 (데이터 내용이 같으므로 재계산 없음)
+    int ret = nand_verify_crc(nand, src_pba, src);
+    if (ret != 0) {
+        return ret;
+    }
+    
+    // die 내부 page buffer 경유 (metadata-only page는 값만 옮김)
+    dst->value = src->value;
+    if (src->slot == PAYLOAD_NO_SLOT) {
+        if (dst->slot != PAYLOAD_NO_SLOT) {
+            payload_free(nand->payload, dst->slot);
+            dst->slot = PAYLOAD_NO_SLOT;
+        }
+    } else {
+        if (dst->slot == PAYLOAD_NO_SLOT) {
+            dst->slot = payload_alloc(nand->payload);
+            if (dst->slot == PAYLOAD_NO_SLOT) {
+                fprintf(stderr, "[NAND] Payload store full at PBA %u\n", dst_pba);
+                return -1;
+            }
+        }
+        memcpy(payload_ptr(nand->payload, dst->slot), payload_ptr(nand->payload, src->slot), PAGE_SIZE);
+    }
+    
+    if (nand->crash_at_write && nand->total_page_writes + 1 == nand->crash_at_write) {
+        raise(SIGKILL);
+    }
+    
+    dst->oob = src->oob;
+    dst->oob.state = PAGE_VALID;
+    dst->oob.write_count = nand->total_page_writes;
+    nand->vtime_us += nand_t_read_us(nand, src_pba) + nand_t_prog_us(nand, dst_pba);
+    dst->oob.timestamp = (uint32_t)(nand->vtime_us / 1000);
+    
+    nand->blocks[block_idx].valid_page_count++;
+    nand->total_page_writes++;
+    nand->total_copybacks++;
+    nand->image_dirty[dst_pba] = true;
+    if (dst->slot == PAYLOAD_NO_SLOT) {
+        nand->total_meta_programs++;
+    }
+    return 0;
+}
+
+int nand_corrupt_page(NANDFlash *nand, uint32_t pba) {
+    if (pba >= TOTAL_PAGES || nand_get_page_state(nand, pba) != PAGE_VALID) {
+        return -1;
+    }
+    
+    // packed page header를 피해서 데이터 쪽 비트를 뒤집음 (metadata-only page는 값의 최하위 비트)
+    Page *page = &nand->blocks[pba / PAGES_PER_BLOCK].pages[pba % PAGES_PER_BLOCK];
+    if (page->slot == PAYLOAD_NO_SLOT) {
+        page->value ^= 0x01;
+    } else {
+        payload_ptr(nand->payload, page->slot)[PAGE_SIZE - 1] ^= 0x01;
+    }
+    nand->image_dirty[pba] = true;
+    return 0;
 }
 
 // ==================== PAGE STATE MANAGEMENT ====================
@@ -161,12 +510,17 @@ void nand_set_page_state(NANDFlash *nand, uint32_t pba, PageState state) {
     PageState old_state = nand->blocks[block_idx].pages[page_idx].oob.state;
     nand->blocks[block_idx].pages[page_idx].oob.state = state;
     
-    // invalid page count 업데이트
+    // invalid / valid page count 업데이트
     if (old_state != PAGE_INVALID && state == PAGE_INVALID) {
         nand->blocks[block_idx].invalid_page_count++;
     } else if (old_state == PAGE_INVALID && state != PAGE_INVALID) {
         nand->blocks[block_idx].invalid_page_count--;
     }
+    if (old_state != PAGE_VALID && state == PAGE_VALID) {
+        nand->blocks[block_idx].valid_page_count++;
+    } else if (old_state == PAGE_VALID && state != PAGE_VALID) {
+        nand->blocks[block_idx].valid_page_count--;
+    }
 }
 
 // ==================== UTILITY FUNCTIONS ====================
@@ -211,9 +565,30 @@ void nand_print_statistics(NANDFlash *nand) {
     printf("\n========== NAND Flash Statistics ==========\n");
     printf("Total Page Writes:   %lu\n", nand->total_page_writes);
     printf("Total Block Erases:  %lu\n", nand->total_block_erases);
+    if (nand->payload) {
+        const PayloadStore *ps = nand->payload;
+        printf("Payload Store:       %u / %u pages live (peak %u), %u slabs = %.1f MB resident for %.1f MB simulated%s\n",
+               ps->used, ps->capacity, ps->peak, ps->slabs_resident, payload_resident_bytes(ps) / 1048576.0,
+               (double)TOTAL_PAGES * PAGE_SIZE / 1048576.0, ps->hugepage ? " (huge pages)" : "");
+        printf("Process RSS:         %.1f MB\n", payload_process_rss() / 1048576.0);
+    }
+    printf("Payload Mode:        %s, %lu programs without payload\n",
+           nand->metadata_only ? "metadata-only (4-byte value)" : "full", nand->total_meta_programs);
+    if (nand->image_fd >= 0) {
+        printf("Image File:          sparse, last save wrote %lu pages and punched %lu blocks\n",
+               nand->image_pages_written, nand->image_blocks_punched);
+    } else {
+        printf("Image File:          not saved yet\n");
+    }
+    printf("Erase Mode:          %s\n", nand->erase_mode == NAND_ERASE_LAZY ? "lazy (metadata only)" : "eager (memset)");
+    printf("Copyback Programs:   %lu (%s)\n", nand->total_copybacks, nand->copyback_enabled ? "on" : "off");
+    printf("Virtual Time:        %.3f s\n", nand->vtime_us / 1e6);
     printf("Free Pages:          %u / %d (%.1f%%)\n", 
            free_pages, TOTAL_PAGES, 100.0 * free_pages / TOTAL_PAGES);
     printf("Valid Pages:         %u\n", valid_pages);
     printf("Invalid Pages:       %u\n", invalid_pages);
+    printf("Page CRC32C:         %s (%s), %lu checks, %lu errors, %.1f ns/check\n",
+           nand->crc_enabled ? "on" : "off", crc32c_engine(), nand->crc_checks, nand->crc_errors,
+           nand->crc_checks ? (double)nand->crc_ns / nand->crc_checks : 0.0);
     printf("===========================================\n");
 }
@@ -10,6 +10,7 @@
 #ifndef NAND_FLASH_H
 #define NAND_FLASH_H
 
+#include "payload.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -17,9 +18,44 @@
 #define PAGE_SIZE           2048        // 2KB data per page
 #define OOB_SIZE            64          // Out-Of-Band metadata
 #define PAGES_PER_BLOCK     64
+#define NAND_PLANES         2           // block % NAND_PLANES = plane (copyback은 같은 plane 안에서만)
 #define TOTAL_BLOCKS        25
 #define TOTAL_PAGES         (TOTAL_BLOCKS * PAGES_PER_BLOCK)
 
+// ==================== TIMING MODEL ====================
+#define NAND_T_READ_US      50          // tR: page(또는 OOB) 1회 읽기 시간
+#define NAND_T_PROG_US      1500        // tPROG: TLC page program
+#define NAND_T_BERS_US      5000        // tBERS: block erase
+#define NAND_T_READ_SLC_US  25          // SLC 모드 tR
+#define NAND_T_PROG_SLC_US  200         // SLC 모드 tPROG
+#define NAND_T_XFER_US      10          // page 하나를 채널로 컨트롤러와 주고받는 시간 (2KB @ 200MB/s)
+
+// ==================== INTEGRITY ====================
+#define NAND_CRC_DEFAULT    1           // page별 CRC32C 기록 / 검증 (crc 명령어로 전환)
+#define NAND_ERR_CRC        (-2)        // nand_read_page: CRC 불일치
+#define NAND_COPYBACK_DEFAULT 1         // GC가 같은 plane 안의 이동에 copyback 사용
+
+// erase 방식: eager = block 전체를 0xFF로 memset (지운 page도 payload slot을 유지),
+// lazy = 메타데이터만 초기화하고 slot 반납. lazy에서 payload는 다음 program이 통째로 덮어쓰고,
+// FREE page는 읽을 수 없으므로 지운 것과 같다
+#define NAND_ERASE_EAGER    0
+#define NAND_ERASE_LAZY     1
+#define NAND_ERASE_MODE_DEFAULT NAND_ERASE_LAZY
+
+// metadata-only: 호스트 데이터 page는 payload 없이 OOB와 앞 4바이트 값만 보관 (WAF/GC/wear 실험용).
+// lba 최상위 비트가 켜진 FTL 메타데이터 page(tpage, journal, summary, packed)는 mount/복구에
+// 내용이 필요하므로 항상 payload를 유지한다. 빌드 시 -DNAND_METADATA_ONLY_DEFAULT=1로 기본값 변경
+#ifndef NAND_METADATA_ONLY_DEFAULT
+#define NAND_METADATA_ONLY_DEFAULT 0
+#endif
+#define NAND_LBA_META_BIT   0x80000000
+
+// 이미지 파일 (sparse): magic + NANDFlash 크기 + NANDFlash를 NAND_IMAGE_ALIGN까지 채운 뒤 PBA 위치 고정의 page 영역.
+// 저장 시 지난 저장 이후 program된 page만 쓰고 erase된 블록은 hole punch로 반납하므로
+// 파일의 실제 크기와 저장 I/O는 live 데이터에 비례. 지워진 page는 hole(또는 FREE OOB)로 표현
+#define NAND_IMAGE_MAGIC    0x4E414E53  // "NANS"
+#define NAND_IMAGE_ALIGN    4096        // 파일시스템 블록 (hole punch 단위)
+
 // ==================== DATA STRUCTURES ====================
 
 // Page 상태 (OOB 영역에 저장)
@@ -34,44 +70,88 @@ typedef struct {
     PageState state;
     uint32_t lba;           // 이 페이지가 매핑된 논리 주소
     uint32_t write_count;   // P/E cycle 카운터
-    uint32_t timestamp;     // 쓰기 시각
+    uint32_t timestamp;     // 쓰기 시각 (가상 시간 ms)
+    uint32_t crc;           // CRC32C(data + lba), metadata-only page는 CRC32C(value + lba)
+    bool has_crc;           // 검증 off 상태에서 쓴 page는 CRC 없음
 } OOB;
 
-// Physical Page 구조
+// Physical Page 구조 (payload는 program 시점에 PayloadStore slot으로 할당)
 typedef struct {
-    uint8_t data[PAGE_SIZE];
     OOB oob;
+    uint32_t slot;          // payload slot (PAYLOAD_NO_SLOT = 지워졌거나 metadata-only page)
+    uint32_t value;         // data 앞 4바이트 (metadata-only page는 이것만 보관)
 } Page;
 
 // Physical Block 구조
 typedef struct {
     Page pages[PAGES_PER_BLOCK];
-    uint32_t erase_count;           // Block-level P/E cycle
+    uint32_t erase_count;           // Block-level P/E cycle (lazy erase에서는 block generation 역할)
     uint32_t invalid_page_count;    // GC victim selection용
+    uint32_t valid_page_count;
+    bool slc_mode;                  // SLC 모드로 쓰는 블록 (FTL의 SLC 캐시): tR / tPROG가 SLC 값
 } Block;
 
 // NAND Flash 전체 구조
 typedef struct {
     Block blocks[TOTAL_BLOCKS];
     uint64_t total_page_writes;     // 통계
+    uint64_t total_page_reads;
+    uint64_t total_oob_reads;       // OOB만 읽은 횟수 (mount 스캔)
     uint64_t total_block_erases;
+    uint64_t crash_at_write;        // 장애 주입: N번째 program 도중 프로세스 종료 (0 = off)
+    PayloadStore *payload;          // page 데이터 (파일에는 따로 저장)
+    bool copyback_enabled;
+    uint8_t erase_mode;             // NAND_ERASE_EAGER | NAND_ERASE_LAZY
+    bool metadata_only;             // 호스트 데이터 page를 payload 없이 program
+    uint64_t total_meta_programs;   // payload 없이 program한 page
+
+    // sparse 이미지 파일 (열린 파일에 지난 저장 이후 바뀐 부분만 반영)
+    int image_fd;                   // -1 = 아직 저장/로드한 파일 없음
+    bool image_dirty[TOTAL_PAGES];  // 지난 저장 이후 program된 page
+    bool image_erased[TOTAL_BLOCKS];// 지난 저장 이후 erase된 블록 (저장 시 hole punch)
+    uint64_t image_pages_written;   // 마지막 저장에서 쓴 page
+    uint64_t image_blocks_punched;  // 마지막 저장에서 hole로 만든 블록
+    uint64_t image_generation;      // 저장할 때마다 +1 (이미지 옆 파일이 같은 저장 시점의 것인지 확인)
+    uint64_t total_copybacks;       // die 내부 복사로 처리한 program (total_page_writes에 포함)
+    uint64_t vtime_us;              // 가상 시각: 명령마다 모델 시간만큼 진행 (이벤트 엔진이 유휴 시간을 건너뜀)
+
+    // 데이터 무결성 (CRC32C)
+    bool crc_enabled;
+    uint64_t crc_checks;            // 읽기 검증 횟수
+    uint64_t crc_errors;            // 검출한 손상 page
+    uint64_t crc_ns;                // 검증에 쓴 시간 합계
 } NANDFlash;
 
 // ==================== FUNCTION PROTOTYPES ====================
 
 // 초기화 및 종료
-void nand_init(NANDFlash *nand);
-void nand_cleanup(NANDFlash *nand);
+int nand_init(NANDFlash *nand);             // payload 저장소를 만들 수 없으면 -1
+int nand_init_shared(NANDFlash *nand);      // payload를 fork한 프로세스와 공유 (crashtest)
+void nand_cleanup(NANDFlash *nand, const char *filename);
+void nand_release(NANDFlash *nand);         // payload 저장소 해제, 이미지 파일 닫기
 
 // 영속성 (파일 저장/로드)
 bool nand_load_from_file(NANDFlash *nand, const char *filename);
-void nand_save_to_file(NANDFlash *nand, const char *filename);
+void nand_save_to_file(NANDFlash *nand, const char *filename);   // sparse 이미지, 바뀐 부분만 기록
 
 // NAND 기본 연산 (하드웨어 제약 엄수)
 int nand_write_page(NANDFlash *nand, uint32_t pba, const uint8_t *data, uint32_t lba);
 int nand_read_page(NANDFlash *nand, uint32_t pba, uint8_t *data);
+int nand_read_oob(NANDFlash *nand, uint32_t pba, OOB *oob);
+int nand_read_page_oob(NANDFlash *nand, uint32_t pba, uint8_t *data, OOB *oob);
 void nand_erase_block(NANDFlash *nand, uint32_t block_idx);
 
+// copyback: die 안의 page buffer로 src를 읽어 dst에 바로 program (데이터가 채널/컨트롤러를 거치지 않음).
+// OOB(lba, CRC)는 그대로 옮기고 seq만 새로 부여. 같은 plane이 아니면 -1
+int nand_copyback_page(NANDFlash *nand, uint32_t src_pba, uint32_t dst_pba);
+void nand_set_time(NANDFlash *nand, uint64_t now_us);  // die가 now_us까지 유휴 (가상 시각은 되돌리지 않음)
+bool nand_same_plane(uint32_t pba_a, uint32_t pba_b);
+uint32_t nand_t_read_us(const NANDFlash *nand, uint32_t pba);   // 블록 모드에 따른 tR / tPROG
+uint32_t nand_t_prog_us(const NANDFlash *nand, uint32_t pba);
+
+// 장애 주입: page 데이터 1비트 반전 (OOB의 CRC는 그대로)
+int nand_corrupt_page(NANDFlash *nand, uint32_t pba);
+
 // Page 상태 관리
 PageState nand_get_page_state(NANDFlash *nand, uint32_t pba);
 void nand_set_page_state(NANDFlash *nand, uint32_t pba, PageState state);
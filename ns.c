@@ -0,0 +1,228 @@
+/*
+ * ns.c - Namespaces + Per-tenant QoS
+ */
+
+#include "ns.h"
+#include "ftl.h"
+#include <stdio.h>
+#include <string.h>
+
+// ==================== CONFIGURATION ====================
+
+void ns_init(NsTable *t) {
+    memset(t, 0, sizeof(NsTable));
+    memset(t->pool, NS_POOL_SHARED, sizeof(t->pool));
+    t->gc_pool = NS_POOL_SHARED;
+    t->writer = NS_NONE;
+}
+
+// summary 자리를 빼고 상위 watermark만큼 비워 둔 뒤 담을 수 있는 page 수
+static uint32_t ns_usable_pages(FTL *ftl, uint32_t blocks) {
+    uint32_t per_block = PAGES_PER_BLOCK - (ftl->summary_enabled ? 1 : 0);
+    return blocks * per_block * (100 - ftl->gc_high_watermark) / 100;
+}
+
+int ns_add(FTL *ftl, uint32_t pages, uint32_t pool_blocks) {
+    NsTable *t = &ftl->ns;
+    uint32_t base = 0, pool_end = 0, dedicated_pages = 0;
+
+    for (uint32_t i = 0; i < t->count; i++) {
+        base = t->ns[i].base + t->ns[i].pages;
+        if (t->ns[i].pool_blocks) {
+            pool_end = t->ns[i].pool_first + t->ns[i].pool_blocks;
+            dedicated_pages += t->ns[i].pages;
+        }
+    }
+    if (t->count == NS_MAX) {
+        printf("[NS] At most %d namespaces\n", NS_MAX);
+        return -1;
+    }
+    if (pages == 0 || base + pages > TOTAL_LOGICAL_PAGES) {
+        printf("[NS] Only %u LBAs left (namespaces take consecutive ranges)\n", TOTAL_LOGICAL_PAGES - base);
+        return -1;
+    }
+
+    if (pool_blocks) {
+        // 전용 pool은 data 영역 앞쪽부터 떼어 줌. journal / SLC는 data 영역 끝을 떼어 쓰고,
+        // translation page / packed page는 공유 pool에만 들어가므로 함께 쓰지 않음
+        if (ftl->journal.enabled || ftl->slc.blocks || ftl->map_mode == MAP_MODE_DFTL ||
+            ftl->pack.enabled || ftl->pack.unit) {
+            printf("[NS] Dedicated pools need journal, SLC cache, DFTL and compression/sub-page off\n");
+            return -1;
+        }
+        if (pool_end + pool_blocks + NS_MIN_SHARED_BLOCKS > ftl->data_blocks) {
+            printf("[NS] Only %u blocks can be dedicated (%d stay shared)\n",
+                   ftl->data_blocks - pool_end - NS_MIN_SHARED_BLOCKS, NS_MIN_SHARED_BLOCKS);
+            return -1;
+        }
+        if (ns_usable_pages(ftl, pool_blocks) < pages) {
+            printf("[NS] %u blocks hold only %u pages below the GC high watermark\n",
+                   pool_blocks, ns_usable_pages(ftl, pool_blocks));
+            return -1;
+        }
+        uint32_t shared_blocks = ftl->data_blocks - pool_end - pool_blocks;
+        uint32_t shared_lbas = TOTAL_LOGICAL_PAGES - dedicated_pages - pages;
+        if (ns_usable_pages(ftl, shared_blocks) < shared_lbas) {
+            printf("[NS] Shared pool would be too small for the remaining %u LBAs\n", shared_lbas);
+            return -1;
+        }
+    }
+
+    uint32_t idx = t->count++;
+    Namespace *n = &t->ns[idx];
+    memset(n, 0, sizeof(Namespace));
+    n->base = base;
+    n->pages = pages;
+    n->pool_first = pool_end;
+    n->pool_blocks = pool_blocks;
+    n->weight = NS_WEIGHT_DEFAULT;
+    for (uint32_t b = pool_end; b < pool_end + pool_blocks; b++) {
+        t->pool[b] = (uint8_t)idx;
+    }
+    return (int)idx;
+}
+
+void ns_clear(FTL *ftl) {
+    ns_init(&ftl->ns);
+}
+
+uint8_t ns_of_lba(const NsTable *t, uint32_t lba) {
+    for (uint32_t i = 0; i < t->count; i++) {
+        if (lba - t->ns[i].base < t->ns[i].pages) return (uint8_t)i;
+    }
+    return NS_NONE;
+}
+
+uint8_t ns_pool_of_lba(const NsTable *t, uint32_t lba) {
+    uint8_t n = ns_of_lba(t, lba);
+    return (n != NS_NONE && t->ns[n].pool_blocks) ? n : NS_POOL_SHARED;
+}
+
+uint32_t ns_pool_blocks(const NsTable *t, uint8_t pool, uint32_t data_blocks) {
+    uint32_t count = 0;
+
+    for (uint32_t b = 0; b < data_blocks; b++) {
+        if (t->pool[b] == pool) count++;
+    }
+    return count;
+}
+
+// ==================== ACCOUNTING ====================
+
+void ns_begin_write(FTL *ftl, uint32_t lba) {
+    ftl->ns.writer = ns_of_lba(&ftl->ns, lba);
+    ftl->ns.gc_pool = ns_pool_of_lba(&ftl->ns, lba);
+}
+
+void ns_end_write(FTL *ftl, bool ok, uint64_t gc_model_before, uint64_t host_model_before) {
+    NsTable *t = &ftl->ns;
+
+    if (ok && t->writer != NS_NONE) {
+        Namespace *n = &t->ns[t->writer];
+        // 스테이징만 된 쓰기는 program 없음, packed page를 내보낸 쓰기가 그 program을 떠안음
+        uint64_t us = (ftl->host_model_us - host_model_before) + (ftl->gc_model_us - gc_model_before);
+        n->host_writes++;
+        n->latency_us += us;
+        if (us > n->latency_max_us) n->latency_max_us = (uint32_t)us;
+    }
+    t->writer = NS_NONE;
+    t->gc_pool = NS_POOL_SHARED;
+}
+
+void ns_note_gc_move(FTL *ftl, uint32_t lba) {
+    NsTable *t = &ftl->ns;
+    uint8_t owner = ns_of_lba(t, lba);
+
+    if (owner != NS_NONE) {
+        t->ns[owner].gc_migrated++;
+        if (t->writer != NS_NONE && t->writer != owner) {
+            t->ns[owner].interference++;
+        }
+    }
+    if (t->writer != NS_NONE) {
+        t->ns[t->writer].gc_caused++;
+    }
+}
+
+// ==================== QOS ARBITER ====================
+
+void ns_set_qos(NsTable *t, uint32_t ns, uint32_t weight, uint32_t rate) {
+    Namespace *n = &t->ns[ns];
+
+    n->weight = weight ? weight : NS_WEIGHT_DEFAULT;
+    n->rate = rate;
+    n->burst = rate / 10 ? rate / 10 : 1;
+    n->tokens = n->burst;
+}
+
+static void ns_refill(Namespace *n, uint64_t now_us) {
+    if (n->rate && now_us > n->token_us) {
+        n->tokens += (double)(now_us - n->token_us) * n->rate / 1e6;
+        if (n->tokens > n->burst) n->tokens = n->burst;
+    }
+    n->token_us = now_us;
+}
+
+uint8_t ns_arbitrate(NsTable *t, const bool *ready, uint64_t now_us, uint64_t *next_us) {
+    uint8_t best = NS_NONE;
+    uint64_t earliest = UINT64_MAX;
+
+    for (uint32_t i = 0; i < t->count; i++) {
+        Namespace *n = &t->ns[i];
+        if (!ready[i]) continue;
+
+        ns_refill(n, now_us);
+        if (n->rate && n->tokens < 1.0) {
+            uint64_t wait = (uint64_t)((1.0 - n->tokens) * 1e6 / n->rate) + 1;
+            if (now_us + wait < earliest) earliest = now_us + wait;
+            continue;
+        }
+        if (best == NS_NONE || n->pass < t->ns[best].pass) {
+            best = (uint8_t)i;
+        }
+    }
+    if (best == NS_NONE && next_us) {
+        *next_us = earliest;
+    }
+    return best;
+}
+
+void ns_charge(NsTable *t, uint8_t ns) {
+    Namespace *n = &t->ns[ns];
+
+    n->pass += NS_STRIDE_BASE / n->weight;
+    if (n->rate) {
+        n->tokens -= 1.0;
+    }
+}
+
+// ==================== STATISTICS ====================
+
+void ns_print_statistics(FTL *ftl) {
+    NsTable *t = &ftl->ns;
+
+    printf("\n========== Namespaces ==========\n");
+    printf("%-3s %-12s %-10s %-12s %8s %8s %8s %8s %6s %9s %9s\n", "NS", "LBA range", "Pool", "QoS",
+           "writes", "GC moved", "GC caused", "interf", "WAF", "avg ms", "max ms");
+    for (uint32_t i = 0; i < t->count; i++) {
+        Namespace *n = &t->ns[i];
+        char range[24], pool[16], qos[24];
+        snprintf(range, sizeof(range), "%u-%u", n->base, n->base + n->pages - 1);
+        if (n->pool_blocks) {
+            snprintf(pool, sizeof(pool), "blk %u-%u", n->pool_first, n->pool_first + n->pool_blocks - 1);
+        } else {
+            snprintf(pool, sizeof(pool), "shared");
+        }
+        if (n->rate) {
+            snprintf(qos, sizeof(qos), "w%u %u/s", n->weight, n->rate);
+        } else {
+            snprintf(qos, sizeof(qos), "w%u", n->weight);
+        }
+        printf("%-3u %-12s %-10s %-12s %8lu %8lu %8lu %8lu %6.2f %9.2f %9.2f\n", i, range, pool, qos,
+               n->host_writes, n->gc_migrated, n->gc_caused, n->interference,
+               n->host_writes ? (double)(n->host_writes + n->gc_migrated) / n->host_writes : 0.0,
+               n->host_writes ? n->latency_us / 1000.0 / n->host_writes : 0.0, n->latency_max_us / 1000.0);
+    }
+    printf("Shared pool: %u blocks\n", ns_pool_blocks(t, NS_POOL_SHARED, ftl->data_blocks));
+    printf("================================\n");
+}
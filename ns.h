@@ -0,0 +1,91 @@
+/*
+ * ns.h - Namespaces + Per-tenant QoS
+ *
+ * 호스트 LBA 공간을 여러 namespace(tenant)로 나눈다.
+ * - namespace i는 전역 LBA [base, base + pages) 구간을 쓰고, L2P도 그 구간만 사용
+ *   (매핑 방식 / journal / DFTL은 그대로 공유)
+ * - pool_blocks > 0이면 data 영역 앞쪽 블록을 전용 pool로 받아 그 안에서만 할당하고,
+ *   GC도 해당 pool 안에서만 victim을 고른다. 나머지 블록은 공유 pool
+ * - GC가 옮긴 page를 주인 namespace에 귀속시키고, 다른 namespace의 쓰기가 일으킨
+ *   GC로 옮겨진 page는 interference로 따로 센다 (noisy neighbour)
+ * - QoS arbiter: 가중치(stride scheduling) + 선택적 token bucket으로 다음에 처리할
+ *   namespace를 고른다 (모델 시간 기준)
+ *
+ * 설정은 저장하지 않는다. 재시작 후에는 하나의 LBA 공간 / 공유 pool로 돌아간다.
+ */
+
+#ifndef NS_H
+#define NS_H
+
+#include "nand_flash.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// ==================== NAMESPACE CONFIGURATION ====================
+#define NS_MAX                  4
+#define NS_NONE                 0xFF        // namespace 밖의 LBA / 메타데이터
+#define NS_POOL_SHARED          0xFF        // 공유 pool 블록
+#define NS_MIN_SHARED_BLOCKS    4           // 전용 pool을 떼고 남길 공유 블록
+#define NS_WEIGHT_DEFAULT       1
+#define NS_STRIDE_BASE          1000000     // stride = NS_STRIDE_BASE / weight
+
+// ==================== DATA STRUCTURES ====================
+
+typedef struct {
+    uint32_t base;              // 전역 LBA 시작
+    uint32_t pages;             // LBA 수
+    uint32_t pool_first;        // 전용 pool 첫 블록
+    uint32_t pool_blocks;       // 0 = 공유 pool 사용
+
+    // QoS
+    uint32_t weight;            // 상대 가중치 (stride scheduling)
+    uint32_t rate;              // token bucket 초당 명령 수 (0 = 제한 없음)
+    uint32_t burst;             // bucket 크기
+    double tokens;
+    uint64_t token_us;          // 마지막으로 token을 채운 모델 시각
+    uint64_t pass;              // stride scheduling 진행값
+
+    // 통계
+    uint64_t host_writes;
+    uint64_t gc_migrated;       // GC가 옮긴 이 namespace의 page (WAF에 포함)
+    uint64_t gc_caused;         // 이 namespace의 쓰기가 일으킨 GC가 옮긴 page (주인 무관)
+    uint64_t interference;      // 다른 namespace 때문에 옮겨진 이 namespace의 page
+    uint64_t latency_us;        // 쓰기 모델 지연 합계 (program + 그 쓰기가 기다린 GC)
+    uint32_t latency_max_us;
+} Namespace;
+
+typedef struct {
+    uint32_t count;
+    Namespace ns[NS_MAX];
+    uint8_t pool[TOTAL_BLOCKS];     // 블록별 pool (namespace 번호 또는 NS_POOL_SHARED)
+    uint8_t gc_pool;                // 지금 GC / free page 계산이 보는 pool
+    uint8_t writer;                 // 지금 쓰기 중인 namespace (GC 귀속용)
+} NsTable;
+
+struct FTL;
+
+// ==================== FUNCTION PROTOTYPES ====================
+
+void ns_init(NsTable *t);
+// 다음 LBA 구간에 namespace 추가 (pool_blocks = 0이면 공유 pool), 번호 반환 / -1
+int ns_add(struct FTL *ftl, uint32_t pages, uint32_t pool_blocks);
+void ns_clear(struct FTL *ftl);
+
+uint8_t ns_of_lba(const NsTable *t, uint32_t lba);     // NS_NONE = namespace 밖
+uint8_t ns_pool_of_lba(const NsTable *t, uint32_t lba);
+uint32_t ns_pool_blocks(const NsTable *t, uint8_t pool, uint32_t data_blocks);
+
+// ftl_write 앞뒤: 쓰는 LBA의 pool로 GC 범위를 맞추고 지연 / GC 귀속 기록
+void ns_begin_write(struct FTL *ftl, uint32_t lba);
+void ns_end_write(struct FTL *ftl, bool ok, uint64_t gc_model_before, uint64_t host_model_before);
+void ns_note_gc_move(struct FTL *ftl, uint32_t lba);   // GC가 lba를 옮김
+
+// QoS arbiter: ready인 namespace 중 token이 있는 것 가운데 pass가 가장 작은 것.
+// token이 없어 고를 수 없으면 NS_NONE과 token이 생기는 시각(*next_us)
+void ns_set_qos(NsTable *t, uint32_t ns, uint32_t weight, uint32_t rate);
+uint8_t ns_arbitrate(NsTable *t, const bool *ready, uint64_t now_us, uint64_t *next_us);
+void ns_charge(NsTable *t, uint8_t ns);                 // 고른 namespace에 명령 하나 처리
+
+void ns_print_statistics(struct FTL *ftl);
+
+#endif // NS_H
@@ -0,0 +1,382 @@
+/*
+ * pack.c - Inline Compression + Sub-page Mapping (Page Packing)
+ */
+
+#include "pack.h"
+#include "ftl.h"
+#include "compress.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ==================== INITIALIZATION ====================
+
+int pack_init(Pack *p) {
+    memset(p, 0, sizeof(Pack));
+    p->enabled = PACK_DEFAULT;
+    p->unit = SUBPAGE_DEFAULT;
+    p->slot = malloc(TOTAL_LOGICAL_PAGES * sizeof(uint8_t));
+    p->valid = calloc(TOTAL_PAGES, sizeof(uint32_t));
+
+    if (!p->slot || !p->valid) {
+        pack_cleanup(p);
+        return -1;
+    }
+    memset(p->slot, PACK_NO_SLOT, TOTAL_LOGICAL_PAGES * sizeof(uint8_t));
+    return 0;
+}
+
+void pack_cleanup(Pack *p) {
+    free(p->slot);
+    free(p->valid);
+    p->slot = NULL;
+    p->valid = NULL;
+}
+
+int pack_set_unit(Pack *p, uint32_t unit) {
+    if (unit != 0 && (unit < SUBPAGE_MIN_UNIT || unit > SUBPAGE_MAX_UNIT || (unit & (unit - 1)) != 0)) {
+        fprintf(stderr, "[PACK] Sub-page unit must be 0 or a power of two in %d~%d bytes\n",
+                SUBPAGE_MIN_UNIT, SUBPAGE_MAX_UNIT);
+        return -1;
+    }
+    // 이미 기록된 slot은 header에 길이가 있으므로 단위를 바꿔도 그대로 읽힘
+    p->unit = unit;
+    return 0;
+}
+
+// ==================== PAGE FORMAT ====================
+
+bool pack_is_packed_page(NANDFlash *nand, uint32_t pba) {
+    if (pba >= TOTAL_PAGES) {
+        return false;
+    }
+    uint32_t tag = nand->blocks[pba / PAGES_PER_BLOCK].pages[pba % PAGES_PER_BLOCK].oob.lba;
+    return (tag & LBA_TAG_MASK) == LBA_TAG_PACK;
+}
+
+int pack_read_header(NANDFlash *nand, uint32_t pba, uint8_t *page, PackHeader *hdr) {
+    if (nand_read_page(nand, pba, page) != 0) {
+        return -1;
+    }
+
+    memcpy(hdr, page, sizeof(PackHeader));
+    if (hdr->magic != PACK_MAGIC || hdr->count == 0 || hdr->count > PACK_MAX_SLOTS) {
+        return -1;
+    }
+    for (uint32_t i = 0; i < hdr->count; i++) {
+        PackSlot *s = &hdr->slots[i];
+        uint32_t len = s->length & PACK_LEN_MASK;
+        if (s->lba >= TOTAL_LOGICAL_PAGES || len == 0 ||
+            s->offset < sizeof(PackHeader) || s->offset + len > PAGE_SIZE) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// slot 하나를 논리 페이지로 복원
+static int pack_decode(const uint8_t *src, uint16_t length, uint8_t *data) {
+    uint32_t len = length & PACK_LEN_MASK;
+
+    if (length & PACK_SLOT_RAW) {
+        memcpy(data, src, len);
+        memset(data + len, 0, PAGE_SIZE - len);
+        return 0;
+    }
+    return lz_decompress(src, len, data, PAGE_SIZE) == PAGE_SIZE ? 0 : -1;
+}
+
+// unit 뒤쪽이 모두 0인 작은 쓰기인지
+static bool pack_fits_unit(const uint8_t *data, uint32_t unit) {
+    for (uint32_t i = unit; i < PAGE_SIZE; i++) {
+        if (data[i] != 0) return false;
+    }
+    return true;
+}
+
+// ==================== STAGING ====================
+
+static int pack_find_staged(Pack *p, uint32_t lba) {
+    for (uint32_t i = 0; i < p->staged_count; i++) {
+        if (p->staged_lba[i] == lba) return (int)i;
+    }
+    return -1;
+}
+
+static void pack_stage(Pack *p, uint32_t lba, const uint8_t *buf, uint16_t len) {
+    uint32_t i = p->staged_count++;
+
+    p->staged_lba[i] = lba;
+    p->staged_off[i] = (uint16_t)p->staged_bytes;
+    p->staged_len[i] = len;
+    memcpy(p->staged + p->staged_bytes, buf, len & PACK_LEN_MASK);
+    p->staged_bytes += len & PACK_LEN_MASK;
+}
+
+static bool pack_fits(const Pack *p, uint16_t len) {
+    return p->staged_count < PACK_MAX_SLOTS && p->staged_bytes + (len & PACK_LEN_MASK) <= PACK_PAYLOAD_SIZE;
+}
+
+void pack_discard(FTL *ftl, uint32_t lba) {
+    Pack *p = &ftl->pack;
+    int i = pack_find_staged(p, lba);
+
+    if (i < 0) {
+        return;
+    }
+
+    // 뒤쪽 데이터를 당겨서 버퍼를 연속으로 유지
+    uint16_t off = p->staged_off[i], len = p->staged_len[i] & PACK_LEN_MASK;
+    memmove(p->staged + off, p->staged + off + len, p->staged_bytes - off - len);
+    p->staged_bytes -= len;
+
+    for (uint32_t j = (uint32_t)i; j + 1 < p->staged_count; j++) {
+        p->staged_lba[j] = p->staged_lba[j + 1];
+        p->staged_off[j] = p->staged_off[j + 1] - len;
+        p->staged_len[j] = p->staged_len[j + 1];
+    }
+    p->staged_count--;
+}
+
+int pack_flush(FTL *ftl) {
+    Pack *p = &ftl->pack;
+    uint8_t page[PAGE_SIZE];
+    PackHeader hdr;
+
+    if (p->staged_count == 0) {
+        return 0;
+    }
+
+    uint32_t pba = ftl_alloc_host_page(ftl, p->staged_lba[0]);
+    if (pba == 0xFFFFFFFF) {
+        fprintf(stderr, "[PACK] No free page for packed page\n");
+        return -1;
+    }
+
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic = PACK_MAGIC;
+    hdr.count = p->staged_count;
+    for (uint32_t i = 0; i < p->staged_count; i++) {
+        hdr.slots[i].lba = p->staged_lba[i];
+        hdr.slots[i].offset = (uint16_t)(sizeof(PackHeader) + p->staged_off[i]);
+        hdr.slots[i].length = p->staged_len[i];
+    }
+    memset(page, 0xFF, PAGE_SIZE);
+    memcpy(page, &hdr, sizeof(hdr));
+    memcpy(page + sizeof(PackHeader), p->staged, p->staged_bytes);
+
+    // slot 매핑이 모두 같은 journal page에 들어가야 mount 때 빠짐없이 roll-forward 됨
+    journal_reserve(ftl, hdr.count);
+    if (ftl_program_page(ftl, pba, page, LBA_TAG_PACK | p->staged_count) != 0) {
+        fprintf(stderr, "[PACK] Failed to program packed page at PBA %u\n", pba);
+        return -1;
+    }
+    // 스테이징된 쓰기들은 여기서 한 번에 NAND 시간을 씀
+    ftl_charge_program(ftl, pba);
+
+    // ftl_write와 같은 순서: 새 page 기록 후 이전 위치 무효화 + 매핑 갱신
+    for (uint32_t i = 0; i < hdr.count; i++) {
+        uint32_t lba = hdr.slots[i].lba;
+
+        ftl_invalidate_old_page(ftl, lba);
+        ftl_l2p_update(ftl, lba, pba);
+        p->slot[lba] = (uint8_t)i;
+        p->valid[pba] |= 1u << i;
+    }
+
+    p->packed_pages++;
+    p->packed_slots += hdr.count;
+    p->staged_count = 0;
+    p->staged_bytes = 0;
+    return 0;
+}
+
+// ==================== I/O ====================
+
+int pack_write(FTL *ftl, uint32_t lba, const uint8_t *data) {
+    Pack *p = &ftl->pack;
+    uint8_t buf[PACK_MAX_COMPRESSED];
+    const uint8_t *src = buf;
+    int len = -1;
+    uint16_t slot_len;
+
+    p->host_pages++;
+
+    // 스테이징된 이전 사본은 어느 쪽이든 폐기
+    pack_discard(ftl, lba);
+
+    if (p->enabled) {
+        len = lz_compress(data, PAGE_SIZE, buf, sizeof(buf));
+    }
+    // 압축보다 서브 페이지 slot이 작으면 앞 unit 바이트만 그대로 저장
+    if (p->unit && (len < 0 || (uint32_t)len > p->unit) && pack_fits_unit(data, p->unit)) {
+        src = data;
+        slot_len = (uint16_t)(p->unit | PACK_SLOT_RAW);
+        p->subpage_pages++;
+    } else if (len >= 0) {
+        slot_len = (uint16_t)len;
+        p->compressed_pages++;
+        p->compressed_bytes += (uint32_t)len;
+    } else {
+        p->raw_pages++;
+        return 1;
+    }
+
+    if (!pack_fits(p, slot_len) && pack_flush(ftl) != 0) {
+        return -1;
+    }
+    pack_stage(p, lba, src, slot_len);
+    return 0;
+}
+
+int pack_read(FTL *ftl, uint32_t lba, uint8_t *data) {
+    Pack *p = &ftl->pack;
+    uint8_t page[PAGE_SIZE];
+    PackHeader hdr;
+
+    int i = pack_find_staged(p, lba);
+    if (i >= 0) {
+        return pack_decode(p->staged + p->staged_off[i], p->staged_len[i], data);
+    }
+    if (p->slot[lba] == PACK_NO_SLOT) {
+        return 1;
+    }
+
+    // header의 slot 항목으로 page 안 위치 확인
+    uint32_t pba = ftl_l2p_lookup(ftl, lba);
+    if (pba == 0xFFFFFFFF || pack_read_header(&ftl->nand, pba, page, &hdr) != 0 ||
+        p->slot[lba] >= hdr.count || hdr.slots[p->slot[lba]].lba != lba) {
+        fprintf(stderr, "[PACK] Bad packed page for LBA %u at PBA %u\n", lba, pba);
+        return -1;
+    }
+    PackSlot *s = &hdr.slots[p->slot[lba]];
+    if (pack_decode(page + s->offset, s->length, data) != 0) {
+        fprintf(stderr, "[PACK] Corrupted slot for LBA %u at PBA %u\n", lba, pba);
+        return -1;
+    }
+    return 0;
+}
+
+// ==================== INVALIDATION / GC ====================
+
+void pack_release(FTL *ftl, uint32_t pba, uint32_t lba) {
+    Pack *p = &ftl->pack;
+
+    uint32_t bit = 1u << p->slot[lba];
+
+    p->slot[lba] = PACK_NO_SLOT;
+    if ((p->valid[pba] & bit) == 0) {
+        return;
+    }
+    p->valid[pba] &= ~bit;
+    if (p->valid[pba] == 0) {
+        nand_set_page_state(&ftl->nand, pba, PAGE_INVALID);
+    }
+}
+
+double pack_live_fraction(FTL *ftl, uint32_t pba) {
+    if (!pack_is_packed_page(&ftl->nand, pba)) {
+        return 1.0;
+    }
+    // OOB 태그 하위 비트 = page에 담긴 slot 수
+    uint32_t count = ftl->nand.blocks[pba / PAGES_PER_BLOCK].pages[pba % PAGES_PER_BLOCK].oob.lba & ~LBA_TAG_MASK;
+    return count ? (double)__builtin_popcount(ftl->pack.valid[pba]) / count : 0.0;
+}
+
+void pack_migrate(FTL *ftl, uint32_t pba) {
+    Pack *p = &ftl->pack;
+    uint8_t page[PAGE_SIZE];
+    PackHeader hdr;
+
+    if (pack_read_header(&ftl->nand, pba, page, &hdr) != 0) {
+        fprintf(stderr, "[GC] Failed to read packed page at PBA %u\n", pba);
+        return;
+    }
+
+    for (uint32_t i = 0; i < hdr.count; i++) {
+        PackSlot *s = &hdr.slots[i];
+
+        // 이미 덮어쓴 slot, 더 새 사본이 스테이징된 slot은 버림
+        if (ftl_l2p_lookup(ftl, s->lba) != pba || p->slot[s->lba] != i ||
+            pack_find_staged(p, s->lba) >= 0) {
+            continue;
+        }
+        if (!pack_fits(p, s->length) && pack_flush(ftl) != 0) {
+            return;
+        }
+        // 압축 상태 그대로 옮김 (재압축 없음)
+        pack_stage(p, s->lba, page + s->offset, s->length);
+        p->gc_repacked++;
+    }
+}
+
+// ==================== MOUNT ====================
+
+void pack_rebuild(FTL *ftl) {
+    Pack *p = &ftl->pack;
+    uint8_t page[PAGE_SIZE];
+    PackHeader hdr;
+    uint32_t packed = 0, dropped = 0;
+
+    memset(p->slot, PACK_NO_SLOT, TOTAL_LOGICAL_PAGES * sizeof(uint8_t));
+    memset(p->valid, 0, TOTAL_PAGES * sizeof(uint32_t));
+
+    // packed page마다 header 한 번 읽고, 매핑이 가리키는 slot만 valid
+    for (uint32_t pba = 0; pba < ftl->data_blocks * PAGES_PER_BLOCK; pba++) {
+        if (nand_get_page_state(&ftl->nand, pba) != PAGE_VALID || !pack_is_packed_page(&ftl->nand, pba)) {
+            continue;
+        }
+
+        if (pack_read_header(&ftl->nand, pba, page, &hdr) == 0) {
+            for (uint32_t i = 0; i < hdr.count; i++) {
+                uint32_t lba = hdr.slots[i].lba;
+                uint32_t cur = (ftl->map_mode == MAP_MODE_DFTL) ? dftl_peek(ftl, lba) : ftl_l2p_lookup(ftl, lba);
+                if (cur != pba) continue;
+                p->slot[lba] = (uint8_t)i;
+                p->valid[pba] |= 1u << i;
+            }
+        }
+
+        if (p->valid[pba] == 0) {
+            nand_set_page_state(&ftl->nand, pba, PAGE_INVALID);
+            dropped++;
+        } else {
+            packed++;
+        }
+    }
+
+    if (packed || dropped) {
+        printf("[PACK] Rebuilt %u packed pages (%u fully stale)\n", packed, dropped);
+    }
+}
+
+// ==================== STATISTICS ====================
+
+size_t pack_memory_bytes(const Pack *p) {
+    (void)p;
+    return (size_t)TOTAL_LOGICAL_PAGES * sizeof(uint8_t) + TOTAL_PAGES * sizeof(uint32_t);
+}
+
+void pack_print_statistics(FTL *ftl) {
+    Pack *p = &ftl->pack;
+    uint64_t stored = p->compressed_pages + p->subpage_pages;
+
+    printf("Page Packing:        compress %s, sub-page unit %u B (%lu host pages, %lu stored raw)\n",
+           p->enabled ? "on" : "off", p->unit, p->host_pages, p->raw_pages);
+    printf("  Compressed:        %lu pages, ratio %.2f:1 (%lu -> %lu bytes)\n", p->compressed_pages,
+           p->compressed_bytes ? (double)p->compressed_pages * PAGE_SIZE / p->compressed_bytes : 1.0,
+           p->compressed_pages * PAGE_SIZE, p->compressed_bytes);
+    printf("  Sub-page:          %lu pages (%u slots/page at this unit)\n", p->subpage_pages,
+           p->unit ? (uint32_t)(PACK_PAYLOAD_SIZE / p->unit < PACK_MAX_SLOTS ? PACK_PAYLOAD_SIZE / p->unit : PACK_MAX_SLOTS) : 0);
+    printf("  Packed Pages:      %lu (%.1f slots/page, %lu GC repacked, %u staged)\n",
+           p->packed_pages, p->packed_pages ? (double)p->packed_slots / p->packed_pages : 0.0,
+           p->gc_repacked, p->staged_count);
+
+    // packing 없이는 slot에 담긴 호스트 쓰기 / GC 이동이 각각 program 한 번
+    uint64_t saved = stored + p->gc_repacked - p->packed_pages;
+    printf("  Programs Saved:    %lu (WAF %.2fx, without packing %.2fx)\n", saved,
+           ftl_calculate_waf(ftl),
+           ftl->total_host_writes ? (double)(ftl->nand.total_page_writes + saved) / ftl->total_host_writes : 1.0);
+    printf("  Sector Mapping:    %zu bytes (slot per LBA, valid bitmap per PBA)\n",
+           pack_memory_bytes(p));
+}
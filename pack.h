@@ -0,0 +1,117 @@
+/*
+ * pack.h - Inline Compression + Sub-page Mapping (Page Packing)
+ *
+ * 논리 페이지 여러 장을 물리 페이지 한 장(packed page)의 slot에 모아서 program 한다.
+ * slot에 들어가는 방식은 두 가지:
+ * - 압축: 내장 LZ 코덱으로 압축한 페이지 (compress on)
+ * - 서브 페이지: 앞 unit 바이트만 그대로 (나머지가 0인 작은 쓰기, subpage <unit>)
+ *
+ * packed page 구조: [PackHeader (slot별 lba/offset/length)] [slot 데이터...]
+ * OOB lba = LBA_TAG_PACK | slot 수. page 자체가 내용을 설명하므로
+ * mount 스캔은 header를 읽어 slot마다 매핑 후보로 등록한다.
+ *
+ * 매핑 엔트리 = L2P의 PBA + 이 모듈의 slot 번호 (sector 단위 L2P).
+ * PBA마다 slot valid bitmap을 두고, bitmap이 비면 page가 INVALID가 된다.
+ * GC victim 선택은 bitmap으로 packed page 안의 무효 slot까지 회수량에 반영한다.
+ *
+ * 압축된 페이지는 스테이징 버퍼에 모였다가 버퍼가 차거나 sync / GC 때
+ * 한 번에 program 된다 (그 전까지는 쓰기 캐시처럼 전원 손실 시 유실).
+ */
+
+#ifndef PACK_H
+#define PACK_H
+
+#include "nand_flash.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ==================== PACK CONFIGURATION ====================
+#define PACK_DEFAULT            0                       // 기본 off (compress 명령어로 전환)
+#define PACK_MAGIC              0x4B434150              // "PACK"
+#define PACK_MAX_SLOTS          32                      // packed page 하나에 담는 최대 논리 페이지 수
+#define PACK_PAYLOAD_SIZE       (PAGE_SIZE - sizeof(PackHeader))
+#define PACK_MAX_COMPRESSED     (PACK_PAYLOAD_SIZE / 2) // 이보다 크면 압축 이득이 없다고 보고 그대로 기록
+#define PACK_NO_SLOT            0xFF                    // 일반 페이지에 매핑된 LBA
+#define PACK_SLOT_RAW           0x8000                  // length 상위 bit: 압축 없이 앞부분만 저장 (나머지는 0)
+#define PACK_LEN_MASK           0x7FFF
+#define SUBPAGE_DEFAULT         0                       // 기본 off (subpage 명령어로 전환)
+#define SUBPAGE_MIN_UNIT        64                      // 서브 페이지 매핑 단위 범위 (2의 거듭제곱)
+#define SUBPAGE_MAX_UNIT        (PAGE_SIZE / 2)
+
+// ==================== DATA STRUCTURES ====================
+
+typedef struct {
+    uint32_t lba;
+    uint16_t offset;        // page 시작 기준
+    uint16_t length;        // 저장 길이 (| PACK_SLOT_RAW)
+} PackSlot;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t count;
+    PackSlot slots[PACK_MAX_SLOTS];
+} PackHeader;
+
+typedef struct {
+    bool enabled;                       // 새 호스트 쓰기를 압축할지 (기존 packed page는 항상 읽힘)
+    uint32_t unit;                      // 서브 페이지 매핑 단위 (바이트, 0 = off)
+
+    // sector 단위 매핑 (L2P가 packed page를 가리키는 LBA만 slot 번호를 가짐)
+    uint8_t  *slot;                     // LBA -> packed page 안 slot 번호 (PACK_NO_SLOT = 일반 페이지)
+    uint32_t *valid;                    // PBA -> slot valid bitmap
+
+    // 스테이징 버퍼 (다음 packed page의 내용)
+    uint32_t staged_count;
+    uint32_t staged_bytes;
+    uint32_t staged_lba[PACK_MAX_SLOTS];
+    uint16_t staged_off[PACK_MAX_SLOTS];    // staged[] 안 위치
+    uint16_t staged_len[PACK_MAX_SLOTS];    // | PACK_SLOT_RAW
+    uint8_t  staged[PACK_PAYLOAD_SIZE];
+
+    // 통계
+    uint64_t host_pages;                // 이 모듈을 거친 호스트 쓰기
+    uint64_t raw_pages;                 // slot에 못 넣어 일반 페이지로 기록
+    uint64_t compressed_pages;          // 압축 slot으로 저장
+    uint64_t compressed_bytes;          // 압축 결과 합계
+    uint64_t subpage_pages;             // 서브 페이지 slot으로 저장
+    uint64_t packed_pages;              // program 한 packed page
+    uint64_t packed_slots;              // packed page에 담긴 slot 합계
+    uint64_t gc_repacked;               // GC가 압축 상태 그대로 다시 담은 slot
+} Pack;
+
+struct FTL;
+
+// ==================== FUNCTION PROTOTYPES ====================
+
+int pack_init(Pack *p);
+void pack_cleanup(Pack *p);
+int pack_set_unit(Pack *p, uint32_t unit);   // 0 또는 SUBPAGE_MIN_UNIT~SUBPAGE_MAX_UNIT의 2의 거듭제곱
+
+// OOB 태그로 packed page 여부 판단
+bool pack_is_packed_page(NANDFlash *nand, uint32_t pba);
+// packed page 읽기 + header 검증
+int pack_read_header(NANDFlash *nand, uint32_t pba, uint8_t *page, PackHeader *hdr);
+
+// 0 = 스테이징됨, 1 = slot에 넣을 수 없음 (호출자가 일반 페이지로 기록), -1 = 실패
+int pack_write(struct FTL *ftl, uint32_t lba, const uint8_t *data);
+// 0 = 스테이징/packed page에서 읽음, 1 = packed 아님, -1 = 실패
+int pack_read(struct FTL *ftl, uint32_t lba, uint8_t *data);
+// 스테이징된 사본 폐기 (trim / 일반 페이지로 덮어쓰기)
+void pack_discard(struct FTL *ftl, uint32_t lba);
+// 스테이징 버퍼를 packed page 한 장으로 program
+int pack_flush(struct FTL *ftl);
+
+// packed page 안 slot 하나 무효화 (마지막 slot이면 page INVALID)
+void pack_release(struct FTL *ftl, uint32_t pba, uint32_t lba);
+// packed page에서 살아 있는 slot 비율 (일반 페이지는 1.0)
+double pack_live_fraction(struct FTL *ftl, uint32_t pba);
+// GC: 살아 있는 slot을 압축 상태 그대로 스테이징
+void pack_migrate(struct FTL *ftl, uint32_t pba);
+// mount: 복구된 매핑 기준으로 slot 번호 / valid bitmap 재구성
+void pack_rebuild(struct FTL *ftl);
+
+size_t pack_memory_bytes(const Pack *p);
+void pack_print_statistics(struct FTL *ftl);
+
+#endif // PACK_H
@@ -0,0 +1,129 @@
+/*
+ * payload.c - On-demand Page Payload Store
+ */
+
+#define _GNU_SOURCE
+#include "payload.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+static size_t payload_align(size_t n, size_t a) {
+    return (n + a - 1) / a * a;
+}
+
+// ==================== LIFECYCLE ====================
+
+PayloadStore *payload_create(uint32_t capacity, uint32_t slot_size, bool shared) {
+    uint32_t slab_slots = PAYLOAD_SLAB_SIZE / slot_size;
+    uint32_t slabs = (capacity + slab_slots - 1) / slab_slots;
+
+    // [관리 정보 | free list 링크 | slab 카운터] 뒤에 slab 정렬된 payload 영역
+    size_t meta = sizeof(PayloadStore) + (size_t)capacity * sizeof(uint32_t) +
+                  (size_t)slabs * (sizeof(uint32_t) + sizeof(uint8_t));
+    size_t meta_bytes = payload_align(meta, PAYLOAD_SLAB_SIZE);
+    size_t map_bytes = meta_bytes + (size_t)slabs * PAYLOAD_SLAB_SIZE + PAYLOAD_SLAB_SIZE;
+
+    uint8_t *map = mmap(NULL, map_bytes, PROT_READ | PROT_WRITE,
+                        (shared ? MAP_SHARED : MAP_PRIVATE) | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "[PAYLOAD] Failed to reserve %zu bytes\n", map_bytes);
+        return NULL;
+    }
+
+    PayloadStore *s = (PayloadStore *)map;
+    s->capacity = capacity;
+    s->slot_size = slot_size;
+    s->slab_slots = slab_slots;
+    s->slabs = slabs;
+    s->shared = shared;
+    s->free_head = PAYLOAD_NO_SLOT;
+    s->map_bytes = map_bytes;
+    s->next = (uint32_t *)(map + sizeof(PayloadStore));
+    s->slab_live = s->next + capacity;
+    s->slab_resident = (uint8_t *)(s->slab_live + slabs);
+
+    // mmap은 4KB 정렬만 보장하므로 payload 시작을 huge page 경계로 맞춤
+    s->base = (uint8_t *)payload_align((uintptr_t)(map + meta_bytes), PAYLOAD_SLAB_SIZE);
+#ifdef MADV_HUGEPAGE
+    // shmem의 THP는 시스템 설정을 따르므로 private 매핑에만 요청
+    s->hugepage = !shared && madvise(s->base, (size_t)slabs * PAYLOAD_SLAB_SIZE, MADV_HUGEPAGE) == 0;
+#endif
+    return s;
+}
+
+void payload_destroy(PayloadStore *store) {
+    if (store) {
+        munmap(store, store->map_bytes);
+    }
+}
+
+// ==================== ALLOCATION ====================
+
+uint32_t payload_alloc(PayloadStore *s) {
+    uint32_t slot;
+
+    if (s->free_head != PAYLOAD_NO_SLOT) {
+        slot = s->free_head;
+        s->free_head = s->next[slot];
+    } else if (s->next_unused < s->capacity) {
+        slot = s->next_unused++;
+    } else {
+        return PAYLOAD_NO_SLOT;
+    }
+
+    uint32_t slab = slot / s->slab_slots;
+    if (!s->slab_resident[slab]) {
+        s->slab_resident[slab] = 1;
+        s->slabs_resident++;
+    } else if (s->slab_live[slab] == 0) {
+        s->slabs_empty--;
+    }
+    s->slab_live[slab]++;
+    if (++s->used > s->peak) {
+        s->peak = s->used;
+    }
+    return slot;
+}
+
+void payload_free(PayloadStore *s, uint32_t slot) {
+    if (slot >= s->capacity) {
+        return;
+    }
+
+    s->next[slot] = s->free_head;
+    s->free_head = slot;
+    s->used--;
+
+    // 빈 slab이 spare 수를 넘으면 물리 메모리 반납 (다시 쓰면 0으로 채워진 page를 새로 받음)
+    uint32_t slab = slot / s->slab_slots;
+    if (--s->slab_live[slab] == 0 && ++s->slabs_empty > PAYLOAD_SPARE_SLABS) {
+        madvise(s->base + (size_t)slab * PAYLOAD_SLAB_SIZE, PAYLOAD_SLAB_SIZE,
+                s->shared ? MADV_REMOVE : MADV_DONTNEED);
+        s->slab_resident[slab] = 0;
+        s->slabs_resident--;
+        s->slabs_empty--;
+        s->slab_releases++;
+    }
+}
+
+// ==================== STATISTICS ====================
+
+size_t payload_resident_bytes(const PayloadStore *s) {
+    return (size_t)s->slabs_resident * PAYLOAD_SLAB_SIZE;
+}
+
+size_t payload_process_rss(void) {
+    unsigned long size, resident;
+    FILE *fp = fopen("/proc/self/statm", "r");
+
+    if (!fp) {
+        return 0;
+    }
+    if (fscanf(fp, "%lu %lu", &size, &resident) != 2) {
+        resident = 0;
+    }
+    fclose(fp);
+    return (size_t)resident * (size_t)sysconf(_SC_PAGESIZE);
+}
@@ -0,0 +1,60 @@
+/*
+ * payload.h - On-demand Page Payload Store
+ *
+ * NAND page 데이터를 program 시점에만 slot으로 할당하는 arena.
+ * - 전체 용량만큼 가상 주소만 예약 (MAP_NORESERVE)하고, 물리 메모리는 slot에 처음 쓸 때 할당
+ * - 2MB slab 단위로 나누고 transparent huge page를 요청 (private 매핑일 때)
+ * - erase로 해제된 slot은 free list로 재사용, slab의 slot이 모두 해제되면 물리 메모리 반납
+ *
+ * 관리 정보도 같은 매핑 안에 두므로 shared로 만들면 fork한 프로세스와 그대로 공유된다 (crashtest).
+ */
+
+#ifndef PAYLOAD_H
+#define PAYLOAD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define PAYLOAD_NO_SLOT         0xFFFFFFFF
+#define PAYLOAD_SLAB_SIZE       (2u << 20)      // huge page 하나
+#define PAYLOAD_SPARE_SLABS     1               // 바로 반납하지 않고 남겨 둘 빈 slab 수 (fault 반복 방지)
+
+typedef struct {
+    uint32_t capacity;          // 최대 slot 수
+    uint32_t slot_size;
+    uint32_t slab_slots;        // slab당 slot 수
+    uint32_t slabs;
+    bool shared;
+    bool hugepage;              // MADV_HUGEPAGE 적용 여부
+
+    uint32_t free_head;         // 해제된 slot 목록 (LIFO)
+    uint32_t next_unused;       // 아직 한 번도 쓰지 않은 첫 slot
+    uint32_t used;
+    uint32_t peak;
+    uint32_t slabs_resident;    // 물리 메모리를 받은 slab 수
+    uint32_t slabs_empty;       // 그중 slot이 모두 해제된 slab
+    uint64_t slab_releases;
+
+    size_t map_bytes;
+    uint8_t *base;              // payload 영역 (slab 정렬)
+    uint32_t *next;             // free list 링크 (slot별)
+    uint32_t *slab_live;        // slab별 사용 중 slot 수
+    uint8_t *slab_resident;
+} PayloadStore;
+
+// capacity개 slot 예약 (shared = fork 후에도 공유)
+PayloadStore *payload_create(uint32_t capacity, uint32_t slot_size, bool shared);
+void payload_destroy(PayloadStore *store);
+
+uint32_t payload_alloc(PayloadStore *store);                // PAYLOAD_NO_SLOT = 가득 참
+void payload_free(PayloadStore *store, uint32_t slot);
+
+static inline uint8_t *payload_ptr(const PayloadStore *store, uint32_t slot) {
+    return store->base + (size_t)slot * store->slot_size;
+}
+
+size_t payload_resident_bytes(const PayloadStore *store);  // 물리 메모리를 받은 slab 합계
+size_t payload_process_rss(void);                           // /proc/self/statm 기준 RSS
+
+#endif // PAYLOAD_H
@@ -0,0 +1,262 @@
+/*
+ * scan.c - Parallel Mount Scan
+ */
+
+#include "scan.h"
+#include "ftl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+typedef struct {
+    struct FTL *ftl;
+    uint32_t first_block;
+    uint32_t end_block;
+    bool use_summary;
+    
+    // 부분 매핑 (구간 안에서의 최신 사본)
+    uint32_t map[TOTAL_LOGICAL_PAGES];
+    uint32_t map_seq[TOTAL_LOGICAL_PAGES];
+    uint32_t tpage_pba[TPAGE_COUNT];
+    uint32_t tpage_seq[TPAGE_COUNT];
+    bool has_tpages;
+    
+    // 구간 안에서 밀린 사본 + meta page
+    uint32_t *stale;
+    uint32_t stale_count;
+    uint32_t summaries;
+    
+    // 블록별 카운터 (공유 배열, 구간이 겹치지 않으므로 lock 불필요)
+    uint32_t *valid_counts;
+    uint32_t *invalid_counts;
+} ScanWorker;
+
+// ==================== WORKER ====================
+
+// 밀린 사본 기록. packed page는 다른 slot이 살아 있을 수 있으므로 제외 (mount 후 pack_rebuild가 정리)
+static void scan_push_stale(ScanWorker *w, uint32_t pba) {
+    if (!pack_is_packed_page(&w->ftl->nand, pba)) {
+        w->stale[w->stale_count++] = pba;
+    }
+}
+
+static void scan_packed_page(ScanWorker *w, uint32_t pba, uint32_t write_count);
+
+static void scan_candidate(ScanWorker *w, uint32_t pba, uint32_t lba, uint32_t write_count) {
+    uint32_t *slot, *seq;
+    
+    if ((lba & LBA_TAG_MASK) == LBA_TAG_PACK) {
+        scan_packed_page(w, pba, write_count);
+        return;
+    }
+    if (lba < TOTAL_LOGICAL_PAGES) {
+        slot = &w->map[lba];
+        seq = &w->map_seq[lba];
+    } else if ((lba & LBA_TAG_MASK) == LBA_TAG_TPAGE && (lba & ~LBA_TAG_MASK) < TPAGE_COUNT) {
+        slot = &w->tpage_pba[lba & ~LBA_TAG_MASK];
+        seq = &w->tpage_seq[lba & ~LBA_TAG_MASK];
+        w->has_tpages = true;
+    } else {
+        // journal 없이 mount하는 경우 남은 meta page는 회수 대상
+        if ((lba & LBA_TAG_MASK) == LBA_TAG_META) {
+            w->stale[w->stale_count++] = pba;
+        }
+        return;
+    }
+    
+    // 같은 LBA(tvpn)가 여러 페이지에 VALID로 남아 있으면 (쓰기 도중 전원 손실)
+    // write_count(기록 순서)가 큰 쪽이 최신
+    if (*slot != 0xFFFFFFFF && write_count < *seq) {
+        scan_push_stale(w, pba);
+        return;
+    }
+    if (*slot != 0xFFFFFFFF) {
+        scan_push_stale(w, *slot);
+    }
+    *slot = pba;
+    *seq = write_count;
+}
+
+// packed page는 header를 읽어서 slot마다 같은 seq로 후보 등록
+static void scan_packed_page(ScanWorker *w, uint32_t pba, uint32_t write_count) {
+    uint8_t page[PAGE_SIZE];
+    PackHeader hdr;
+    
+    if (pack_read_header(&w->ftl->nand, pba, page, &hdr) != 0) {
+        return;
+    }
+    for (uint32_t i = 0; i < hdr.count; i++) {
+        scan_candidate(w, pba, hdr.slots[i].lba, write_count);
+    }
+}
+
+static void *scan_worker(void *arg) {
+    ScanWorker *w = arg;
+    NANDFlash *nand = &w->ftl->nand;
+    BlockSummary sum;
+    
+    for (uint32_t b = w->first_block; b < w->end_block; b++) {
+        uint32_t base = b * PAGES_PER_BLOCK;
+        uint32_t valid = 0, invalid = 0;
+        
+        // page 상태(validity bitmap)로 블록 카운터 재구성
+        for (uint32_t p = 0; p < PAGES_PER_BLOCK; p++) {
+            PageState state = nand_get_page_state(nand, base + p);
+            if (state == PAGE_VALID) valid++;
+            else if (state == PAGE_INVALID) invalid++;
+        }
+        w->valid_counts[b] = valid;
+        w->invalid_counts[b] = invalid;
+        
+        if (w->use_summary && summary_read(nand, b, &sum) == 0) {
+            for (uint32_t p = 0; p < SUMMARY_PAGE; p++) {
+                if (nand_get_page_state(nand, base + p) != PAGE_VALID) continue;
+                scan_candidate(w, base + p, sum.entries[p].lba, sum.entries[p].seq);
+            }
+            w->summaries++;
+            continue;
+        }
+        
+        for (uint32_t p = 0; p < PAGES_PER_BLOCK; p++) {
+            OOB oob;
+            if (nand_read_oob(nand, base + p, &oob) != 0 || oob.state != PAGE_VALID) {
+                continue;
+            }
+            scan_candidate(w, base + p, oob.lba, oob.write_count);
+        }
+    }
+    return NULL;
+}
+
+// ==================== MERGE ====================
+
+// 부분 매핑 하나를 병합. 진 쪽 PBA는 stale 목록에 추가 (packed page 제외)
+static void scan_merge_slot(NANDFlash *nand, uint32_t *slot, uint32_t *seq, uint32_t pba, uint32_t pba_seq,
+                            uint32_t *stale, uint32_t *stale_count) {
+    uint32_t loser;
+    
+    if (pba == 0xFFFFFFFF) {
+        return;
+    }
+    if (*slot == 0xFFFFFFFF || pba_seq > *seq) {
+        loser = *slot;
+        *slot = pba;
+        *seq = pba_seq;
+    } else {
+        loser = pba;
+    }
+    if (loser != 0xFFFFFFFF && !pack_is_packed_page(nand, loser)) {
+        stale[(*stale_count)++] = loser;
+    }
+}
+
+uint32_t scan_default_threads(void) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    
+    if (cores < 1) return 1;
+    if (cores > SCAN_THREADS_MAX) return SCAN_THREADS_MAX;
+    return (uint32_t)cores;
+}
+
+int scan_mapping(FTL *ftl, uint32_t *map, uint32_t *tpage_pba, uint32_t threads,
+                 bool fix_states, bool use_summary, ScanResult *result) {
+    uint32_t valid_counts[TOTAL_BLOCKS], invalid_counts[TOTAL_BLOCKS];
+    uint32_t map_seq[TOTAL_LOGICAL_PAGES], tpage_seq[TPAGE_COUNT];
+    
+    if (threads == 0) threads = scan_default_threads();
+    if (threads > TOTAL_BLOCKS) threads = TOTAL_BLOCKS;
+    if (threads > SCAN_THREADS_MAX) threads = SCAN_THREADS_MAX;
+    
+    ScanWorker *workers = calloc(threads, sizeof(ScanWorker));
+    uint32_t *stale = malloc(TOTAL_PAGES * sizeof(uint32_t) * 2);
+    uint32_t stale_count = 0;
+    if (!workers || !stale) {
+        free(workers);
+        free(stale);
+        return -1;
+    }
+    
+    // 블록 구간 분할 (threads <= TOTAL_BLOCKS이므로 구간마다 블록이 하나 이상).
+    // 구간의 밀린 사본 목록은 스레드를 띄우기 전에 모두 할당해서, 실패하면 아무것도 바꾸지 않고 -1
+    for (uint32_t t = 0; t < threads; t++) {
+        ScanWorker *w = &workers[t];
+        w->ftl = ftl;
+        w->first_block = (uint32_t)((uint64_t)TOTAL_BLOCKS * t / threads);
+        w->end_block = (uint32_t)((uint64_t)TOTAL_BLOCKS * (t + 1) / threads);
+        w->use_summary = use_summary;
+        w->valid_counts = valid_counts;
+        w->invalid_counts = invalid_counts;
+        memset(w->map, 0xFF, sizeof(w->map));
+        memset(w->tpage_pba, 0xFF, sizeof(w->tpage_pba));
+        w->stale = calloc((size_t)(w->end_block - w->first_block) * PAGES_PER_BLOCK, sizeof(uint32_t));
+        if (!w->stale) {
+            for (uint32_t i = 0; i < t; i++) {
+                free(workers[i].stale);
+            }
+            free(workers);
+            free(stale);
+            return -1;
+        }
+    }
+    
+    // 첫 구간은 호출한 스레드가 직접 처리
+    pthread_t tids[SCAN_THREADS_MAX];
+    uint32_t started = 0;
+    for (uint32_t t = 1; t < threads; t++) {
+        if (pthread_create(&tids[t], NULL, scan_worker, &workers[t]) != 0) {
+            break;
+        }
+        started = t;
+    }
+    scan_worker(&workers[0]);
+    for (uint32_t t = 1; t <= started; t++) {
+        pthread_join(tids[t], NULL);
+    }
+    // 스레드 생성에 실패한 구간은 직접 처리
+    for (uint32_t t = started + 1; t < threads; t++) {
+        scan_worker(&workers[t]);
+    }
+    
+    // 병합: seq가 가장 큰 사본이 최신
+    memset(map, 0xFF, TOTAL_LOGICAL_PAGES * sizeof(uint32_t));
+    memset(tpage_pba, 0xFF, TPAGE_COUNT * sizeof(uint32_t));
+    memset(result, 0, sizeof(ScanResult));
+    result->threads = threads;
+    
+    for (uint32_t t = 0; t < threads; t++) {
+        ScanWorker *w = &workers[t];
+        
+        for (uint32_t lba = 0; lba < TOTAL_LOGICAL_PAGES; lba++) {
+            scan_merge_slot(&ftl->nand, &map[lba], &map_seq[lba], w->map[lba], w->map_seq[lba],
+                            stale, &stale_count);
+        }
+        for (uint32_t tv = 0; tv < TPAGE_COUNT; tv++) {
+            scan_merge_slot(&ftl->nand, &tpage_pba[tv], &tpage_seq[tv], w->tpage_pba[tv], w->tpage_seq[tv],
+                            stale, &stale_count);
+        }
+        memcpy(stale + stale_count, w->stale, w->stale_count * sizeof(uint32_t));
+        stale_count += w->stale_count;
+        
+        result->has_tpages |= w->has_tpages;
+        result->summaries += w->summaries;
+        free(w->stale);
+    }
+    result->stale_pages = stale_count;
+    
+    // 블록 카운터를 스캔 결과로 교체한 뒤 밀린 사본 정리 (카운터도 함께 갱신됨)
+    if (fix_states) {
+        for (uint32_t b = 0; b < TOTAL_BLOCKS; b++) {
+            ftl->nand.blocks[b].valid_page_count = valid_counts[b];
+            ftl->nand.blocks[b].invalid_page_count = invalid_counts[b];
+        }
+        for (uint32_t i = 0; i < stale_count; i++) {
+            nand_set_page_state(&ftl->nand, stale[i], PAGE_INVALID);
+        }
+    }
+    
+    free(stale);
+    free(workers);
+    return 0;
+}
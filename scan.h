@@ -0,0 +1,40 @@
+/*
+ * scan.h - Parallel Mount Scan
+ *
+ * mount 시 OOB(또는 block summary) 스캔을 블록 구간 단위로 나눠 여러 스레드가
+ * 동시에 수행한다. 각 worker는 자기 구간의 LBA -> (PBA, seq) 부분 매핑과
+ * 블록별 valid/invalid 카운트를 만들고, 끝나면 seq가 가장 큰 쪽으로 병합한다.
+ * NAND 상태 변경(밀린 사본 invalidate)은 병합 후 한 스레드에서만 한다.
+ */
+
+#ifndef SCAN_H
+#define SCAN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ==================== SCAN CONFIGURATION ====================
+#define SCAN_THREADS_DEFAULT    0       // 0 = 온라인 코어 수
+#define SCAN_THREADS_MAX        64
+
+// ==================== DATA STRUCTURES ====================
+
+typedef struct {
+    bool has_tpages;                // DFTL translation page 발견
+    uint32_t summaries;             // summary로 대신한 블록 수
+    uint32_t threads;               // 실제 사용한 worker 수
+    uint32_t stale_pages;           // 중복 사본 / meta page (fix_states면 INVALID 처리)
+} ScanResult;
+
+struct FTL;
+
+// ==================== FUNCTION PROTOTYPES ====================
+
+// map: LBA -> PBA, tpage_pba: tvpn -> PBA (TPAGE_COUNT개).
+// fix_states면 밀린 사본을 INVALID로 만들고 블록별 valid/invalid 카운터를 재구성
+int scan_mapping(struct FTL *ftl, uint32_t *map, uint32_t *tpage_pba, uint32_t threads,
+                 bool fix_states, bool use_summary, ScanResult *result);
+
+uint32_t scan_default_threads(void);
+
+#endif // SCAN_H
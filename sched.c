@@ -0,0 +1,154 @@
+/*
+ * sched.c - I/O Scheduler (timing model)
+ */
+
+#include "sched.h"
+#include <stdio.h>
+#include <string.h>
+
+// ==================== INTERNAL HELPERS ====================
+
+void sched_init(IoSched *s, SchedMode mode) {
+    memset(s, 0, sizeof(IoSched));
+    s->enabled = true;
+    s->mode = mode;
+}
+
+const char *sched_mode_name(SchedMode mode) {
+    switch (mode) {
+        case SCHED_FIFO:          return "fifo";
+        case SCHED_READ_PRIORITY: return "read-priority";
+        case SCHED_SUSPEND:       return "suspend";
+    }
+    return "?";
+}
+
+void sched_set_time(IoSched *s, uint64_t now_us) {
+    s->arrival_us = now_us;
+}
+
+static void sched_pop(IoSched *s, uint64_t done_us) {
+    SchedOp *op = &s->queue[s->head];
+
+    if (op->host) {
+        uint32_t us = (uint32_t)(done_us - op->submit_us);
+        s->writes++;
+        s->write_total_us += us;
+        if (us > s->write_max_us) s->write_max_us = us;
+    }
+    s->bg_ops++;
+    s->head = (s->head + 1) % SCHED_QUEUE_MAX;
+    s->count--;
+    s->head_started = false;
+    s->reads_in_row = 0;
+}
+
+// head 명령을 끝까지 진행
+static void sched_finish_head(IoSched *s) {
+    SchedOp *op = &s->queue[s->head];
+
+    if (s->clock_us < op->submit_us) s->clock_us = op->submit_us;
+    s->clock_us += op->remaining_us;
+    sched_pop(s, s->clock_us);
+}
+
+// die가 비어 있는 [clock, until) 동안 background 명령 진행
+static void sched_run_until(IoSched *s, uint64_t until) {
+    while (s->count && s->clock_us < until) {
+        SchedOp *op = &s->queue[s->head];
+        if (s->clock_us < op->submit_us) s->clock_us = op->submit_us;
+        if (s->clock_us >= until) break;
+
+        uint64_t left = until - s->clock_us;
+        if (op->remaining_us <= left) {
+            s->clock_us += op->remaining_us;
+            sched_pop(s, s->clock_us);
+        } else {
+            op->remaining_us -= (uint32_t)left;
+            s->clock_us = until;
+            s->head_started = true;
+        }
+    }
+    if (s->clock_us < until) s->clock_us = until;
+}
+
+// ==================== PUBLIC API ====================
+
+void sched_submit(IoSched *s, SchedOpType type, uint32_t duration_us, bool host) {
+    if (!s->enabled) {
+        return;
+    }
+    // 도착 전까지의 background 진행을 먼저 반영해야 head가 다른 명령으로 바뀌지 않음
+    sched_run_until(s, s->arrival_us);
+    if (s->count == SCHED_QUEUE_MAX) {
+        sched_finish_head(s);
+    }
+
+    SchedOp *op = &s->queue[(s->head + s->count) % SCHED_QUEUE_MAX];
+    op->type = (uint8_t)type;
+    op->suspends = 0;
+    op->host = host;
+    op->remaining_us = duration_us;
+    op->submit_us = s->arrival_us;
+    s->count++;
+}
+
+void sched_host_read(IoSched *s, uint32_t duration_us) {
+    if (!s->enabled) {
+        return;
+    }
+    sched_run_until(s, s->arrival_us);
+
+    if (s->mode == SCHED_FIFO) {
+        // 도착 전에 쌓인 명령을 모두 처리한 뒤
+        while (s->count) {
+            sched_finish_head(s);
+        }
+    } else {
+        // 연속 read가 한도를 넘으면 background 하나를 먼저 (GC가 굶지 않도록)
+        if (s->count && s->reads_in_row >= SCHED_READ_BURST_MAX) {
+            sched_finish_head(s);
+            s->forced_bg++;
+        }
+        if (s->count && s->head_started) {
+            SchedOp *op = &s->queue[s->head];
+            bool can_suspend = s->mode == SCHED_SUSPEND && op->type != SCHED_OP_READ;
+
+            if (can_suspend && op->suspends < SCHED_MAX_SUSPENDS) {
+                op->suspends++;
+                op->remaining_us += SCHED_T_RESUME_US;
+                s->clock_us += SCHED_T_SUSPEND_US;
+                s->suspends++;
+            } else {
+                if (can_suspend) s->suspend_denied++;
+                sched_finish_head(s);
+            }
+        }
+    }
+
+    s->clock_us += duration_us;
+    s->reads_in_row++;
+    s->last_read_us = (uint32_t)(s->clock_us - s->arrival_us);
+    s->reads++;
+    s->read_total_us += s->last_read_us;
+    if (s->last_read_us > s->read_max_us) s->read_max_us = s->last_read_us;
+}
+
+void sched_drain(IoSched *s) {
+    while (s->count) {
+        sched_finish_head(s);
+    }
+}
+
+// ==================== STATISTICS ====================
+
+void sched_print_statistics(const IoSched *s) {
+    printf("I/O Scheduler:       %s (%u queued, %lu background ops)\n", sched_mode_name(s->mode),
+           s->count, s->bg_ops);
+    printf("  Host reads:        %lu (avg %.0f us, max %u us)\n", s->reads,
+           s->reads ? (double)s->read_total_us / s->reads : 0.0, s->read_max_us);
+    printf("  Host writes:       %lu (avg %.0f us, max %u us)\n", s->writes,
+           s->writes ? (double)s->write_total_us / s->writes : 0.0, s->write_max_us);
+    printf("  Suspends:          %lu (%lu denied by limit), forced background: %lu\n",
+           s->suspends, s->suspend_denied, s->forced_bg);
+}
@@ -0,0 +1,89 @@
+/*
+ * sched.h - I/O Scheduler (timing model)
+ *
+ * FTL과 NAND 사이에서 명령이 die를 쓰는 순서와 시각을 모델 시간으로 계산한다.
+ * FTL 동작(매핑, GC로 옮기는 데이터)은 그대로 동기식이고, 시간만 스케줄러가 정한다.
+ * - GC 이동(read / program)과 erase, 호스트 program은 background 큐에 순서대로 쌓이고
+ *   die가 비는 시간에 진행 (호스트 쓰기는 자기가 일으킨 GC 뒤에 끝남)
+ * - 호스트 read는 큐를 건너뛰고 (read priority), 진행 중인 program / erase는
+ *   suspend하고 먼저 처리 (program/erase suspend)
+ * - 공정성: read가 연속 SCHED_READ_BURST_MAX개 앞지르면 background 명령 하나를 먼저,
+ *   명령 하나는 최대 SCHED_MAX_SUSPENDS번까지만 suspend (그 뒤 read는 완료를 기다림)
+ *
+ * 호출자가 sched_set_time()으로 명령 도착 시각을 알려 준다 (기본 꺼짐).
+ */
+
+#ifndef SCHED_H
+#define SCHED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ==================== SCHEDULER CONFIGURATION ====================
+#define SCHED_QUEUE_MAX         2048        // background 큐 (가득 차면 head를 끝까지 진행)
+#define SCHED_READ_BURST_MAX    8           // background를 앞질러 연속으로 처리할 read 수
+#define SCHED_MAX_SUSPENDS      4           // 명령 하나가 suspend될 수 있는 횟수
+#define SCHED_T_SUSPEND_US      20          // program / erase suspend 진입 시간
+#define SCHED_T_RESUME_US       20          // resume 후 다시 진행하는 데 드는 추가 시간
+
+// ==================== DATA STRUCTURES ====================
+
+typedef enum {
+    SCHED_FIFO = 0,             // 도착 순서대로 (read도 쌓인 GC 뒤에서 기다림)
+    SCHED_READ_PRIORITY,        // read가 큐를 앞지름 (진행 중인 명령은 끝날 때까지 기다림)
+    SCHED_SUSPEND               // read priority + program / erase suspend
+} SchedMode;
+
+typedef enum {
+    SCHED_OP_READ = 0,
+    SCHED_OP_PROG,
+    SCHED_OP_ERASE
+} SchedOpType;
+
+typedef struct {
+    uint8_t type;               // SchedOpType
+    uint8_t suspends;
+    bool host;                  // 호스트 쓰기의 program (완료 시 쓰기 지연 기록)
+    uint32_t remaining_us;
+    uint64_t submit_us;
+} SchedOp;
+
+typedef struct {
+    bool enabled;
+    SchedMode mode;
+    uint64_t arrival_us;        // 지금 들어오는 호스트 명령의 도착 시각
+    uint64_t clock_us;          // die 일정이 정해진 시각
+    SchedOp queue[SCHED_QUEUE_MAX];
+    uint32_t head;
+    uint32_t count;
+    bool head_started;          // head 명령이 일부 진행됨 (suspend 대상)
+    uint32_t reads_in_row;      // background를 앞지른 연속 read 수
+
+    // 통계
+    uint64_t reads;
+    uint64_t read_total_us;
+    uint32_t read_max_us;
+    uint32_t last_read_us;      // 마지막 read 지연 (벤치마크 분포용)
+    uint64_t writes;
+    uint64_t write_total_us;
+    uint32_t write_max_us;
+    uint64_t bg_ops;
+    uint64_t suspends;
+    uint64_t suspend_denied;    // suspend 한도 때문에 read가 기다린 횟수
+    uint64_t forced_bg;         // read burst 한도 때문에 먼저 처리한 background 명령
+} IoSched;
+
+// ==================== FUNCTION PROTOTYPES ====================
+
+void sched_init(IoSched *s, SchedMode mode);
+const char *sched_mode_name(SchedMode mode);
+void sched_set_time(IoSched *s, uint64_t now_us);      // 다음 호스트 명령 도착 시각
+
+// FTL이 NAND 명령을 낼 때 (꺼져 있으면 아무것도 하지 않음)
+void sched_submit(IoSched *s, SchedOpType type, uint32_t duration_us, bool host);
+void sched_host_read(IoSched *s, uint32_t duration_us);   // 지연은 last_read_us
+void sched_drain(IoSched *s);                             // 남은 background 명령 모두 진행
+
+void sched_print_statistics(const IoSched *s);
+
+#endif // SCHED_H
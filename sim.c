@@ -0,0 +1,72 @@
+/*
+ * sim.c - Discrete-Event Simulation Core
+ */
+
+#include "sim.h"
+#include <stdio.h>
+#include <string.h>
+
+// ==================== EVENT QUEUE ====================
+
+void sim_init(SimEngine *sim, uint64_t seed) {
+    memset(sim, 0, sizeof(SimEngine));
+    sim->rng = seed;
+}
+
+static bool sim_before(const SimEvent *a, const SimEvent *b) {
+    return a->time_us < b->time_us || (a->time_us == b->time_us && a->seq < b->seq);
+}
+
+int sim_schedule(SimEngine *sim, uint64_t time_us, SimEventType type, uint32_t arg) {
+    if (sim->count == SIM_QUEUE_MAX) {
+        fprintf(stderr, "[SIM] Event queue full\n");
+        return -1;
+    }
+    // 과거 시각으로 등록하면 지금 처리
+    SimEvent ev = { time_us < sim->now_us ? sim->now_us : time_us, sim->next_seq++, (uint8_t)type, arg };
+    uint32_t i = sim->count++;
+
+    while (i > 0 && sim_before(&ev, &sim->heap[(i - 1) / 2])) {
+        sim->heap[i] = sim->heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    sim->heap[i] = ev;
+    return 0;
+}
+
+bool sim_next(SimEngine *sim, SimEvent *ev) {
+    if (sim->count == 0) {
+        return false;
+    }
+    *ev = sim->heap[0];
+
+    SimEvent last = sim->heap[--sim->count];
+    uint32_t i = 0;
+    while (2 * i + 1 < sim->count) {
+        uint32_t child = 2 * i + 1;
+        if (child + 1 < sim->count && sim_before(&sim->heap[child + 1], &sim->heap[child])) {
+            child++;
+        }
+        if (!sim_before(&sim->heap[child], &last)) break;
+        sim->heap[i] = sim->heap[child];
+        i = child;
+    }
+    sim->heap[i] = last;
+
+    sim->now_us = ev->time_us;
+    sim->events++;
+    return true;
+}
+
+// ==================== RANDOM ====================
+
+uint32_t sim_rand_next(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return (uint32_t)((z ^ (z >> 31)) >> 32);
+}
+
+uint32_t sim_rand(SimEngine *sim) {
+    return sim_rand_next(&sim->rng);
+}
@@ -0,0 +1,52 @@
+/*
+ * sim.h - Discrete-Event Simulation Core
+ *
+ * 가상 시각 순서로 이벤트(호스트 요청 도착, NAND 명령 완료, background 작업)를 꺼내는
+ * 이벤트 큐. 같은 시각의 이벤트는 등록 순서대로 처리하고, 난수도 엔진의 seed에서만
+ * 만들므로 같은 seed면 결과가 비트 단위로 같다.
+ * 시간은 실제로 기다리지 않고 다음 이벤트 시각으로 바로 건너뛴다.
+ */
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ==================== SIMULATION CONFIGURATION ====================
+#define SIM_QUEUE_MAX       1024        // 동시에 대기할 수 있는 이벤트 수
+#define SIM_SEED_DEFAULT    42
+
+// ==================== DATA STRUCTURES ====================
+
+typedef enum {
+    SIM_EV_HOST_ARRIVAL = 0,    // 호스트 요청 도착
+    SIM_EV_NAND_DONE,           // device가 명령을 끝냄
+    SIM_EV_BACKGROUND           // 유휴 시간 작업 (GC 등)
+} SimEventType;
+
+typedef struct {
+    uint64_t time_us;
+    uint64_t seq;               // 같은 시각이면 먼저 등록한 이벤트부터
+    uint8_t type;               // SimEventType
+    uint32_t arg;
+} SimEvent;
+
+typedef struct {
+    SimEvent heap[SIM_QUEUE_MAX];   // time_us, seq 기준 min-heap
+    uint32_t count;
+    uint64_t now_us;
+    uint64_t next_seq;
+    uint64_t rng;                   // splitmix64 상태
+    uint64_t events;                // 처리한 이벤트 수
+} SimEngine;
+
+// ==================== FUNCTION PROTOTYPES ====================
+
+void sim_init(SimEngine *sim, uint64_t seed);
+int sim_schedule(SimEngine *sim, uint64_t time_us, SimEventType type, uint32_t arg);  // 큐가 가득 차면 -1
+bool sim_next(SimEngine *sim, SimEvent *ev);    // 가장 이른 이벤트를 꺼내고 now_us 진행 (없으면 false)
+uint32_t sim_rand(SimEngine *sim);              // seed에서만 결정되는 난수
+uint32_t sim_rand_next(uint64_t *state);        // splitmix64 한 단계 (다른 모듈의 seed 고정 난수도 공유)
+
+#endif // SIM_H
@@ -0,0 +1,350 @@
+/*
+ * slc.c - SLC Write Cache + Background Folding
+ */
+
+#include "slc.h"
+#include "ftl.h"
+#include "summary.h"
+#include <stdio.h>
+#include <string.h>
+
+// ==================== CACHE LAYOUT ====================
+
+uint32_t slc_capacity_pages(const SlcCache *slc) {
+    return slc->blocks * SLC_PAGES_PER_BLOCK;
+}
+
+static uint32_t slc_block_used(FTL *ftl, uint32_t b) {
+    uint32_t used = 0;
+
+    for (uint32_t p = 0; p < SLC_PAGES_PER_BLOCK; p++) {
+        if (nand_get_page_state(&ftl->nand, b * PAGES_PER_BLOCK + p) != PAGE_FREE) used++;
+    }
+    return used;
+}
+
+uint32_t slc_used_pages(FTL *ftl) {
+    SlcCache *s = &ftl->slc;
+    uint32_t used = 0;
+
+    for (uint32_t b = s->first_block; b < s->first_block + s->blocks; b++) {
+        used += slc_block_used(ftl, b);
+    }
+    return used;
+}
+
+// 캐시 안 다음 free page (블록마다 앞 SLC_PAGES_PER_BLOCK page만 사용)
+static uint32_t slc_alloc(FTL *ftl) {
+    SlcCache *s = &ftl->slc;
+    uint32_t cache_pages = slc_capacity_pages(s);
+
+    for (uint32_t i = 0; i < cache_pages; i++) {
+        uint32_t idx = (s->next_page + i) % cache_pages;
+        uint32_t block = s->first_block + idx / SLC_PAGES_PER_BLOCK;
+        uint32_t pba = block * PAGES_PER_BLOCK + idx % SLC_PAGES_PER_BLOCK;
+
+        if (block == ftl->gc_victim_block) continue;
+        if (nand_get_page_state(&ftl->nand, pba) == PAGE_FREE) {
+            s->next_page = (idx + 1) % cache_pages;
+            return pba;
+        }
+    }
+    return 0xFFFFFFFF;
+}
+
+// ==================== FOLDING ====================
+
+static uint64_t slc_fold_cost(uint32_t valid) {
+    return (uint64_t)valid * (NAND_T_READ_SLC_US + NAND_T_PROG_US) + NAND_T_BERS_US;
+}
+
+// folding 대상: 가득 찬 블록 중 유효 page가 가장 적은 블록, 없으면 가장 많이 쓴 블록
+static uint32_t slc_select_fold_block(FTL *ftl) {
+    SlcCache *s = &ftl->slc;
+    uint32_t victim = 0xFFFFFFFF, best_valid = UINT32_MAX, best_used = 0;
+
+    for (uint32_t b = s->first_block; b < s->first_block + s->blocks; b++) {
+        uint32_t used = slc_block_used(ftl, b);
+        uint32_t valid = ftl_count_valid_pages(ftl, b);
+
+        if (used == 0) continue;
+        if (used == SLC_PAGES_PER_BLOCK) {
+            if (best_used < SLC_PAGES_PER_BLOCK || valid < best_valid) {
+                victim = b;
+                best_valid = valid;
+                best_used = used;
+            }
+        } else if (best_used < SLC_PAGES_PER_BLOCK && used > best_used) {
+            victim = b;
+            best_used = used;
+        }
+    }
+    return victim;
+}
+
+// 블록의 유효 page를 TLC 영역으로 옮기고 erase (TLC 공간이 부족하면 GC 먼저).
+// 이동이 끝나지 않으면 (GC로도 공간 확보 실패) 남은 page를 지우지 않고 -1
+static int slc_evacuate_block(FTL *ftl, uint32_t b, uint32_t *moved) {
+    uint32_t valid = ftl_count_valid_pages(ftl, b);
+    uint32_t reserve = ftl->data_blocks * PAGES_PER_BLOCK * ftl->gc_low_watermark / 100;
+
+    while (ftl_free_data_pages(ftl) < valid + reserve) {
+        uint32_t before = ftl_free_data_pages(ftl);
+        ftl_trigger_gc(ftl);
+        if (ftl_free_data_pages(ftl) <= before) break;
+    }
+
+    ftl->gc_victim_block = b;
+    ftl_gc_one_block(ftl, b);
+    journal_flush(ftl);
+    ftl->gc_victim_block = 0xFFFFFFFF;
+    uint32_t left = ftl_count_valid_pages(ftl, b);
+    *moved = valid - left;
+
+    if (left > 0) {
+        fprintf(stderr, "[SLC] Block %u: %u valid pages left (no free TLC space), not erased\n", b, left);
+        return -1;
+    }
+    // summary page는 옮기지 않으므로 여기서 끊고 erase
+    uint32_t sum_pba = b * PAGES_PER_BLOCK + SUMMARY_PAGE;
+    if (nand_get_page_state(&ftl->nand, sum_pba) == PAGE_VALID) {
+        nand_set_page_state(&ftl->nand, sum_pba, PAGE_INVALID);
+    }
+    if (slc_block_used(ftl, b) > 0 || ftl->nand.blocks[b].invalid_page_count > 0) {
+        nand_erase_block(&ftl->nand, b);
+    }
+    return 0;
+}
+
+static int slc_fold_block(FTL *ftl, uint32_t b, uint64_t *cost) {
+    SlcCache *s = &ftl->slc;
+    uint32_t valid;
+    int ret = slc_evacuate_block(ftl, b, &valid);
+
+    // 옮긴 만큼은 비용으로 계산 (실패해도 이동한 page는 이미 TLC에 있음)
+    *cost = slc_fold_cost(valid);
+    s->folded_pages += valid;
+    s->fold_model_us += *cost;
+    if (ret == 0) {
+        s->folded_blocks++;
+    }
+    return ret;
+}
+
+void slc_background(FTL *ftl) {
+    SlcCache *s = &ftl->slc;
+    uint64_t cost;
+
+    if (s->blocks == 0 || s->burst) {
+        return;
+    }
+    if (slc_used_pages(ftl) * 100 < slc_capacity_pages(s) * s->fold_trigger) {
+        return;
+    }
+
+    uint32_t b = slc_select_fold_block(ftl);
+    if (b != 0xFFFFFFFF) {
+        slc_fold_block(ftl, b, &cost);
+    }
+}
+
+uint64_t slc_idle(FTL *ftl, uint64_t idle_us) {
+    uint64_t spent = 0;
+
+    while (ftl->slc.blocks) {
+        uint32_t b = slc_select_fold_block(ftl);
+        if (b == 0xFFFFFFFF) break;
+
+        uint64_t cost = slc_fold_cost(ftl_count_valid_pages(ftl, b));
+        if (spent + cost > idle_us) break;
+        int ret = slc_fold_block(ftl, b, &cost);
+        spent += cost;
+        if (ret != 0) break;        // TLC가 가득 참: 다음 유휴 시간에 다시
+    }
+    return spent;
+}
+
+// ==================== ALLOCATION ====================
+
+uint32_t slc_alloc_host_page(FTL *ftl, uint32_t lba) {
+    SlcCache *s = &ftl->slc;
+    uint32_t pba = slc_alloc(ftl);
+
+    if (pba != 0xFFFFFFFF) {
+        s->slc_writes++;
+        s->last_write_us = NAND_T_PROG_SLC_US;
+    } else if (s->bypass) {
+        // 캐시가 가득 참: TLC에 바로 기록 (처리량 절벽)
+        s->bypass_writes++;
+        s->last_write_us = NAND_T_PROG_US;
+        pba = ftl_find_free_page(ftl, lba);
+    } else {
+        // 캐시가 가득 참: 블록 하나를 folding 할 때까지 호스트 쓰기 대기
+        // folding이 끝나지 않으면 블록이 캐시에 남아 slc_alloc이 실패하므로 TLC로 기록
+        uint32_t b = slc_select_fold_block(ftl);
+        uint64_t cost = 0;
+        if (b != 0xFFFFFFFF) {
+            slc_fold_block(ftl, b, &cost);
+        }
+        s->stalled_writes++;
+        pba = slc_alloc(ftl);
+        if (pba == 0xFFFFFFFF) {
+            pba = ftl_find_free_page(ftl, lba);
+            s->last_write_us = (uint32_t)(cost + NAND_T_PROG_US);
+        } else {
+            s->last_write_us = (uint32_t)(cost + NAND_T_PROG_SLC_US);
+        }
+    }
+    s->host_model_us += s->last_write_us;
+    return pba;
+}
+
+// ==================== CONFIGURATION ====================
+
+int slc_configure(FTL *ftl, uint32_t blocks) {
+    SlcCache *s = &ftl->slc;
+
+    if (blocks == s->blocks) {
+        return 0;
+    }
+
+    // 기존 캐시는 모두 folding 후 data 영역으로 반환
+    if (s->blocks) {
+        for (uint32_t b = s->first_block; b < s->first_block + s->blocks; b++) {
+            uint64_t cost;
+            if (slc_block_used(ftl, b) > 0 && slc_fold_block(ftl, b, &cost) != 0) {
+                fprintf(stderr, "[SLC] Cannot fold block %u, cache left at %u blocks\n", b, s->blocks);
+                return -1;
+            }
+        }
+        for (uint32_t b = s->first_block; b < s->first_block + s->blocks; b++) {
+            ftl->nand.blocks[b].slc_mode = false;
+        }
+        ftl->data_blocks += s->blocks;
+        s->blocks = 0;
+    }
+    if (blocks == 0) {
+        printf("[SLC] Cache disabled\n");
+        return 0;
+    }
+
+    // 남은 TLC 영역이 논리 용량 + GC 여유를 담을 수 있어야 함
+    if (blocks >= ftl->data_blocks ||
+        (ftl->data_blocks - blocks) * PAGES_PER_BLOCK * (100 - ftl->gc_low_watermark) / 100 <
+            TOTAL_LOGICAL_PAGES + PAGES_PER_BLOCK) {
+        fprintf(stderr, "[SLC] %u cache blocks leave too little TLC capacity\n", blocks);
+        return -1;
+    }
+
+    // 캐시로 쓸 블록(data 영역 끝)의 기존 데이터는 나머지 data 영역으로 이동
+    s->first_block = ftl->data_blocks - blocks;
+    ftl->data_blocks = s->first_block;
+    for (uint32_t b = s->first_block; b < s->first_block + blocks; b++) {
+        uint32_t moved;
+        if (slc_evacuate_block(ftl, b, &moved) != 0) {
+            // 이미 비운 블록은 그대로 data 영역으로 돌려줌
+            ftl->data_blocks = s->first_block + blocks;
+            fprintf(stderr, "[SLC] Cannot evacuate block %u for the cache\n", b);
+            return -1;
+        }
+    }
+    // 비운 블록부터 SLC 모드로 program (NAND / scheduler가 SLC tR / tPROG로 계산)
+    for (uint32_t b = s->first_block; b < s->first_block + blocks; b++) {
+        ftl->nand.blocks[b].slc_mode = true;
+    }
+    s->blocks = blocks;
+    s->next_page = 0;
+
+    printf("[SLC] Cache enabled: blocks %u~%u (%u SLC pages, %u pages of TLC capacity)\n",
+           s->first_block, s->first_block + blocks - 1, slc_capacity_pages(s), blocks * PAGES_PER_BLOCK);
+    return 0;
+}
+
+// ==================== BENCHMARK ====================
+
+#define SLC_BENCH_MAX_ROUNDS    32
+
+void slc_benchmark(FTL *ftl, uint32_t burst, uint32_t idle_ms, uint32_t rounds) {
+    SlcCache *s = &ftl->slc;
+    uint8_t data[PAGE_SIZE];
+    uint32_t seed = 12345;
+    struct {
+        uint64_t slc, bypass, stall, total_us, head_us, tail_us, idle_us, folded;
+        uint32_t used_after;
+    } rows[SLC_BENCH_MAX_ROUNDS];
+
+    if (s->blocks == 0) {
+        printf("[SLC] Cache is off ('slc <blocks>' first)\n");
+        return;
+    }
+    if (burst == 0) burst = 1;
+    if (rounds == 0) rounds = 1;
+    if (rounds > SLC_BENCH_MAX_ROUNDS) rounds = SLC_BENCH_MAX_ROUNDS;
+    uint32_t window = burst / 10 ? burst / 10 : 1;
+
+    memset(data, 0, PAGE_SIZE);
+    for (uint32_t r = 0; r < rounds; r++) {
+        uint64_t slc0 = s->slc_writes, by0 = s->bypass_writes, st0 = s->stalled_writes;
+        uint64_t folded0 = s->folded_pages;
+
+        memset(&rows[r], 0, sizeof(rows[r]));
+
+        // burst 동안은 유휴 시간이 없으므로 background folding 없음
+        s->burst = true;
+        for (uint32_t i = 0; i < burst; i++) {
+            seed = seed * 1103515245 + 12345;
+            uint32_t lba = (seed >> 8) % TOTAL_LOGICAL_PAGES;
+            memcpy(data, &seed, sizeof(seed));
+
+            s->last_write_us = 0;
+            if (ftl_write(ftl, lba, data) != 0) break;
+            rows[r].total_us += s->last_write_us;
+            if (i < window) rows[r].head_us += s->last_write_us;
+            if (i >= burst - window) rows[r].tail_us += s->last_write_us;
+        }
+        s->burst = false;
+
+        rows[r].idle_us = slc_idle(ftl, (uint64_t)idle_ms * 1000);
+        rows[r].slc = s->slc_writes - slc0;
+        rows[r].bypass = s->bypass_writes - by0;
+        rows[r].stall = s->stalled_writes - st0;
+        rows[r].folded = s->folded_pages - folded0;
+        rows[r].used_after = slc_used_pages(ftl);
+    }
+
+    // 처리량 = 모델 시간 기준 (PAGE_SIZE bytes / us = MB/s)
+    printf("\n========== SLC Cache Benchmark ==========\n");
+    printf("burst %u writes, idle %u ms, cache %u SLC pages, bypass %s, fold trigger %u%%\n",
+           burst, idle_ms, slc_capacity_pages(s), s->bypass ? "on" : "off", s->fold_trigger);
+    printf("%5s %6s %6s %6s %10s %10s %10s %9s %9s\n",
+           "Round", "SLC", "Bypass", "Stall", "Burst MB/s", "Head MB/s", "Tail MB/s", "Folded", "Cache%");
+    for (uint32_t r = 0; r < rounds; r++) {
+        printf("%5u %6lu %6lu %6lu %10.2f %10.2f %10.2f %9lu %8.1f%%\n", r + 1,
+               rows[r].slc, rows[r].bypass, rows[r].stall,
+               rows[r].total_us ? (double)burst * PAGE_SIZE / rows[r].total_us : 0.0,
+               rows[r].head_us ? (double)window * PAGE_SIZE / rows[r].head_us : 0.0,
+               rows[r].tail_us ? (double)window * PAGE_SIZE / rows[r].tail_us : 0.0,
+               rows[r].folded, 100.0 * rows[r].used_after / slc_capacity_pages(s));
+    }
+    printf("(head/tail = first/last %u writes of each burst; SLC tPROG %dus, TLC tPROG %dus)\n",
+           window, NAND_T_PROG_SLC_US, NAND_T_PROG_US);
+    printf("=========================================\n");
+}
+
+// ==================== STATISTICS ====================
+
+void slc_print_statistics(FTL *ftl) {
+    SlcCache *s = &ftl->slc;
+    uint64_t host = s->slc_writes + s->bypass_writes + s->stalled_writes;
+    uint32_t cap = slc_capacity_pages(s);
+
+    printf("SLC Cache:           %u blocks (%u SLC pages, %.1f%% used), fold trigger %u%%, bypass %s\n",
+           s->blocks, cap, cap ? 100.0 * slc_used_pages(ftl) / cap : 0.0,
+           s->fold_trigger, s->bypass ? "on" : "off");
+    printf("  Host Writes:       %lu to SLC, %lu bypassed to TLC, %lu stalled on folding\n",
+           s->slc_writes, s->bypass_writes, s->stalled_writes);
+    printf("  Folding:           %lu pages from %lu blocks (%.1f ms modeled)\n",
+           s->folded_pages, s->folded_blocks, s->fold_model_us / 1000.0);
+    printf("  Modeled Write:     %.1f us avg per host program\n",
+           host ? (double)s->host_model_us / host : 0.0);
+}
@@ -0,0 +1,72 @@
+/*
+ * slc.h - SLC Write Cache + Background Folding
+ *
+ * data 영역 끝의 블록 몇 개를 SLC 모드 캐시로 사용한다.
+ * - SLC 모드는 셀당 1bit라서 블록당 SLC_PAGES_PER_BLOCK page만 쓰고,
+ *   program/read가 TLC보다 빠르다 (nand_flash.h 타이밍 모델)
+ * - 호스트 쓰기는 먼저 SLC 캐시에 기록되고, folding이 유효 page를
+ *   일반(TLC) 블록으로 옮긴 뒤 SLC 블록을 지운다
+ * - folding은 캐시 사용률이 fold trigger 이상일 때 유휴 시간에 진행 (background).
+ *   캐시가 가득 차면 bypass on이면 TLC에 바로 쓰고, off면 호스트 쓰기가
+ *   folding을 기다린다 (foreground stall)
+ *
+ * 캐시 블록은 data_blocks 밖에 있으므로 일반 할당/GC 대상이 아니다.
+ * 캐시 설정은 저장하지 않고, mount 후에는 캐시에 남은 page도 일반 page로 취급한다.
+ */
+
+#ifndef SLC_H
+#define SLC_H
+
+#include "nand_flash.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// ==================== SLC CACHE CONFIGURATION ====================
+#define SLC_CACHE_BLOCKS_DEFAULT    0                       // 기본 off (slc 명령어로 전환)
+#define SLC_PAGES_PER_BLOCK         (PAGES_PER_BLOCK / 3)   // TLC 블록을 SLC 모드로 쓰면 1/3 용량
+#define SLC_FOLD_TRIGGER_DEFAULT    75                      // 캐시 사용률(%) 이상이면 background folding
+#define SLC_BYPASS_DEFAULT          1                       // 캐시가 가득 차면 TLC에 바로 기록
+
+// ==================== DATA STRUCTURES ====================
+
+typedef struct {
+    uint32_t blocks;                    // 캐시 블록 수 (0 = off)
+    uint32_t first_block;               // 캐시 영역 시작 (= 설정 시점의 data_blocks)
+    uint32_t fold_trigger;              // 사용률 %
+    bool bypass;
+    bool burst;                         // 벤치마크 burst 중 (유휴 시간 없음 -> background folding 안 함)
+    uint32_t next_page;                 // 캐시 안 할당 커서
+
+    // 통계
+    uint64_t slc_writes;                // 캐시에 기록한 호스트 쓰기
+    uint64_t bypass_writes;             // 캐시가 가득 차서 TLC로 바로 기록
+    uint64_t stalled_writes;            // folding을 기다린 호스트 쓰기
+    uint64_t folded_pages;
+    uint64_t folded_blocks;
+    uint64_t host_model_us;             // 호스트 쓰기 모델 시간 합계
+    uint64_t fold_model_us;             // folding 모델 시간 합계
+    uint32_t last_write_us;             // 마지막 호스트 쓰기의 모델 시간
+} SlcCache;
+
+struct FTL;
+
+// ==================== FUNCTION PROTOTYPES ====================
+
+// 캐시 설정 (blocks = 0이면 모두 folding 후 해제)
+int slc_configure(struct FTL *ftl, uint32_t blocks);
+
+// 호스트 쓰기 위치 할당 (캐시 -> bypass / foreground folding)
+uint32_t slc_alloc_host_page(struct FTL *ftl, uint32_t lba);
+// 호스트 쓰기 완료 후 호출: 사용률이 trigger 이상이면 유휴 시간에 folding
+void slc_background(struct FTL *ftl);
+// 유휴 시간 idle_us 동안 folding (사용한 시간 반환)
+uint64_t slc_idle(struct FTL *ftl, uint64_t idle_us);
+
+uint32_t slc_used_pages(struct FTL *ftl);
+uint32_t slc_capacity_pages(const SlcCache *slc);
+
+// burst / idle 패턴으로 캐시 흡수 구간과 이후 처리량 절벽 측정
+void slc_benchmark(struct FTL *ftl, uint32_t burst, uint32_t idle_ms, uint32_t rounds);
+void slc_print_statistics(struct FTL *ftl);
+
+#endif // SLC_H
@@ -8,25 +8,79 @@
 #define _CRT_SECURE_NO_WARNINGS
 #include "ssd.h"
 #include "ftl.h"
+#include "dedup.h"
+#include "crc32c.h"
+#include "bench.h"
+#include "sweep.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
 
-// ==================== GLOBAL FTL INSTANCE ====================
-//static 
-FTL g_ftl;
-static int g_initialized = 0;
+// ==================== SSD INSTANCES ====================
+
+// FTL instance 하나와 그 위의 dedup 계층, 이미지 파일 경로
+struct SsdContext {
+    FTL ftl;
+    Dedup dedup;                // 선택적 dedup 계층 (ssd.c -> dedup -> FTL)
+    int initialized;
+    char image_path[FTL_IMAGE_PATH_MAX];    // "" = 파일 없이 메모리만
+};
+
+static SsdContext g_default = { .image_path = FTL_IMAGE_FILE_DEFAULT };
+static __thread SsdContext *g_ctx = &g_default;    // 이 스레드의 명령이 쓰는 instance
 
 // ==================== INTERNAL HELPERS ====================
 
+// dedup 호스트 매핑은 이미지 옆 파일 (메모리 전용 instance는 저장하지 않음)
+static const char* dedup_map_path(char* buf, size_t size) {
+    if (g_ctx->image_path[0] == '\0') {
+        return NULL;
+    }
+    snprintf(buf, size, "%s%s", g_ctx->image_path, DEDUP_MAP_SUFFIX);
+    return buf;
+}
+
 static void ensure_initialized() {
-    if (!g_initialized) {
-        ftl_init(&g_ftl);
-        g_initialized = 1;
+    if (!g_ctx->initialized) {
+        char path[FTL_IMAGE_PATH_MAX + 8];
+        if (ftl_init_at(&g_ctx->ftl, g_ctx->image_path) != 0) {
+            fprintf(stderr, "[SSD] FTL initialization failed\n");
+            exit(1);
+        }
+        if (dedup_map_path(path, sizeof(path)) && dedup_load(&g_ctx->dedup, &g_ctx->ftl, path) == 0) {
+            printf("[SSD] Dedup map loaded\n");
+        }
+        g_ctx->initialized = 1;
         printf("[SSD] FTL initialized\n");
     }
 }
 
+// ZNS 모드에서는 호스트가 zone을 직접 관리하므로 FTL 쪽 기능은 막음
+static int zns_blocked(const char* what) {
+    if (!g_ctx->ftl.zns.enabled) {
+        return 0;
+    }
+    printf("[SSD] %s is not available in ZNS mode (zns off first)\n", what);
+    return 1;
+}
+
+// 전용 pool namespace가 있으면 data 영역 끝 / 공유 pool을 쓰는 기능은 막음
+static int ns_pools_blocked(const char* what) {
+    for (uint32_t i = 0; i < g_ctx->ftl.ns.count; i++) {
+        if (g_ctx->ftl.ns.ns[i].pool_blocks) {
+            printf("[SSD] %s is not available with dedicated namespace pools (ns clear first)\n", what);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// 현재 인터페이스의 LBA 수 (ZNS는 zone 전체)
+static int ssd_capacity() {
+    return g_ctx->ftl.zns.enabled ? (int)zns_capacity(&g_ctx->ftl.zns) : TOTAL_LOGICAL_PAGES;
+}
+
 static void convert_hex_to_bytes(const char* hex_str, uint8_t* buffer) {
     // "0x12345678" -> bytes 배열로 변환
     // 기존 프로젝트는 4바이트 hex 값 사용
@@ -56,12 +110,22 @@ static unsigned int convert_bytes_to_hex(const uint8_t* buffer) {
 // ==================== PUBLIC API (기존 인터페이스 유지) ====================
 
 void write(int idx, char* data) {
+    ssd_write(idx, data);
+}
+
+unsigned int read(int idx) {
+    unsigned int value = 0;
+    ssd_read(idx, &value);
+    return value;
+}
+
+int ssd_write(int idx, char* data) {
     ensure_initialized();
     
-    if (idx < 0 || idx >= TOTAL_LOGICAL_PAGES) {
-        printf("[SSD] 할당된 범위 밖입니다 (0~%d)\n", TOTAL_LOGICAL_PAGES - 1);
-        printf("%d",TOTAL_LOGICAL_PAGES);
-	return;
+    if (idx < 0 || idx >= ssd_capacity()) {
+        printf("[SSD] 할당된 범위 밖입니다 (0~%d)\n", ssd_capacity() - 1);
+        printf("%d",ssd_capacity());
+	return -1;
     }
     
     // Hex string을 바이트 배열로 변환
@@ -69,64 +133,696 @@ void write(int idx, char* data) {
     convert_hex_to_bytes(data, buffer);
     
     // FTL을 통해 쓰기
-    if (ftl_write(&g_ftl, (uint32_t)idx, buffer) == 0) {
+    int ret = g_ctx->ftl.zns.enabled ? zns_write(&g_ctx->ftl, (uint32_t)idx, buffer)
+            : g_ctx->dedup.enabled ? dedup_write(&g_ctx->dedup, &g_ctx->ftl, (uint32_t)idx, buffer)
+                              : ftl_write(&g_ctx->ftl, (uint32_t)idx, buffer);
+    if (ret == 0) {
         printf("[SSD] Write success: LBA %d <- %s\n", idx, data);
-    } else {
-        printf("[SSD] Write failed: LBA %d\n", idx);
+        return 0;
     }
+    printf("[SSD] Write failed: LBA %d\n", idx);
+    return -1;
 }
 
-unsigned int read(int idx) {
+int ssd_read(int idx, unsigned int* value) {
     ensure_initialized();
     
-    if (idx < 0 || idx >= TOTAL_LOGICAL_PAGES) {
-        printf("[SSD] 할당된 범위 밖입니다 (0~%d)\n", TOTAL_LOGICAL_PAGES - 1);
-        return 0;
+    if (idx < 0 || idx >= ssd_capacity()) {
+        printf("[SSD] 할당된 범위 밖입니다 (0~%d)\n", ssd_capacity() - 1);
+        return -1;
     }
     
     // FTL을 통해 읽기
     uint8_t buffer[PAGE_SIZE];
-    if (ftl_read(&g_ftl, (uint32_t)idx, buffer) == 0) {
-        unsigned int value = convert_bytes_to_hex(buffer);
+    int ret = g_ctx->ftl.zns.enabled ? zns_read(&g_ctx->ftl, (uint32_t)idx, buffer)
+            : g_ctx->dedup.enabled ? dedup_read(&g_ctx->dedup, &g_ctx->ftl, (uint32_t)idx, buffer)
+                              : ftl_read(&g_ctx->ftl, (uint32_t)idx, buffer);
+    if (ret == 0) {
+        *value = convert_bytes_to_hex(buffer);
         
         // 기존 프로젝트와의 호환성: result.txt에 저장
         FILE* rfp = fopen("result.txt", "w+");
         if (rfp) {
-            fprintf(rfp, "0x%08X\n", value);
+            fprintf(rfp, "0x%08X\n", *value);
             fclose(rfp);
         }
         
-        printf("[SSD] Read success: LBA %d -> 0x%08X\n", idx, value);
-        return value;
-    } else {
-        printf("[SSD] Read failed: LBA %d (no data)\n", idx);
+        printf("[SSD] Read success: LBA %d -> 0x%08X\n", idx, *value);
         return 0;
     }
+    printf("[SSD] Read failed: LBA %d (no data)\n", idx);
+    return -1;
 }
 
 // ==================== EXTENDED API (새로운 기능) ====================
 
 void ssd_print_statistics() {
     ensure_initialized();
-    ftl_print_statistics(&g_ftl);
-    nand_print_statistics(&g_ftl.nand);
+    ftl_print_statistics(&g_ctx->ftl);
+    if (g_ctx->dedup.enabled) {
+        dedup_print_statistics(&g_ctx->dedup, &g_ctx->ftl);
+    }
+    nand_print_statistics(&g_ctx->ftl.nand);
 }
 
 void ssd_print_l2p_table() {
     ensure_initialized();
-    ftl_print_l2p_table(&g_ftl);
+    ftl_print_l2p_table(&g_ctx->ftl);
 }
 
 void ssd_force_gc() {
     ensure_initialized();
+    if (zns_blocked("Device GC")) {
+        return;
+    }
     printf("[SSD] Forcing Garbage Collection...\n");
-    ftl_trigger_gc(&g_ftl);
+    ftl_trigger_gc(&g_ctx->ftl);
+}
+
+int ssd_set_gc_watermarks(unsigned int low, unsigned int high) {
+    ensure_initialized();
+    
+    if (ftl_set_gc_watermarks(&g_ctx->ftl, low, high) != 0) {
+        return -1;
+    }
+    printf("[SSD] GC watermarks: start below %u%% free, reclaim up to %u%%\n", low, high);
+    return 0;
+}
+
+int ssd_set_gc_policy(const char* name, unsigned int param) {
+    ensure_initialized();
+    
+    if (name == NULL) {
+        gc_policy_print(&g_ctx->ftl);
+        return 0;
+    }
+    if (ftl_set_gc_policy(&g_ctx->ftl, name, param) != 0) {
+        return -1;
+    }
+    printf("[SSD] GC victim policy: %s\n", name);
+    return 0;
+}
+
+void ssd_save() {
+    ensure_initialized();
+    
+    const char* image = g_ctx->image_path;
+    char path[FTL_IMAGE_PATH_MAX + 8];
+    if (image[0] == '\0') {
+        printf("[SSD] In-memory instance, nothing to save\n");
+        return;
+    }
+    ftl_sync(&g_ctx->ftl);
+    if (g_ctx->dedup.enabled) {
+        dedup_save(&g_ctx->dedup, &g_ctx->ftl, dedup_map_path(path, sizeof(path)));
+    }
+    nand_save_to_file(&g_ctx->ftl.nand, image);
+    
+    struct stat st;
+    if (stat(image, &st) == 0) {
+        printf("[SSD] Saved %s: %lu pages written, %lu blocks punched, "
+               "%.1f KB on disk of %.1f KB apparent\n", image,
+               g_ctx->ftl.nand.image_pages_written, g_ctx->ftl.nand.image_blocks_punched,
+               st.st_blocks * 512 / 1024.0, st.st_size / 1024.0);
+    }
 }
 
 void ssd_shutdown() {
-    if (g_initialized) {
+    if (g_ctx->initialized) {
+        char path[FTL_IMAGE_PATH_MAX + 8];
         printf("[SSD] Shutting down...\n");
-        ftl_cleanup(&g_ftl);
-        g_initialized = 0;
+        // dedup 호스트 매핑은 이미지 옆 파일에 저장 (꺼져 있으면 이전 파일 제거).
+        // 먼저 sync해야 ftl_cleanup이 저장할 이미지와 program 수가 맞음
+        ftl_sync(&g_ctx->ftl);
+        if (dedup_map_path(path, sizeof(path))) {
+            if (g_ctx->dedup.enabled) {
+                dedup_save(&g_ctx->dedup, &g_ctx->ftl, path);
+            } else {
+                remove(path);
+            }
+        }
+        ftl_cleanup(&g_ctx->ftl);
+        g_ctx->initialized = 0;
+    }
+}
+
+SsdContext* ssd_open(const char* image_path) {
+    SsdContext* ctx = calloc(1, sizeof(SsdContext));
+    
+    if (ctx && image_path) {
+        if (strlen(image_path) >= FTL_IMAGE_PATH_MAX) {
+            printf("[SSD] Image path too long: %s\n", image_path);
+            free(ctx);
+            return NULL;
+        }
+        strcpy(ctx->image_path, image_path);
+    }
+    return ctx;
+}
+
+void ssd_close(SsdContext* ctx) {
+    if (ctx == NULL || ctx == &g_default) {
+        return;
+    }
+    SsdContext* prev = ssd_use(ctx);
+    ssd_shutdown();
+    dedup_free(&ctx->dedup);
+    ssd_use(prev == ctx ? NULL : prev);
+    free(ctx);
+}
+
+SsdContext* ssd_use(SsdContext* ctx) {
+    SsdContext* prev = g_ctx;
+    g_ctx = ctx ? ctx : &g_default;
+    return prev;
+}
+
+void ssd_get_write_counters(unsigned long long* host_writes, unsigned long long* nand_writes) {
+    ensure_initialized();
+    *host_writes = g_ctx->ftl.total_host_writes;
+    *nand_writes = g_ctx->ftl.nand.total_page_writes;
+}
+
+unsigned long long ssd_get_virtual_time_us(void) {
+    ensure_initialized();
+    return g_ctx->ftl.nand.vtime_us;
+}
+
+// ==================== MAPPING MODE ====================
+
+int ssd_set_map_mode(const char* mode, unsigned int cmt_entries) {
+    ensure_initialized();
+    if (zns_blocked("Mapping mode")) {
+        return -1;
+    }
+    if (strcmp(mode, "dftl") == 0 && ns_pools_blocked("DFTL")) {
+        return -1;
+    }
+    
+    FTLMapMode target;
+    if (strcmp(mode, "page") == 0) {
+        target = MAP_MODE_PAGE;
+    } else if (strcmp(mode, "dftl") == 0) {
+        target = MAP_MODE_DFTL;
+    } else if (strcmp(mode, "extent") == 0) {
+        target = MAP_MODE_EXTENT;
+    } else {
+        printf("[SSD] Unknown mapping mode: %s (page | dftl | extent)\n", mode);
+        return -1;
+    }
+    
+    if (cmt_entries == 0) {
+        cmt_entries = DFTL_CMT_ENTRIES;
+    }
+    if (ftl_set_map_mode(&g_ctx->ftl, target, cmt_entries) != 0) {
+        printf("[SSD] Mapping mode change failed\n");
+        return -1;
+    }
+    
+    printf("[SSD] Mapping mode: %s (%zu bytes resident)\n", mode, ftl_mapping_memory_bytes(&g_ctx->ftl));
+    return 0;
+}
+
+// ==================== MAPPING JOURNAL ====================
+
+int ssd_set_journal(int enable) {
+    ensure_initialized();
+    if (zns_blocked("Journal")) {
+        return -1;
+    }
+    if (enable && ns_pools_blocked("Journal")) {
+        return -1;
+    }
+    
+    int ret = enable ? journal_enable(&g_ctx->ftl) : journal_disable(&g_ctx->ftl);
+    if (ret != 0) {
+        printf("[SSD] Mapping journal change failed\n");
+        return -1;
+    }
+    printf("[SSD] Mapping journal: %s\n", enable ? "on" : "off");
+    return 0;
+}
+
+int ssd_checkpoint() {
+    ensure_initialized();
+    if (zns_blocked("Checkpoint")) {
+        return -1;
+    }
+    
+    if (!g_ctx->ftl.journal.enabled) {
+        printf("[SSD] Mapping journal is off ('journal on' first)\n");
+        return -1;
+    }
+    if (journal_checkpoint(&g_ctx->ftl) != 0) {
+        printf("[SSD] Checkpoint failed\n");
+        return -1;
+    }
+    printf("[SSD] Checkpoint %u written\n", g_ctx->ftl.journal.ckpt_id);
+    return 0;
+}
+
+void ssd_recovery_benchmark() {
+    ensure_initialized();
+    ftl_recovery_benchmark(&g_ctx->ftl);
+}
+
+void ssd_set_summary(int enable) {
+    ensure_initialized();
+    g_ctx->ftl.summary_enabled = enable ? true : false;
+    printf("[SSD] Block summary: %s\n", enable ? "on" : "off");
+}
+
+void ssd_set_scan_threads(unsigned int threads) {
+    ensure_initialized();
+    g_ctx->ftl.scan_threads = threads;
+    printf("[SSD] Mount scan threads: %u%s\n", threads ? threads : scan_default_threads(),
+           threads ? "" : " (auto)");
+}
+
+// ==================== COMPRESSION ====================
+
+int ssd_set_compress(int enable) {
+    ensure_initialized();
+    if (zns_blocked("Compression")) {
+        return -1;
+    }
+    if (enable && ns_pools_blocked("Compression")) {
+        return -1;
+    }
+    
+    // 끄기 전에 스테이징된 페이지를 program (기존 packed page는 계속 읽힘)
+    if (!enable && !g_ctx->ftl.pack.unit && pack_flush(&g_ctx->ftl) != 0) {
+        printf("[SSD] Failed to flush staged compressed pages\n");
+        return -1;
+    }
+    g_ctx->ftl.pack.enabled = enable ? true : false;
+    printf("[SSD] Inline compression: %s\n", enable ? "on" : "off");
+    return 0;
+}
+
+int ssd_set_subpage(unsigned int unit) {
+    ensure_initialized();
+    if (zns_blocked("Sub-page mapping")) {
+        return -1;
+    }
+    if (unit && ns_pools_blocked("Sub-page mapping")) {
+        return -1;
+    }
+    
+    if (pack_set_unit(&g_ctx->ftl.pack, unit) != 0) {
+        return -1;
+    }
+    if (!unit && !g_ctx->ftl.pack.enabled && pack_flush(&g_ctx->ftl) != 0) {
+        printf("[SSD] Failed to flush staged sub-page writes\n");
+        return -1;
+    }
+    if (unit) {
+        printf("[SSD] Sub-page mapping unit: %u bytes\n", unit);
+    } else {
+        printf("[SSD] Sub-page mapping: off\n");
+    }
+    return 0;
+}
+
+// ==================== SLC CACHE ====================
+
+int ssd_set_slc_cache(unsigned int blocks) {
+    ensure_initialized();
+    if (zns_blocked("SLC cache")) {
+        return -1;
+    }
+    if (blocks && ns_pools_blocked("SLC cache")) {
+        return -1;
+    }
+    
+    if (slc_configure(&g_ctx->ftl, blocks) != 0) {
+        printf("[SSD] SLC cache change failed\n");
+        return -1;
+    }
+    return 0;
+}
+
+void ssd_set_slc_policy(int fold_trigger, int bypass) {
+    ensure_initialized();
+    
+    // 음수 = 변경 없음
+    if (fold_trigger >= 0) g_ctx->ftl.slc.fold_trigger = fold_trigger > 100 ? 100 : (uint32_t)fold_trigger;
+    if (bypass >= 0) g_ctx->ftl.slc.bypass = bypass ? true : false;
+    printf("[SSD] SLC fold trigger: %u%%, bypass on full: %s\n",
+           g_ctx->ftl.slc.fold_trigger, g_ctx->ftl.slc.bypass ? "on" : "off");
+}
+
+void ssd_slc_fold() {
+    ensure_initialized();
+    
+    uint64_t us = slc_idle(&g_ctx->ftl, UINT64_MAX);
+    printf("[SSD] SLC cache folded (%.1f ms modeled, %u pages left)\n", us / 1000.0, slc_used_pages(&g_ctx->ftl));
+}
+
+void ssd_slc_benchmark(unsigned int burst, unsigned int idle_ms, unsigned int rounds) {
+    ensure_initialized();
+    if (zns_blocked("SLC benchmark")) {
+        return;
+    }
+    slc_benchmark(&g_ctx->ftl, burst, idle_ms, rounds);
+}
+
+// ==================== ZNS ====================
+
+int ssd_set_zns(int enable, unsigned int zone_blocks) {
+    ensure_initialized();
+    
+    if (!enable) {
+        if (g_ctx->ftl.zns.enabled) {
+            zns_disable(&g_ctx->ftl);
+        }
+        printf("[SSD] ZNS: off (conventional block interface)\n");
+        return 0;
+    }
+    if (g_ctx->dedup.enabled) {
+        printf("[SSD] Turn off dedup before enabling ZNS\n");
+        return -1;
+    }
+    if (g_ctx->ftl.ns.count) {
+        printf("[SSD] Remove namespaces before enabling ZNS (ns clear)\n");
+        return -1;
+    }
+    if (zns_enable(&g_ctx->ftl, zone_blocks) != 0) {
+        return -1;
+    }
+    printf("[SSD] ZNS: %u zones x %u pages (max %u open / %u active), device GC bypassed\n",
+           g_ctx->ftl.zns.zones, g_ctx->ftl.zns.zone_pages, g_ctx->ftl.zns.max_open, g_ctx->ftl.zns.max_active);
+    return 0;
+}
+
+int ssd_zone_command(const char* op, int zone) {
+    ensure_initialized();
+    
+    if (!g_ctx->ftl.zns.enabled) {
+        printf("[SSD] ZNS is off (zns on first)\n");
+        return -1;
+    }
+    if (strcmp(op, "report") == 0) {
+        zns_report(&g_ctx->ftl);
+        return 0;
+    }
+    
+    int ret;
+    uint32_t z = zone < 0 ? UINT32_MAX : (uint32_t)zone;
+    if (strcmp(op, "open") == 0) {
+        ret = zns_open(&g_ctx->ftl, z);
+    } else if (strcmp(op, "close") == 0) {
+        ret = zns_close(&g_ctx->ftl, z);
+    } else if (strcmp(op, "finish") == 0) {
+        ret = zns_finish(&g_ctx->ftl, z);
+    } else if (strcmp(op, "reset") == 0) {
+        ret = zns_reset(&g_ctx->ftl, z);
+    } else {
+        printf("[SSD] Unknown zone command: %s\n", op);
+        return -1;
+    }
+    if (ret == 0) {
+        printf("[SSD] Zone %d %s -> %s (wp LBA %u)\n", zone, op, zns_state_name(g_ctx->ftl.zns.zone[z].state),
+               z * g_ctx->ftl.zns.zone_pages + g_ctx->ftl.zns.zone[z].wp);
+    }
+    return ret;
+}
+
+int ssd_zone_append(int zone, char* data) {
+    ensure_initialized();
+    
+    if (!g_ctx->ftl.zns.enabled) {
+        printf("[SSD] ZNS is off (zns on first)\n");
+        return -1;
+    }
+    uint8_t buffer[PAGE_SIZE];
+    convert_hex_to_bytes(data, buffer);
+    uint32_t lba = zns_append(&g_ctx->ftl, zone < 0 ? UINT32_MAX : (uint32_t)zone, buffer);
+    if (lba == 0xFFFFFFFF) {
+        printf("[SSD] Zone append failed: zone %d\n", zone);
+        return -1;
+    }
+    printf("[SSD] Zone append: zone %d <- %s at LBA %u\n", zone, data, lba);
+    return 0;
+}
+
+void ssd_zns_benchmark(unsigned int writes) {
+    bench_zns(writes);
+}
+
+// ==================== NAMESPACES ====================
+
+// namespace 명령이 가능한 상태인지 (ZNS / dedup은 LBA 공간을 따로 관리)
+static int ns_available() {
+    if (zns_blocked("Namespaces")) {
+        return 0;
+    }
+    if (g_ctx->dedup.enabled) {
+        printf("[SSD] Namespaces are not available with dedup (dedup off first)\n");
+        return 0;
+    }
+    return 1;
+}
+
+int ssd_ns_add(unsigned int pages, unsigned int pool_blocks) {
+    ensure_initialized();
+    if (!ns_available()) {
+        return -1;
+    }
+    
+    int ns = ns_add(&g_ctx->ftl, pages, pool_blocks);
+    if (ns < 0) {
+        printf("[SSD] Namespace add failed\n");
+        return -1;
+    }
+    Namespace *n = &g_ctx->ftl.ns.ns[ns];
+    if (pool_blocks) {
+        printf("[SSD] Namespace %d: LBA %u-%u, dedicated blocks %u-%u\n", ns, n->base, n->base + n->pages - 1,
+               n->pool_first, n->pool_first + n->pool_blocks - 1);
+    } else {
+        printf("[SSD] Namespace %d: LBA %u-%u, shared pool\n", ns, n->base, n->base + n->pages - 1);
+    }
+    return ns;
+}
+
+void ssd_ns_clear() {
+    ensure_initialized();
+    ns_clear(&g_ctx->ftl);
+    printf("[SSD] Namespaces removed (single LBA space, all blocks shared)\n");
+}
+
+void ssd_ns_list() {
+    ensure_initialized();
+    if (g_ctx->ftl.ns.count == 0) {
+        printf("[SSD] No namespaces (ns add <pages> [pool_blocks])\n");
+        return;
+    }
+    ns_print_statistics(&g_ctx->ftl);
+}
+
+int ssd_ns_qos(int ns, unsigned int weight, unsigned int rate) {
+    ensure_initialized();
+    
+    if (ns < 0 || ns >= (int)g_ctx->ftl.ns.count) {
+        printf("[SSD] No namespace %d\n", ns);
+        return -1;
+    }
+    ns_set_qos(&g_ctx->ftl.ns, (uint32_t)ns, weight, rate);
+    printf("[SSD] Namespace %d QoS: weight %u, %s\n", ns, g_ctx->ftl.ns.ns[ns].weight, rate ? "token bucket" : "no rate limit");
+    return 0;
+}
+
+// namespace 안의 LBA를 전역 LBA로 바꿈 (-1 = 범위 밖)
+static int ns_global_lba(int ns, int idx) {
+    if (ns < 0 || ns >= (int)g_ctx->ftl.ns.count) {
+        printf("[SSD] No namespace %d\n", ns);
+        return -1;
+    }
+    if (idx < 0 || (uint32_t)idx >= g_ctx->ftl.ns.ns[ns].pages) {
+        printf("[SSD] Namespace %d holds LBA 0~%u\n", ns, g_ctx->ftl.ns.ns[ns].pages - 1);
+        return -1;
+    }
+    return (int)(g_ctx->ftl.ns.ns[ns].base + (uint32_t)idx);
+}
+
+void ssd_ns_write(int ns, int idx, char* data) {
+    ensure_initialized();
+    int lba = ns_available() ? ns_global_lba(ns, idx) : -1;
+    if (lba >= 0) {
+        write(lba, data);
+    }
+}
+
+unsigned int ssd_ns_read(int ns, int idx) {
+    ensure_initialized();
+    int lba = ns_available() ? ns_global_lba(ns, idx) : -1;
+    return lba >= 0 ? read(lba) : 0;
+}
+
+void ssd_ns_benchmark(unsigned int writes) {
+    bench_namespaces(writes);
+}
+
+// ==================== I/O SCHEDULER ====================
+
+void ssd_sched_benchmark(unsigned int writes) {
+    bench_sched(writes);
+}
+
+// ==================== SIMULATION ====================
+
+void ssd_sim_run(unsigned int requests, unsigned int seed) {
+    bench_sim(requests, seed);
+}
+
+// ==================== PARAMETER SWEEP ====================
+
+int ssd_sweep(unsigned int writes, unsigned int threads, const char* csv_path) {
+    return sweep_run(writes, threads, csv_path);
+}
+
+// ==================== GC AUTO-TUNING ====================
+
+void ssd_autotune(int on) {
+    ensure_initialized();
+    
+    if (on >= 0) {
+        tune_enable(&g_ctx->ftl, on != 0);
+        printf("[SSD] GC auto-tuning %s\n", on ? "enabled" : "disabled");
+        return;
+    }
+    tune_print_status(&g_ctx->ftl);
+}
+
+void ssd_tune_benchmark(unsigned int writes) {
+    bench_tune(writes);
+}
+
+// ==================== INTEGRITY ====================
+
+void ssd_set_crc(int enable) {
+    ensure_initialized();
+    
+    // off 상태에서 쓴 page는 CRC가 없으므로 다시 켜도 검증하지 않음
+    g_ctx->ftl.nand.crc_enabled = enable ? true : false;
+    printf("[SSD] Page CRC32C: %s (%s)\n", enable ? "on" : "off", crc32c_engine());
+}
+
+void ssd_set_copyback(int enable) {
+    ensure_initialized();
+    
+    g_ctx->ftl.nand.copyback_enabled = enable ? true : false;
+    printf("[SSD] GC copyback: %s (same plane only, %d planes)\n", enable ? "on" : "off", NAND_PLANES);
+}
+
+void ssd_set_erase_mode(int lazy) {
+    ensure_initialized();
+    
+    g_ctx->ftl.nand.erase_mode = lazy ? NAND_ERASE_LAZY : NAND_ERASE_EAGER;
+    printf("[SSD] Erase mode: %s\n", lazy ? "lazy (metadata only)" : "eager (memset)");
+}
+
+void ssd_erase_benchmark(unsigned int writes) {
+    bench_erase_modes(writes);
+}
+
+void ssd_set_metadata_only(int enable) {
+    ensure_initialized();
+    
+    g_ctx->ftl.nand.metadata_only = enable ? true : false;
+    printf("[SSD] Payload mode: %s\n", enable ? "metadata-only (host pages keep a 4-byte value)" : "full");
+}
+
+void ssd_metadata_benchmark(unsigned int writes) {
+    bench_payload_modes(writes);
+}
+
+void ssd_payload_benchmark(unsigned int capacity_gb, unsigned int pages) {
+    bench_payload_store(capacity_gb, pages);
+}
+
+void ssd_crc_benchmark() {
+    crc32c_benchmark(PAGE_SIZE);
+}
+
+int ssd_corrupt(int idx) {
+    ensure_initialized();
+    if (zns_blocked("Corrupt")) {
+        return -1;
+    }
+    
+    if (idx < 0 || idx >= TOTAL_LOGICAL_PAGES) {
+        printf("[SSD] 할당된 범위 밖입니다 (0~%d)\n", TOTAL_LOGICAL_PAGES - 1);
+        return -1;
+    }
+    
+    // 스테이징 버퍼에만 있는 LBA는 먼저 NAND로 내림
+    pack_flush(&g_ctx->ftl);
+    uint32_t pba = ftl_l2p_lookup(&g_ctx->ftl, (uint32_t)idx);
+    if (pba == 0xFFFFFFFF || nand_corrupt_page(&g_ctx->ftl.nand, pba) != 0) {
+        printf("[SSD] LBA %d is not on NAND\n", idx);
+        return -1;
+    }
+    printf("[SSD] Corrupted PBA %u (LBA %d)\n", pba, idx);
+    return 0;
+}
+
+// ==================== DEDUPLICATION ====================
+
+int ssd_set_dedup(int enable) {
+    ensure_initialized();
+    if (zns_blocked("Dedup")) {
+        return -1;
+    }
+    if (enable && g_ctx->ftl.ns.count) {
+        printf("[SSD] Dedup shares pages across LBAs; remove namespaces first (ns clear)\n");
+        return -1;
+    }
+    
+    int ret = enable ? dedup_enable(&g_ctx->dedup, &g_ctx->ftl) : dedup_disable(&g_ctx->dedup, &g_ctx->ftl);
+    if (ret != 0) {
+        printf("[SSD] Dedup change failed\n");
+        return -1;
+    }
+    printf("[SSD] Dedup: %s\n", enable ? "on" : "off");
+    return 0;
+}
+
+// ==================== METRICS ====================
+
+void ssd_print_metrics() {
+    ensure_initialized();
+    ftl_metrics_refresh(&g_ctx->ftl);
+    metrics_print(&g_ctx->ftl.metrics);
+}
+
+void ssd_set_metrics_interval(unsigned int interval) {
+    ensure_initialized();
+    metrics_set_interval(&g_ctx->ftl.metrics, interval);
+    printf("[SSD] Metrics sample interval: %u host writes\n", interval);
+}
+
+int ssd_export_metrics(const char* format, const char* filename) {
+    ensure_initialized();
+    
+    // 마지막 구간도 시계열에 포함되도록 export 직전에 한 번 샘플
+    ftl_metrics_sample(&g_ctx->ftl);
+    
+    int ret;
+    if (strcmp(format, "csv") == 0) {
+        ret = metrics_export_csv(&g_ctx->ftl.metrics, filename);
+    } else if (strcmp(format, "json") == 0) {
+        ret = metrics_export_json(&g_ctx->ftl.metrics, filename);
+    } else if (strcmp(format, "prom") == 0) {
+        ret = metrics_export_prometheus(&g_ctx->ftl.metrics, filename);
+    } else {
+        printf("[SSD] Unknown metrics format: %s (csv | json | prom)\n", format);
+        return -1;
+    }
+    
+    if (ret == 0) {
+        printf("[SSD] Metrics exported: %s (%s, %u samples)\n",
+               filename, format, g_ctx->ftl.metrics.sample_count);
     }
+    return ret;
 }
@@ -9,11 +9,92 @@
 // ==================== 기존 인터페이스 (testshell.c 호환) ====================
 unsigned int read(int idx);      // read 함수 원형
 void write(int idx, char* data); // write 함수 원형
+int ssd_write(int idx, char* data);          // write와 같고 성공 0 / 실패 -1
+int ssd_read(int idx, unsigned int* value);  // read와 같고 성공 0 / 실패(범위 밖, 데이터 없음) -1
+
+// ==================== Instance ====================
+// 위의 read / write와 아래 명령은 호출한 스레드가 고른 instance에 적용된다 (기본 = nand_flash.bin).
+typedef struct SsdContext SsdContext;
+SsdContext* ssd_open(const char* image_path);   // 독립 instance (NULL = 파일 없이 메모리만), 첫 명령에서 mount
+void ssd_close(SsdContext* ctx);                // 저장 후 해제
+SsdContext* ssd_use(SsdContext* ctx);           // 이 스레드가 쓸 instance 선택 (NULL = 기본), 이전 instance 반환
+void ssd_get_write_counters(unsigned long long* host_writes, unsigned long long* nand_writes);
+unsigned long long ssd_get_virtual_time_us(void); // NAND 명령이 쓴 모델 시간 합계
 
 // ==================== 확장 기능 (디버깅 및 통계) ====================
 void ssd_print_statistics();     // FTL + NAND 통계 출력
 void ssd_print_l2p_table();      // L2P 매핑 테이블 출력
 void ssd_force_gc();             // 강제 GC 발동
+int ssd_set_gc_watermarks(unsigned int low, unsigned int high); // GC 시작 / 회수 목표 free page %
+int ssd_set_gc_policy(const char* name, unsigned int param);   // NULL = 목록, param = window / d (0 = 그대로)
+void ssd_set_copyback(int enable);  // GC가 같은 plane 안의 이동에 copyback 사용
+void ssd_set_erase_mode(int lazy);  // lazy = erase 시 메타데이터만 초기화 (payload memset 생략)
+void ssd_erase_benchmark(unsigned int writes); // eager vs lazy erase 비용 / 시뮬레이션 처리량
+void ssd_set_metadata_only(int enable); // 호스트 데이터 page는 OOB + 4바이트 값만 보관
+void ssd_metadata_benchmark(unsigned int writes); // 전체 payload vs metadata-only 처리량 / 메모리
+void ssd_payload_benchmark(unsigned int capacity_gb, unsigned int pages); // 대용량 장치 일부만 쓸 때 메모리
+void ssd_save();                 // 지금까지의 상태를 이미지 파일에 반영 (바뀐 page만)
 void ssd_shutdown();             // 종료 시 영속성 저장
 
+// ==================== 매핑 방식 ====================
+int ssd_set_map_mode(const char* mode, unsigned int cmt_entries); // page | dftl | extent
+
+// ==================== 매핑 journal / 복구 ====================
+int ssd_set_journal(int enable);   // checkpoint + 매핑 journal on/off
+int ssd_checkpoint();              // 즉시 checkpoint 기록
+void ssd_recovery_benchmark();     // 전체 OOB 스캔 vs summary / checkpoint 복구 비교
+void ssd_set_summary(int enable);  // 블록별 summary page on/off
+void ssd_set_scan_threads(unsigned int threads); // mount 스캔 worker 수 (0 = 코어 수)
+
+// ==================== 압축 ====================
+int ssd_set_compress(int enable);  // 인라인 압축 + 여러 논리 페이지를 물리 페이지 하나에 패킹
+int ssd_set_subpage(unsigned int unit); // 서브 페이지 매핑 단위 (바이트, 0 = off)
+
+// ==================== SLC 캐시 ====================
+int ssd_set_slc_cache(unsigned int blocks);           // SLC 캐시 블록 수 (0 = off)
+void ssd_set_slc_policy(int fold_trigger, int bypass); // 음수 = 변경 없음
+void ssd_slc_fold();                                  // 캐시 전체 folding (유휴 시간)
+void ssd_slc_benchmark(unsigned int burst, unsigned int idle_ms, unsigned int rounds);
+
+// ==================== ZNS ====================
+int ssd_set_zns(int enable, unsigned int zone_blocks); // zone 인터페이스 on/off (일반 데이터가 있으면 포맷)
+int ssd_zone_command(const char* op, int zone);     // open | close | finish | reset | report
+int ssd_zone_append(int zone, char* data);          // 기록된 LBA 출력
+void ssd_zns_benchmark(unsigned int writes);        // 같은 쓰기 순서로 device FTL vs ZNS + 호스트 배치
+
+// ==================== Namespace / QoS ====================
+int ssd_ns_add(unsigned int pages, unsigned int pool_blocks); // 다음 LBA 구간에 namespace 추가 (pool 0 = 공유)
+void ssd_ns_clear();                                // namespace 제거 (전체 LBA / 공유 pool)
+void ssd_ns_list();                                 // namespace별 pool / QoS / WAF / 간섭 / 지연
+int ssd_ns_qos(int ns, unsigned int weight, unsigned int rate); // arbiter 가중치, 초당 명령 한도 (0 = 없음)
+void ssd_ns_write(int ns, int idx, char* data);     // namespace 안의 LBA로 쓰기
+unsigned int ssd_ns_read(int ns, int idx);
+void ssd_ns_benchmark(unsigned int writes);         // 공유 / 전용 pool / token bucket별 noisy neighbour 영향
+
+// ==================== I/O 스케줄러 ====================
+void ssd_sched_benchmark(unsigned int writes);      // FIFO vs read priority vs program/erase suspend read 지연
+
+// ==================== 이벤트 시뮬레이션 ====================
+void ssd_sim_run(unsigned int requests, unsigned int seed); // 가상 시간 이벤트 시뮬레이션 (같은 seed = 같은 결과)
+
+// ==================== 파라미터 sweep ====================
+int ssd_sweep(unsigned int writes, unsigned int threads, const char* csv_path); // 구성 격자를 모든 코어에서 (threads 0 = 코어 수)
+
+// GC 자동 조정 (tune.c)
+void ssd_autotune(int on);                      // 1 = 켬, 0 = 끔, 음수 = 상태 / 결정 기록
+void ssd_tune_benchmark(unsigned int writes);   // phase별 쓰기 수
+
+// ==================== 데이터 무결성 ====================
+void ssd_set_crc(int enable);      // page별 CRC32C 기록 / 검증 on/off
+void ssd_crc_benchmark();          // CRC 엔진 처리량 vs memcpy
+int ssd_corrupt(int idx);          // 장애 주입: LBA가 매핑된 page 비트 반전
+
+// ==================== 중복 제거 ====================
+int ssd_set_dedup(int enable);     // 내용이 같은 페이지를 하나의 물리 페이지로 공유
+
+// ==================== 메트릭 ====================
+void ssd_print_metrics();                                // 메트릭 요약 출력
+void ssd_set_metrics_interval(unsigned int interval);    // 샘플 주기 (host write 수, 0 = off)
+int ssd_export_metrics(const char* format, const char* filename); // csv | json | prom
+
 #endif // SSD_H
@@ -0,0 +1,68 @@
+/*
+ * summary.c - Per-Block Summary Page
+ */
+
+#include "summary.h"
+#include "ftl.h"
+#include <stdio.h>
+#include <string.h>
+
+bool summary_block_ready(FTL *ftl, uint32_t block_idx) {
+    uint32_t base = block_idx * PAGES_PER_BLOCK;
+    
+    if (nand_get_page_state(&ftl->nand, base + SUMMARY_PAGE) != PAGE_FREE) {
+        return false;
+    }
+    for (uint32_t p = 0; p < SUMMARY_PAGE; p++) {
+        if (nand_get_page_state(&ftl->nand, base + p) == PAGE_FREE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int summary_write(FTL *ftl, uint32_t block_idx) {
+    uint8_t buffer[PAGE_SIZE];
+    BlockSummary sum;
+    Block *block = &ftl->nand.blocks[block_idx];
+    
+    // 열린 블록의 (lba, seq)는 컨트롤러가 기록하면서 DRAM에 모아 두는 값
+    sum.magic = SUMMARY_MAGIC;
+    sum.block = block_idx;
+    sum.count = SUMMARY_PAGE;
+    for (uint32_t p = 0; p < SUMMARY_PAGE; p++) {
+        sum.entries[p].lba = block->pages[p].oob.lba;
+        sum.entries[p].seq = block->pages[p].oob.write_count;
+    }
+    
+    memset(buffer, 0xFF, PAGE_SIZE);
+    memcpy(buffer, &sum, sizeof(sum));
+    
+    uint32_t pba = block_idx * PAGES_PER_BLOCK + SUMMARY_PAGE;
+    if (nand_write_page(&ftl->nand, pba, buffer, LBA_TAG_SUMMARY | block_idx) != 0) {
+        fprintf(stderr, "[SUMMARY] Failed to write summary of block %u\n", block_idx);
+        return -1;
+    }
+    ftl->summary_pages++;
+    return 0;
+}
+
+int summary_read(NANDFlash *nand, uint32_t block_idx, BlockSummary *sum) {
+    uint32_t pba = block_idx * PAGES_PER_BLOCK + SUMMARY_PAGE;
+    uint8_t buffer[PAGE_SIZE];
+    OOB oob;
+    
+    if (nand_get_page_state(nand, pba) != PAGE_VALID) {
+        return -1;
+    }
+    if (nand_read_page_oob(nand, pba, buffer, &oob) != 0 ||
+        oob.lba != (LBA_TAG_SUMMARY | block_idx)) {
+        return -1;
+    }
+    
+    memcpy(sum, buffer, sizeof(BlockSummary));
+    if (sum->magic != SUMMARY_MAGIC || sum->block != block_idx || sum->count != SUMMARY_PAGE) {
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,49 @@
+/*
+ * summary.h - Per-Block Summary Page (F2FS SSA 방식)
+ *
+ * data 블록의 마지막 page를 summary로 예약하고, 나머지 page가 모두 기록되어
+ * 블록이 닫히는 순간 그 블록의 (lba, seq) 배열을 summary page에 기록한다.
+ * mount 시 닫힌 블록은 summary 한 장만 읽고, 열린 블록만 OOB를 전부 스캔한다.
+ *
+ * page의 유효 여부는 page 상태(validity bitmap)로 판단하므로,
+ * 블록이 닫힌 뒤의 invalidate는 summary를 다시 쓰지 않는다.
+ */
+
+#ifndef SUMMARY_H
+#define SUMMARY_H
+
+#include "nand_flash.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// ==================== SUMMARY CONFIGURATION ====================
+#define BLOCK_SUMMARY_DEFAULT   1                       // 기본 on (summary 명령어로 전환)
+#define SUMMARY_PAGE            (PAGES_PER_BLOCK - 1)   // 블록 내 summary 위치
+#define SUMMARY_MAGIC           0x53554D4D              // "SUMM"
+
+// ==================== DATA STRUCTURES ====================
+
+typedef struct {
+    uint32_t lba;           // OOB lba (메타데이터 태그 포함)
+    uint32_t seq;           // OOB write_count (기록 순서)
+} SummaryEntry;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t block;
+    uint32_t count;
+    SummaryEntry entries[SUMMARY_PAGE];
+} BlockSummary;
+
+struct FTL;
+
+// ==================== FUNCTION PROTOTYPES ====================
+
+// summary 자리를 제외한 모든 page가 기록됐고 summary는 아직 없는지
+bool summary_block_ready(struct FTL *ftl, uint32_t block_idx);
+int summary_write(struct FTL *ftl, uint32_t block_idx);
+
+// summary page 한 장 읽기 (summary가 없으면 -1)
+int summary_read(NANDFlash *nand, uint32_t block_idx, BlockSummary *sum);
+
+#endif // SUMMARY_H
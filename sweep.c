@@ -0,0 +1,212 @@
+/*
+ * sweep.c - Parameter Sweep Runner
+ */
+
+#include "sweep.h"
+#include "ftl.h"
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+
+// ==================== GRID ====================
+
+static const uint32_t sweep_op_pcts[] = { 44, 50, 60, 70 };
+static const uint32_t sweep_gc_lows[] = { 5, 10, 20 };
+static const SweepWorkload sweep_workloads[] = { SWEEP_UNIFORM, SWEEP_HOTCOLD, SWEEP_SEQUENTIAL };
+
+#define SWEEP_COUNT(a)  (sizeof(a) / sizeof((a)[0]))
+
+static const char *sweep_workload_name(SweepWorkload w) {
+    switch (w) {
+        case SWEEP_UNIFORM:    return "uniform";
+        case SWEEP_HOTCOLD:    return "hot/cold";
+        case SWEEP_SEQUENTIAL: return "sequential";
+    }
+    return "?";
+}
+
+static double sweep_clock(clockid_t id) {
+    struct timespec ts;
+    clock_gettime(id, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int sweep_cmp_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+// ==================== ONE CONFIGURATION ====================
+
+static void sweep_run_one(SweepResult *r, uint32_t writes) {
+    const SweepConfig *c = &r->cfg;
+    uint32_t span = TOTAL_PAGES * (100 - c->op_pct) / 100;
+    uint32_t *lat = malloc((size_t)(writes ? writes : 1) * sizeof(uint32_t));
+    FTL *ftl = malloc(sizeof(FTL));
+    uint8_t buf[PAGE_SIZE];
+    unsigned int seed = SWEEP_SEED;
+    double start = sweep_clock(CLOCK_THREAD_CPUTIME_ID);
+
+    if (span > TOTAL_LOGICAL_PAGES) span = TOTAL_LOGICAL_PAGES;
+    if (!lat || !ftl) {
+        free(lat);
+        free(ftl);
+        return;
+    }
+
+    // 구성마다 독립된 메모리 전용 instance
+    r->ok = ftl_init_at(ftl, NULL) == 0 &&
+            ftl_set_gc_policy(ftl, c->policy, 0) == 0 &&
+            ftl_set_gc_watermarks(ftl, c->gc_low, c->gc_low + SWEEP_WATERMARK_GAP) == 0;
+    memset(buf, 0, PAGE_SIZE);
+    for (uint32_t lba = 0; r->ok && lba < span; lba++) {
+        r->ok = ftl_write(ftl, lba, buf) == 0;
+    }
+
+    uint64_t w0 = ftl->nand.total_page_writes, e0 = ftl->nand.total_block_erases;
+    uint64_t g0 = ftl->total_gc_count, total = 0;
+    uint64_t s0 = ftl->gc_select_passes, ns0 = ftl->gc_policy.select_ns, b0 = ftl->gc_policy.scored;
+    uint32_t hot = span * SWEEP_HOT_PCT / 100;
+    for (uint32_t i = 0; r->ok && i < writes; i++) {
+        uint32_t lba;
+        if (c->workload == SWEEP_SEQUENTIAL) {
+            lba = i % span;
+        } else if (c->workload == SWEEP_HOTCOLD && (uint32_t)rand_r(&seed) % 100 < 80) {
+            lba = (uint32_t)rand_r(&seed) % hot;
+        } else {
+            lba = (uint32_t)rand_r(&seed) % span;
+        }
+        memcpy(buf, &i, sizeof(i));
+        uint64_t before = ftl->nand.vtime_us;
+        r->ok = ftl_write(ftl, lba, buf) == 0;
+        lat[i] = (uint32_t)(ftl->nand.vtime_us - before);
+        total += lat[i];
+    }
+
+    if (r->ok && writes) {
+        qsort(lat, writes, sizeof(uint32_t), sweep_cmp_u32);
+        r->waf = (double)(ftl->nand.total_page_writes - w0) / writes;
+        r->erases = ftl->nand.total_block_erases - e0;
+        r->gc_runs = ftl->total_gc_count - g0;
+        r->avg_us = (double)total / writes;
+        r->p99_us = lat[(uint32_t)((writes - 1) * 0.99)];
+        r->max_us = lat[writes - 1];
+        r->selections = ftl->gc_select_passes - s0;
+        r->select_ns = ftl->gc_policy.select_ns - ns0;
+        r->examined = ftl->gc_policy.scored - b0;
+    }
+    ftl_cleanup(ftl);
+    free(ftl);
+    free(lat);
+    r->cpu_s = sweep_clock(CLOCK_THREAD_CPUTIME_ID) - start;
+}
+
+// ==================== WORKERS ====================
+
+typedef struct {
+    SweepResult *results;
+    uint32_t count;
+    uint32_t writes;
+    uint32_t next;              // 다음에 가져갈 구성 (atomic)
+} SweepJob;
+
+static void *sweep_worker(void *arg) {
+    SweepJob *job = arg;
+    uint32_t i;
+
+    while ((i = __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED)) < job->count) {
+        sweep_run_one(&job->results[i], job->writes);
+    }
+    return NULL;
+}
+
+int sweep_run(uint32_t writes, uint32_t threads, const char *csv_path) {
+    uint32_t count = gc_policy_count() * SWEEP_COUNT(sweep_op_pcts) *
+                     SWEEP_COUNT(sweep_gc_lows) * SWEEP_COUNT(sweep_workloads);
+    SweepJob job = { calloc(count, sizeof(SweepResult)), count, writes, 0 };
+    pthread_t tids[64];
+    uint32_t i = 0;
+
+    if (!job.results) {
+        return -1;
+    }
+    for (uint32_t p = 0; p < gc_policy_count(); p++)
+        for (uint32_t o = 0; o < SWEEP_COUNT(sweep_op_pcts); o++)
+            for (uint32_t g = 0; g < SWEEP_COUNT(sweep_gc_lows); g++)
+                for (uint32_t w = 0; w < SWEEP_COUNT(sweep_workloads); w++) {
+                    SweepConfig c = { gc_policy_at(p)->name, sweep_op_pcts[o], sweep_gc_lows[g], sweep_workloads[w] };
+                    job.results[i++].cfg = c;
+                }
+
+    if (threads == 0) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cores > 0 ? (uint32_t)cores : 1;
+    }
+    if (threads > count) threads = count;
+    if (threads > SWEEP_COUNT(tids)) threads = SWEEP_COUNT(tids);
+
+    // FTL 로그는 구성마다 수천 줄이므로 실행 중에는 버림
+    printf("[Sweep] %u configurations x %u writes on %u threads...\n", count, writes, threads);
+    double start = sweep_clock(CLOCK_MONOTONIC);
+    int saved = bench_quiet_begin();
+    uint32_t started = 0;
+    for (; started < threads; started++) {
+        if (pthread_create(&tids[started], NULL, sweep_worker, &job) != 0) break;
+    }
+    if (started == 0) {
+        sweep_worker(&job);
+    }
+    for (uint32_t t = 0; t < started; t++) {
+        pthread_join(tids[t], NULL);
+    }
+    bench_quiet_end(saved);
+    double wall = sweep_clock(CLOCK_MONOTONIC) - start, cpu = 0.0;
+
+    printf("\n========== Parameter sweep (%u writes per configuration) ==========\n", writes);
+    printf("%-15s %4s %6s %-10s %6s %7s %6s %9s %9s %9s %8s %8s\n", "Policy", "OP%", "GC wm", "Workload",
+           "WAF", "erases", "GCs", "avg us", "p99 us", "max us", "blk/sel", "ns/sel");
+    for (i = 0; i < count; i++) {
+        SweepResult *r = &job.results[i];
+        char wm[16];
+        snprintf(wm, sizeof(wm), "%u-%u", r->cfg.gc_low, r->cfg.gc_low + SWEEP_WATERMARK_GAP);
+        cpu += r->cpu_s;
+        if (!r->ok) {
+            printf("%-15s %4u %6s %-10s %s\n", r->cfg.policy, r->cfg.op_pct, wm,
+                   sweep_workload_name(r->cfg.workload), "failed (out of space)");
+            continue;
+        }
+        printf("%-15s %4u %6s %-10s %6.2f %7lu %6lu %9.0f %9u %9u %8.1f %8.0f\n", r->cfg.policy, r->cfg.op_pct, wm,
+               sweep_workload_name(r->cfg.workload), r->waf, r->erases, r->gc_runs, r->avg_us,
+               r->p99_us, r->max_us, r->selections ? (double)r->examined / r->selections : 0.0,
+               r->selections ? (double)r->select_ns / r->selections : 0.0);
+    }
+    printf("Wall time: %.2f s on %u threads for %.2f s of simulation CPU time (%.1fx)\n",
+           wall, threads, cpu, wall > 0 ? cpu / wall : 0.0);
+
+    // 결과 CSV
+    const char *path = csv_path ? csv_path : SWEEP_CSV_DEFAULT;
+    FILE *fp = fopen(path, "w");
+    if (fp) {
+        fprintf(fp, "policy,op_pct,gc_low,gc_high,workload,ok,waf,erases,gc_runs,avg_us,p99_us,max_us,selections,blocks_per_sel,ns_per_sel,cpu_s\n");
+        for (i = 0; i < count; i++) {
+            SweepResult *r = &job.results[i];
+            fprintf(fp, "%s,%u,%u,%u,%s,%d,%.4f,%lu,%lu,%.1f,%u,%u,%lu,%.2f,%.0f,%.3f\n", r->cfg.policy,
+                    r->cfg.op_pct, r->cfg.gc_low, r->cfg.gc_low + SWEEP_WATERMARK_GAP,
+                    sweep_workload_name(r->cfg.workload), r->ok, r->waf, r->erases, r->gc_runs, r->avg_us,
+                    r->p99_us, r->max_us, r->selections,
+                    r->selections ? (double)r->examined / r->selections : 0.0,
+                    r->selections ? (double)r->select_ns / r->selections : 0.0, r->cpu_s);
+        }
+        fclose(fp);
+        printf("Results written to %s\n", path);
+    } else {
+        printf("[Sweep] Failed to write %s\n", path);
+    }
+    printf("===================================================================\n");
+    free(job.results);
+    return 0;
+}
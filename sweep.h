@@ -0,0 +1,54 @@
+/*
+ * sweep.h - Parameter Sweep Runner
+ *
+ * GC 정책(registry 전체) x over-provisioning x GC watermark x workload 격자의 각 구성을 독립된
+ * 메모리 전용 FTL instance에서 돌린다. worker 스레드가 남은 구성을 하나씩 가져가
+ * 모든 코어에서 동시에 실행하고, 결과는 구성 순서대로 표 / CSV로 합친다.
+ * 구성마다 같은 seed의 LBA 순서를 쓰므로 스레드 수와 관계없이 결과가 같다.
+ */
+
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <stdint.h>
+
+// ==================== SWEEP CONFIGURATION ====================
+#define SWEEP_SEED              42
+#define SWEEP_WATERMARK_GAP     5           // high watermark = low + gap
+#define SWEEP_HOT_PCT           20          // hot/cold: 쓰기 80%가 앞쪽 20% LBA로
+#define SWEEP_CSV_DEFAULT       "sweep_results.csv"
+
+typedef enum {
+    SWEEP_UNIFORM = 0,
+    SWEEP_HOTCOLD,
+    SWEEP_SEQUENTIAL
+} SweepWorkload;
+
+typedef struct {
+    const char *policy;         // GC victim 정책
+    uint32_t op_pct;            // over-provisioning = 1 - 사용 LBA / 물리 page
+    uint32_t gc_low;            // GC 시작 free page %
+    SweepWorkload workload;
+} SweepConfig;
+
+typedef struct {
+    SweepConfig cfg;
+    int ok;
+    double waf;                 // 채우기 이후 구간
+    uint64_t erases;
+    uint64_t gc_runs;
+    double avg_us;              // 쓰기당 가상 시간
+    uint32_t p99_us;
+    uint32_t max_us;
+    uint64_t selections;        // victim 선택 횟수
+    uint64_t select_ns;         // victim 선택에 쓴 CPU 시간 (정책 비용)
+    uint64_t examined;          // 선택에서 본 블록 수
+    double cpu_s;               // 이 구성에 쓴 스레드 CPU 시간
+} SweepResult;
+
+// ==================== FUNCTION PROTOTYPES ====================
+
+// threads = 0이면 코어 수, csv_path = NULL이면 SWEEP_CSV_DEFAULT
+int sweep_run(uint32_t writes, uint32_t threads, const char *csv_path);
+
+#endif // SWEEP_H
@@ -10,7 +10,14 @@
 #include <stdlib.h>
 #include <string.h>
 #include "ftl.h"   // FTL 타입 알기 위해
-extern FTL g_ftl;  // 다른 .c 파일에 있는 전역 변수 사용 선언
+#include "crashtest.h"
+#include "sim.h"
+#include "bench.h"
+#include <time.h>
+
+#define CMD_LINE_MAX        1000
+#define SCRIPT_LINES_MAX    4096
+#define SCRIPT_DEPTH_MAX    8       // loop 중첩
 
 
 void fullwrite(char* data) {
@@ -35,7 +42,8 @@ void testapp1() {
     fullread();
 }
 
-void testapp2() {
+// 검증 실패가 하나라도 있으면 -1
+int testapp2() {
     char* aging_value = "0xAAAABBBB";
     char* overwrite_value = "0x12345678";
     
@@ -64,6 +72,7 @@ void testapp2() {
     
     // Read 및 비교 수행
     printf("\n값 검증 중...\n");
+    int failed = 0;
     for (int idx = 0; idx < 6; idx++) {
         unsigned int value = read(idx);
         unsigned int expected;
@@ -72,16 +81,18 @@ void testapp2() {
             printf("  LBA %d: PASS (0x%08X)\n", idx, value);
         } else {
             printf("  LBA %d: FAIL (Expected 0x%08X, Got 0x%08X)\n", idx, expected, value);
+            failed++;
         }
     }
     
     // 최종 통계
     printf("\n=== 최종 통계 ===\n");
     ssd_print_statistics();
+    return failed ? -1 : 0;
 }
 
-// NEW: TestApp3 - GC 동작 검증
-void testapp3() {
+// NEW: TestApp3 - GC 동작 검증 (실패가 하나라도 있으면 -1)
+int testapp3() {
     printf("[TestApp3] GC(Garbage Collection) 동작 테스트\n\n");
     
     // Step 1: LBA 0~50에 초기 데이터 쓰기
@@ -111,6 +122,7 @@ void testapp3() {
     
     // Step 3: 데이터 무결성 검증
     printf("\nStep 3: 데이터 무결성 검증 (LBA 0~10)\n");
+    int failed = 0;
     for (int i = 0; i <= 10; i++) {
         unsigned int value = read(i);
         unsigned int expected = 10 * 1000 + i; // 마지막 round 값
@@ -118,8 +130,10 @@ void testapp3() {
             printf("  LBA %d: PASS\n", i);
         } else {
             printf("  LBA %d: FAIL (Expected 0x%08X, Got 0x%08X)\n", i, expected, value);
+            failed++;
         }
     }
+    return failed ? -1 : 0;
 }
 /*
 void testapp4() {
@@ -300,8 +314,8 @@ void testapp4() {
         // 라운드마다 저장
         if ((round + 1) % STEP == 0) {
 
-            uint64_t cur_host = g_ftl.total_host_writes;
-            uint64_t cur_nand = g_ftl.nand.total_page_writes;
+            unsigned long long cur_host, cur_nand;
+            ssd_get_write_counters(&cur_host, &cur_nand);
 
             uint64_t dh = cur_host - prev_host;
             uint64_t dn = cur_nand - prev_nand;
@@ -379,8 +393,8 @@ void testapp4() {
         }
 
         if ((round + 1) % STEP == 0) {
-            uint64_t cur_host = g_ftl.total_host_writes;
-            uint64_t cur_nand = g_ftl.nand.total_page_writes;
+            unsigned long long cur_host, cur_nand;
+            ssd_get_write_counters(&cur_host, &cur_nand);
 
             uint64_t dh = cur_host - prev_host;
             uint64_t dn = cur_nand - prev_nand;
@@ -401,13 +415,16 @@ void testapp4() {
     }
 }
 */
-void executecommand(char *cmd) {
+static unsigned int last_read_value;    // 마지막 R 결과 (스크립트 expect가 비교)
+
+// 성공 0, 실패(잘못된 입력 / 명령 실패) -1
+int executecommand(char *cmd) {
     // 명령어 파싱
     char* token = strtok(cmd, " ");
     
     if (token == NULL) {
         printf("명령어가 잘못되었습니다.\n");
-        return;
+        return -1;
     }
     
     if (strcmp(token, "W") == 0) {
@@ -418,14 +435,14 @@ void executecommand(char *cmd) {
         
         if (idx < 0 || idx > 999) {
             printf("할당된 범위 밖입니다 (0~999)\n");
-            return;
+            return -1;
         }
         if (strlen(data) != 10) {
             printf("값이 잘못 입력되었습니다 (형식: 0xXXXXXXXX)\n");
-            return;
+            return -1;
         }
         
-        write(idx, data);
+        return ssd_write(idx, data);
     }
     else if (strcmp(token, "R") == 0) {
         token = strtok(NULL, " ");  // idx 가져옴
@@ -433,10 +450,10 @@ void executecommand(char *cmd) {
         
         if (idx < 0 || idx > 999) {
             printf("할당된 범위 밖입니다 (0~999)\n");
-            return;
+            return -1;
         }
         
-        read(idx);
+        return ssd_read(idx, &last_read_value);
     }
     else if (strcmp(token, "help") == 0) {
         printf("==================== 사용 가능한 명령어 ====================\n");
@@ -450,10 +467,55 @@ void executecommand(char *cmd) {
         printf("  testapp1         - Full Write/Read 검증\n");
         printf("  testapp2         - Aging Write 및 Over Write 검증\n");
         printf("  testapp3         - GC 동작 검증 (NEW)\n");
+        printf("  crashtest [N]    - 쓰기 도중 SIGKILL 후 복구 검증 (journal off/on 각 N회)\n");
         printf("\n디버깅 명령어 (NEW):\n");
         printf("  stats            - FTL 및 NAND 통계 출력 (WAF 포함)\n");
+        printf("  save             - 현재 상태를 nand_flash.bin에 반영 (바뀐 page만 쓰고 지운 블록은 hole)\n");
         printf("  l2p              - L2P 매핑 테이블 출력\n");
         printf("  gc               - 강제 GC 발동\n");
+        printf("  gcwm <low> <high> - free page가 low%% 미만이면 GC 시작, high%%까지 여러 블록 회수\n");
+        printf("  gcpolicy [name] [n] - GC victim 정책 목록 / 변경 (greedy, cost-benefit, windowed-greedy, fifo, d-choices; n = window / d)\n");
+        printf("  copyback <on|off> - GC 이동을 같은 plane 안에서는 die 내부 copyback으로\n");
+        printf("  erase <lazy|eager> - lazy = erase 시 OOB만 초기화, eager = block 전체 memset\n");
+        printf("  erasebench [N]   - 새 NAND에서 N회 무작위 쓰기로 eager / lazy erase 비교\n");
+        printf("  payload <full|meta> - meta = 호스트 데이터 page는 OOB와 4바이트 값만 보관\n");
+        printf("  metabench [N]    - 새 NAND에서 N회 무작위 쓰기로 full / metadata-only 비교\n");
+        printf("  sparsebench <GB> <pages> - GB 용량 payload 저장소에 pages개만 쓸 때 실제 메모리\n");
+        printf("  mapmode <page|dftl|extent> [cmt] - L2P 매핑 방식 전환 (dftl: CMT 엔트리 수)\n");
+        printf("  compress <on|off> - 인라인 압축 + packed page (논리 페이지 여러 장을 한 page에)\n");
+        printf("  subpage <unit|off> - 서브 페이지 매핑 (작은 쓰기를 unit 바이트 slot으로 모아 program)\n");
+        printf("  slc <blocks|off> - SLC 쓰기 캐시 블록 수 (호스트 쓰기를 먼저 받고 TLC로 folding)\n");
+        printf("  slc trigger <%%>  - 캐시 사용률이 이 이상이면 background folding\n");
+        printf("  slc bypass <on|off> - 캐시가 가득 차면 TLC에 바로 기록 (off = folding 대기)\n");
+        printf("  slc fold         - 캐시 전체 folding\n");
+        printf("  slcbench <burst> <idle_ms> [rounds] - burst 흡수 / 처리량 절벽 측정\n");
+        printf("  zns <on [blocks]|off> - zone 인터페이스 (W는 write pointer에만, device GC 없음)\n");
+        printf("  zone <open|close|finish|reset> <zone> - zone 상태 전환, zone report = 전체 zone 표시\n");
+        printf("  zappend <zone> <data> - Zone Append (device가 정한 LBA 출력)\n");
+        printf("  znsbench [N]     - 같은 쓰기 순서로 device FTL vs ZNS + 호스트 배치 WAF / 지연 비교\n");
+        printf("  ns add <pages> [blocks] - 다음 LBA 구간에 namespace 추가 (blocks = 전용 pool, 생략 시 공유)\n");
+        printf("  ns <list|clear>  - namespace별 WAF / GC 이동 / 간섭 / 지연, 또는 전체 제거\n");
+        printf("  ns qos <ns> <weight> [rate] - arbiter 가중치와 초당 명령 한도 (token bucket)\n");
+        printf("  nsw <ns> <idx> <data> / nsr <ns> <idx> - namespace 안의 LBA로 쓰기 / 읽기\n");
+        printf("  nsbench [N]      - 순차 tenant + noisy 무작위 tenant: 공유 / 전용 pool / token bucket 비교\n");
+        printf("  schedbench [N]   - GC가 잦은 N회 쓰기 중 read 지연: FIFO / read priority / suspend 비교\n");
+        printf("  simrun [N] [seed] - 이벤트 엔진으로 N개 요청을 가상 시간에 처리 (두 번 돌려 재현성 확인)\n");
+        printf("  sweep [N] [threads] [csv] - GC 정책 x OP x watermark x workload 격자를 instance별로 병렬 실행\n");
+        printf("  autotune [on|off] - 구간 WAF / victim valid 비율 / 쓰기 skew로 GC 정책과 watermark 자동 조정 (인자 없으면 상태와 결정 기록)\n");
+        printf("  tunebench [N]    - phase마다 hotspot이 바뀌는 쓰기(phase당 N개)를 고정 설정들과 자동 조정으로 비교\n");
+        printf("  crc <on|off>     - page별 CRC32C 기록 / 읽기 검증\n");
+        printf("  crcbench         - CRC32C 엔진(hw / slice-by-8) 처리량 vs memcpy\n");
+        printf("  corrupt <idx>    - 장애 주입: LBA가 매핑된 page 비트 반전\n");
+        printf("  dedup <on|off>   - 내용 해시 기반 중복 제거 계층\n");
+        printf("  journal <on|off> - checkpoint + 매핑 journal (빠른 mount 복구)\n");
+        printf("  checkpoint       - 즉시 checkpoint 기록\n");
+        printf("  summary <on|off> - 블록 마지막 page에 (lba, seq) summary 기록\n");
+        printf("  scanthreads <N>  - 복구 스캔 worker 스레드 수 (0 = 코어 수)\n");
+        printf("  recoverybench    - 전체 OOB 스캔 vs summary / checkpoint 복구 시간 비교\n");
+        printf("\n메트릭:\n");
+        printf("  metrics                      - 메트릭 요약 출력\n");
+        printf("  metrics interval <N>         - host write N회마다 시계열 샘플 (0 = off)\n");
+        printf("  metrics export <fmt> <file>  - csv | json | prom 형식으로 내보내기\n");
         printf("===========================================================\n");
     }
     else if (strcmp(token, "fullread") == 0) {
@@ -463,14 +525,14 @@ void executecommand(char *cmd) {
         token = strtok(NULL, " ");  // 데이터 가져옴
         if (token == NULL || strlen(token) != 10 || token[0] != '0' || token[1] != 'x') {
             printf("잘못된 입력 값입니다 (형식: 0xXXXXXXXX)\n");
-            return;
+            return -1;
         }
         for (int i = 2; i < 10; i++) {
             if (!((token[i] >= '0' && token[i] <= '9') || 
                   (token[i] >= 'A' && token[i] <= 'F') ||
                   (token[i] >= 'a' && token[i] <= 'f'))) {
                 printf("값은 0~9, A~F만 허용됩니다.\n");
-                return;
+                return -1;
             }
         }
         fullwrite(token);
@@ -479,14 +541,21 @@ void executecommand(char *cmd) {
         testapp1();
     }
     else if (strcmp(token, "testapp2") == 0) {
-        testapp2();
+        return testapp2();
     }
     else if (strcmp(token, "testapp3") == 0) {  // NEW
-        testapp3();
+        return testapp3();
     }
     else if (strcmp(token, "testapp4") == 0) {
     testapp4();
     }
+    else if (strcmp(token, "crashtest") == 0) {
+        char* arg = strtok(NULL, " ");
+        crash_test_run(arg ? atoi(arg) : 5);
+    }
+    else if (strcmp(token, "save") == 0) {
+        ssd_save();
+    }
     else if (strcmp(token, "stats") == 0) {  // NEW
         ssd_print_statistics();
     }
@@ -496,12 +565,619 @@ void executecommand(char *cmd) {
     else if (strcmp(token, "gc") == 0) {  // NEW
         ssd_force_gc();
     }
+    else if (strcmp(token, "gcwm") == 0) {
+        char* low = strtok(NULL, " ");
+        char* high = strtok(NULL, " ");
+        if (low == NULL || high == NULL) {
+            printf("사용법: gcwm <low%%> <high%%>\n");
+            return -1;
+        }
+        return ssd_set_gc_watermarks((unsigned int)atoi(low), (unsigned int)atoi(high)) < 0 ? -1 : 0;
+    }
+    else if (strcmp(token, "gcpolicy") == 0) {
+        char* name = strtok(NULL, " ");
+        char* param = strtok(NULL, " ");
+        return ssd_set_gc_policy(name, param ? (unsigned int)atoi(param) : 0) < 0 ? -1 : 0;
+    }
+    else if (strcmp(token, "copyback") == 0) {
+        char* arg = strtok(NULL, " ");
+        if (arg == NULL || (strcmp(arg, "on") != 0 && strcmp(arg, "off") != 0)) {
+            printf("사용법: copyback <on|off>\n");
+            return -1;
+        }
+        ssd_set_copyback(strcmp(arg, "on") == 0);
+    }
+    else if (strcmp(token, "erase") == 0) {
+        char* arg = strtok(NULL, " ");
+        if (arg == NULL || (strcmp(arg, "lazy") != 0 && strcmp(arg, "eager") != 0)) {
+            printf("사용법: erase <lazy|eager>\n");
+            return -1;
+        }
+        ssd_set_erase_mode(strcmp(arg, "lazy") == 0);
+    }
+    else if (strcmp(token, "erasebench") == 0) {
+        char* arg = strtok(NULL, " ");
+        ssd_erase_benchmark(arg ? (unsigned int)atoi(arg) : 20000);
+    }
+    else if (strcmp(token, "payload") == 0) {
+        char* arg = strtok(NULL, " ");
+        if (arg == NULL || (strcmp(arg, "full") != 0 && strcmp(arg, "meta") != 0)) {
+            printf("사용법: payload <full|meta>\n");
+            return -1;
+        }
+        ssd_set_metadata_only(strcmp(arg, "meta") == 0);
+    }
+    else if (strcmp(token, "metabench") == 0) {
+        char* arg = strtok(NULL, " ");
+        ssd_metadata_benchmark(arg ? (unsigned int)atoi(arg) : 20000);
+    }
+    else if (strcmp(token, "sparsebench") == 0) {
+        char* gb = strtok(NULL, " ");
+        char* pages = strtok(NULL, " ");
+        if (gb == NULL || pages == NULL) {
+            printf("사용법: sparsebench <GB> <pages>\n");
+            return -1;
+        }
+        ssd_payload_benchmark((unsigned int)atoi(gb), (unsigned int)atoi(pages));
+    }
+    else if (strcmp(token, "mapmode") == 0) {
+        char* mode = strtok(NULL, " ");
+        char* cmt = strtok(NULL, " ");
+        if (mode == NULL) {
+            printf("사용법: mapmode <page|dftl|extent> [cmt_entries]\n");
+            return -1;
+        }
+        return ssd_set_map_mode(mode, cmt ? (unsigned int)atoi(cmt) : 0) < 0 ? -1 : 0;
+    }
+    else if (strcmp(token, "compress") == 0) {
+        char* arg = strtok(NULL, " ");
+        if (arg == NULL || (strcmp(arg, "on") != 0 && strcmp(arg, "off") != 0)) {
+            printf("사용법: compress <on|off>\n");
+            return -1;
+        }
+        return ssd_set_compress(strcmp(arg, "on") == 0) < 0 ? -1 : 0;
+    }
+    else if (strcmp(token, "subpage") == 0) {
+        char* arg = strtok(NULL, " ");
+        if (arg == NULL) {
+            printf("사용법: subpage <unit|off> (unit = 64~1024 바이트)\n");
+            return -1;
+        }
+        return ssd_set_subpage(strcmp(arg, "off") == 0 ? 0 : (unsigned int)atoi(arg)) < 0 ? -1 : 0;
+    }
+    else if (strcmp(token, "slc") == 0) {
+        char* arg = strtok(NULL, " ");
+        char* val = arg ? strtok(NULL, " ") : NULL;
+        if (arg == NULL) {
+            printf("사용법: slc <blocks|off> | slc trigger <%%> | slc bypass <on|off> | slc fold\n");
+            return -1;
+        }
+        if (strcmp(arg, "trigger") == 0 && val) {
+            ssd_set_slc_policy(atoi(val), -1);
+        }
+        else if (strcmp(arg, "bypass") == 0 && val) {
+            ssd_set_slc_policy(-1, strcmp(val, "on") == 0);
+        }
+        else if (strcmp(arg, "fold") == 0) {
+            ssd_slc_fold();
+        }
+        else {
+            return ssd_set_slc_cache(strcmp(arg, "off") == 0 ? 0 : (unsigned int)atoi(arg)) < 0 ? -1 : 0;
+        }
+    }
+    else if (strcmp(token, "slcbench") == 0) {
+        char* burst = strtok(NULL, " ");
+        char* idle = strtok(NULL, " ");
+        char* rounds = strtok(NULL, " ");
+        if (burst == NULL || idle == NULL) {
+            printf("사용법: slcbench <burst> <idle_ms> [rounds]\n");
+            return -1;
+        }
+        ssd_slc_benchmark((unsigned int)atoi(burst), (unsigned int)atoi(idle),
+                          rounds ? (unsigned int)atoi(rounds) : 4);
+    }
+    else if (strcmp(token, "zns") == 0) {
+        char* arg = strtok(NULL, " ");
+        char* blocks = arg ? strtok(NULL, " ") : NULL;
+        if (arg == NULL || (strcmp(arg, "on") != 0 && strcmp(arg, "off") != 0)) {
+            printf("사용법: zns <on [zone_blocks]|off>\n");
+            return -1;
+        }
+        return ssd_set_zns(strcmp(arg, "on") == 0, blocks ? (unsigned int)atoi(blocks) : ZNS_ZONE_BLOCKS_DEFAULT) < 0 ? -1 : 0;
+    }
+    else if (strcmp(token, "zone") == 0) {
+        char* op = strtok(NULL, " ");
+        char* zone = op ? strtok(NULL, " ") : NULL;
+        if (op == NULL || (strcmp(op, "report") != 0 && zone == NULL)) {
+            printf("사용법: zone <open|close|finish|reset> <zone> | zone report\n");
+            return -1;
+        }
+        return ssd_zone_command(op, zone ? atoi(zone) : -1) < 0 ? -1 : 0;
+    }
+    else if (strcmp(token, "zappend") == 0) {
+        char* zone = strtok(NULL, " ");
+        char* data = zone ? strtok(NULL, " ") : NULL;
+        if (zone == NULL || data == NULL) {
+            printf("사용법: zappend <zone> <data>\n");
+            return -1;
+        }
+        return ssd_zone_append(atoi(zone), data) < 0 ? -1 : 0;
+    }
+    else if (strcmp(token, "znsbench") == 0) {
+        char* arg = strtok(NULL, " ");
+        ssd_zns_benchmark(arg ? (unsigned int)atoi(arg) : 20000);
+    }
+    else if (strcmp(token, "ns") == 0) {
+        char* op = strtok(NULL, " ");
+        char* a1 = op ? strtok(NULL, " ") : NULL;
+        char* a2 = a1 ? strtok(NULL, " ") : NULL;
+        char* a3 = a2 ? strtok(NULL, " ") : NULL;
+        if (op && strcmp(op, "add") == 0 && a1) {
+            return ssd_ns_add((unsigned int)atoi(a1), a2 ? (unsigned int)atoi(a2) : 0) < 0 ? -1 : 0;
+        } else if (op && strcmp(op, "qos") == 0 && a2) {
+            return ssd_ns_qos(atoi(a1), (unsigned int)atoi(a2), a3 ? (unsigned int)atoi(a3) : 0) < 0 ? -1 : 0;
+        } else if (op && strcmp(op, "list") == 0) {
+            ssd_ns_list();
+        } else if (op && strcmp(op, "clear") == 0) {
+            ssd_ns_clear();
+        } else {
+            printf("사용법: ns add <pages> [pool_blocks] | ns qos <ns> <weight> [rate] | ns list | ns clear\n");
+            return -1;
+        }
+    }
+    else if (strcmp(token, "nsw") == 0) {
+        char* ns = strtok(NULL, " ");
+        char* idx = ns ? strtok(NULL, " ") : NULL;
+        char* data = idx ? strtok(NULL, " ") : NULL;
+        if (data == NULL) {
+            printf("사용법: nsw <ns> <idx> <data>\n");
+            return -1;
+        }
+        ssd_ns_write(atoi(ns), atoi(idx), data);
+    }
+    else if (strcmp(token, "nsr") == 0) {
+        char* ns = strtok(NULL, " ");
+        char* idx = ns ? strtok(NULL, " ") : NULL;
+        if (idx == NULL) {
+            printf("사용법: nsr <ns> <idx>\n");
+            return -1;
+        }
+        ssd_ns_read(atoi(ns), atoi(idx));
+    }
+    else if (strcmp(token, "nsbench") == 0) {
+        char* arg = strtok(NULL, " ");
+        ssd_ns_benchmark(arg ? (unsigned int)atoi(arg) : 20000);
+    }
+    else if (strcmp(token, "schedbench") == 0) {
+        char* arg = strtok(NULL, " ");
+        ssd_sched_benchmark(arg ? (unsigned int)atoi(arg) : 20000);
+    }
+    else if (strcmp(token, "simrun") == 0) {
+        char* arg = strtok(NULL, " ");
+        char* seed = arg ? strtok(NULL, " ") : NULL;
+        ssd_sim_run(arg ? (unsigned int)atoi(arg) : 20000, seed ? (unsigned int)atoi(seed) : SIM_SEED_DEFAULT);
+    }
+    else if (strcmp(token, "sweep") == 0) {
+        char* arg = strtok(NULL, " ");
+        char* threads = arg ? strtok(NULL, " ") : NULL;
+        char* csv = threads ? strtok(NULL, " ") : NULL;
+        return ssd_sweep(arg ? (unsigned int)atoi(arg) : 20000, threads ? (unsigned int)atoi(threads) : 0, csv) < 0 ? -1 : 0;
+    }
+    else if (strcmp(token, "autotune") == 0) {
+        char* arg = strtok(NULL, " ");
+        if (arg != NULL && strcmp(arg, "on") != 0 && strcmp(arg, "off") != 0) {
+            printf("사용법: autotune [on|off]\n");
+            return -1;
+        }
+        ssd_autotune(arg ? strcmp(arg, "on") == 0 : -1);
+    }
+    else if (strcmp(token, "tunebench") == 0) {
+        char* arg = strtok(NULL, " ");
+        ssd_tune_benchmark(arg ? (unsigned int)atoi(arg) : 25000);
+    }
+    else if (strcmp(token, "crc") == 0) {
+        char* arg = strtok(NULL, " ");
+        if (arg == NULL || (strcmp(arg, "on") != 0 && strcmp(arg, "off") != 0)) {
+            printf("사용법: crc <on|off>\n");
+            return -1;
+        }
+        ssd_set_crc(strcmp(arg, "on") == 0);
+    }
+    else if (strcmp(token, "crcbench") == 0) {
+        ssd_crc_benchmark();
+    }
+    else if (strcmp(token, "corrupt") == 0) {
+        char* arg = strtok(NULL, " ");
+        if (arg == NULL) {
+            printf("사용법: corrupt <idx>\n");
+            return -1;
+        }
+        return ssd_corrupt(atoi(arg)) < 0 ? -1 : 0;
+    }
+    else if (strcmp(token, "dedup") == 0) {
+        char* arg = strtok(NULL, " ");
+        if (arg == NULL || (strcmp(arg, "on") != 0 && strcmp(arg, "off") != 0)) {
+            printf("사용법: dedup <on|off>\n");
+            return -1;
+        }
+        return ssd_set_dedup(strcmp(arg, "on") == 0) < 0 ? -1 : 0;
+    }
+    else if (strcmp(token, "journal") == 0) {
+        char* arg = strtok(NULL, " ");
+        if (arg == NULL || (strcmp(arg, "on") != 0 && strcmp(arg, "off") != 0)) {
+            printf("사용법: journal <on|off>\n");
+            return -1;
+        }
+        return ssd_set_journal(strcmp(arg, "on") == 0) < 0 ? -1 : 0;
+    }
+    else if (strcmp(token, "checkpoint") == 0) {
+        return ssd_checkpoint() < 0 ? -1 : 0;
+    }
+    else if (strcmp(token, "summary") == 0) {
+        char* arg = strtok(NULL, " ");
+        if (arg == NULL || (strcmp(arg, "on") != 0 && strcmp(arg, "off") != 0)) {
+            printf("사용법: summary <on|off>\n");
+            return -1;
+        }
+        ssd_set_summary(strcmp(arg, "on") == 0);
+    }
+    else if (strcmp(token, "scanthreads") == 0) {
+        char* arg = strtok(NULL, " ");
+        if (arg == NULL) {
+            printf("사용법: scanthreads <N>\n");
+            return -1;
+        }
+        ssd_set_scan_threads((unsigned int)atoi(arg));
+    }
+    else if (strcmp(token, "recoverybench") == 0) {
+        ssd_recovery_benchmark();
+    }
+    else if (strcmp(token, "metrics") == 0) {
+        char* sub = strtok(NULL, " ");
+        
+        if (sub == NULL) {
+            ssd_print_metrics();
+        }
+        else if (strcmp(sub, "interval") == 0) {
+            char* arg = strtok(NULL, " ");
+            if (arg == NULL) {
+                printf("사용법: metrics interval <N>\n");
+                return -1;
+            }
+            ssd_set_metrics_interval((unsigned int)atoi(arg));
+        }
+        else if (strcmp(sub, "export") == 0) {
+            char* format = strtok(NULL, " ");
+            char* filename = strtok(NULL, " ");
+            if (format == NULL || filename == NULL) {
+                printf("사용법: metrics export <csv|json|prom> <file>\n");
+                return -1;
+            }
+            return ssd_export_metrics(format, filename) < 0 ? -1 : 0;
+        }
+        else {
+            printf("사용법: metrics [interval <N> | export <fmt> <file>]\n");
+            return -1;
+        }
+    }
     else {
         printf("알 수 없는 명령어입니다. 'help'를 입력하세요.\n");
+        return -1;
+    }
+    return 0;
+}
+
+// ==================== BATCH MODE ====================
+// ssd_simulator -f script.txt [-v] [-i image]
+//   한 줄에 명령어 하나, '#' 뒤는 주석. 추가 문법:
+//   repeat N <명령>     명령을 N번 ($i = 0 ~ N-1)
+//   loop N ... end      블록을 N번 (중첩 가능, $i = 가장 안쪽 반복 번호)
+//   show <명령>         이 명령은 출력을 보여 줌 (나머지는 -v가 없으면 출력을 버림)
+//   expect 0xXXXXXXXX R <idx>   읽은 값이 다르면 실패
+//   expect fail <명령>  명령이 실패해야 통과
+//   exit                스크립트 종료
+// repeat 안에도 show / expect를 쓸 수 있다 (repeat 900 expect 0x0000ABCD R $i).
+// 명령이 실패하거나 expect가 어긋나면 그 줄을 stderr에 출력하고 멈추며, 종료 코드는 1 (make test 실패)
+// 기본은 이미지 파일 없는 새 instance라 같은 스크립트는 항상 같은 결과를 낸다 (-i로 이미지 사용)
+
+typedef struct {
+    char text[CMD_LINE_MAX];
+    uint32_t lineno;
+    uint32_t end;           // loop: 짝이 되는 end 줄의 index
+    uint64_t runs;
+    double wall_s;
+    uint64_t sim_us;
+} ScriptLine;
+
+typedef struct {
+    ScriptLine *lines;
+    uint32_t count;
+    bool verbose;
+    bool stop;              // exit를 만남 / 실패
+    int saved_stdout;       // 출력을 버리는 동안 원래 stdout (-v면 -1)
+    bool failed;            // 실패한 명령 또는 expect가 있었음
+    const char* path;
+} Script;
+
+static double script_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// 앞 단어가 keyword면 나머지를 반환
+static const char* script_keyword(const char* text, const char* keyword) {
+    size_t n = strlen(keyword);
+    if (strncmp(text, keyword, n) != 0 || (text[n] != ' ' && text[n] != '\0')) {
+        return NULL;
+    }
+    return text + n + strspn(text + n, " ");
+}
+
+// expect 인자 확인: "fail <명령>" 또는 "0xXXXXXXXX R <idx>"
+static bool script_expect_valid(const char* arg) {
+    const char* cmd;
+    if ((cmd = script_keyword(arg, "fail")) != NULL) {
+        return *cmd != '\0';
+    }
+    unsigned int value;
+    char tail;
+    return sscanf(arg, "0x%8x%c", &value, &tail) == 2 && tail == ' ' &&
+           script_keyword(arg + 11, "R") != NULL;
+}
+
+static int script_load(Script* sc, const char* path) {
+    FILE* fp = fopen(path, "r");
+    char buf[CMD_LINE_MAX];
+    uint32_t stack[SCRIPT_DEPTH_MAX], depth = 0, lineno = 0;
+
+    if (fp == NULL) {
+        fprintf(stderr, "[Script] Cannot open %s\n", path);
+        return -1;
+    }
+    sc->lines = calloc(SCRIPT_LINES_MAX, sizeof(ScriptLine));
+    if (sc->lines == NULL) {
+        fclose(fp);
+        return -1;
+    }
+    while (fgets(buf, sizeof(buf), fp) != NULL) {
+        lineno++;
+        if (strchr(buf, '\n') == NULL && !feof(fp)) {
+            fprintf(stderr, "[Script] %s:%u: line longer than %d characters\n", path, lineno, CMD_LINE_MAX - 1);
+            goto fail;
+        }
+        buf[strcspn(buf, "#\r\n")] = '\0';
+        char* text = buf + strspn(buf, " \t");
+        size_t len = strlen(text);
+        while (len > 0 && (text[len - 1] == ' ' || text[len - 1] == '\t')) text[--len] = '\0';
+        if (len == 0) continue;
+
+        if (sc->count == SCRIPT_LINES_MAX) {
+            fprintf(stderr, "[Script] %s: more than %d commands\n", path, SCRIPT_LINES_MAX);
+            goto fail;
+        }
+        ScriptLine* l = &sc->lines[sc->count];
+        strcpy(l->text, text);
+        l->lineno = lineno;
+
+        const char* arg = script_keyword(text, "loop");
+        if (arg != NULL) {
+            if (atoi(arg) <= 0 || depth == SCRIPT_DEPTH_MAX) {
+                fprintf(stderr, "[Script] %s:%u: need 'loop N' with N > 0 (at most %d levels)\n",
+                        path, lineno, SCRIPT_DEPTH_MAX);
+                goto fail;
+            }
+            stack[depth++] = sc->count;
+        } else if (strcmp(text, "end") == 0) {
+            if (depth == 0) {
+                fprintf(stderr, "[Script] %s:%u: 'end' without 'loop'\n", path, lineno);
+                goto fail;
+            }
+            sc->lines[stack[--depth]].end = sc->count;
+        } else if ((arg = script_keyword(text, "repeat")) != NULL &&
+                   (atoi(arg) <= 0 || strchr(arg, ' ') == NULL)) {
+            fprintf(stderr, "[Script] %s:%u: need 'repeat N <command>' with N > 0\n", path, lineno);
+            goto fail;
+        }
+
+        // repeat / show 뒤의 expect도 여기서 문법 확인
+        const char* cmd = text;
+        if ((arg = script_keyword(cmd, "repeat")) != NULL) cmd = strchr(arg, ' ') + 1;
+        if ((arg = script_keyword(cmd, "show")) != NULL) cmd = arg;
+        if ((arg = script_keyword(cmd, "expect")) != NULL && !script_expect_valid(arg)) {
+            fprintf(stderr, "[Script] %s:%u: need 'expect 0xXXXXXXXX R <idx>' or 'expect fail <command>'\n",
+                    path, lineno);
+            goto fail;
+        }
+        sc->count++;
+    }
+    fclose(fp);
+    if (depth > 0) {
+        fprintf(stderr, "[Script] %s:%u: 'loop' without 'end'\n", path, sc->lines[stack[depth - 1]].lineno);
+        free(sc->lines);
+        return -1;
+    }
+    return 0;
+
+fail:
+    fclose(fp);
+    free(sc->lines);
+    return -1;
+}
+
+// $i를 반복 번호로 바꾼 뒤 실행하고 줄별 시간 누적, 실패 / expect 불일치면 스크립트를 멈춤
+static void script_exec(Script* sc, ScriptLine* l, const char* cmd, long iter, bool show) {
+    char buf[CMD_LINE_MAX];
+    size_t out = 0;
+
+    for (const char* p = cmd; *p && out < sizeof(buf) - 1; p++) {
+        if (p[0] == '$' && p[1] == 'i') {
+            out += snprintf(buf + out, sizeof(buf) - out, "%ld", iter < 0 ? 0 : iter);
+            if (out >= sizeof(buf)) out = sizeof(buf) - 1;
+            p++;
+        } else {
+            buf[out++] = *p;
+        }
+    }
+    buf[out] = '\0';
+
+    // expect: 실행할 명령과 기대 결과를 분리
+    char* run = buf;
+    const char* arg;
+    bool expect_fail = false, expect_value = false;
+    unsigned int expected = 0;
+    if ((arg = script_keyword(buf, "expect")) != NULL) {
+        const char* rest;
+        if ((rest = script_keyword(arg, "fail")) != NULL) {
+            expect_fail = true;
+        } else {
+            sscanf(arg, "0x%8x", &expected);
+            expect_value = true;
+            rest = arg + 11;
+        }
+        run = buf + (rest - buf);
+    }
+    char text[CMD_LINE_MAX];
+    strcpy(text, run);      // executecommand가 strtok로 자르므로 메시지용 사본
+
+    // 출력은 스크립트 내내 버리고 show 명령만 잠시 되돌림
+    bool reveal = show && sc->saved_stdout >= 0;
+    if (reveal) {
+        bench_quiet_end(sc->saved_stdout);
+    }
+    unsigned long long sim0 = ssd_get_virtual_time_us();
+    double start = script_now();
+    int ret = executecommand(run);
+    l->wall_s += script_now() - start;
+    l->sim_us += ssd_get_virtual_time_us() - sim0;
+    l->runs++;
+    if (reveal) {
+        sc->saved_stdout = bench_quiet_begin();
+    }
+
+    if (expect_fail) {
+        if (ret == 0) {
+            fprintf(stderr, "[Script] %s:%u: '%s' succeeded, expected failure\n", sc->path, l->lineno, text);
+            sc->failed = true;
+        }
+    } else if (ret != 0) {
+        fprintf(stderr, "[Script] %s:%u: '%s' failed\n", sc->path, l->lineno, text);
+        sc->failed = true;
+    } else if (expect_value && last_read_value != expected) {
+        fprintf(stderr, "[Script] %s:%u: '%s' returned 0x%08X, expected 0x%08X\n",
+                sc->path, l->lineno, text, last_read_value, expected);
+        sc->failed = true;
+    }
+    if (sc->failed) {
+        sc->stop = true;
     }
 }
 
+// lines[first, last) 실행 (iter = 둘러싼 반복 번호)
+static void script_run(Script* sc, uint32_t first, uint32_t last, long iter) {
+    for (uint32_t i = first; i < last && !sc->stop; i++) {
+        ScriptLine* l = &sc->lines[i];
+        const char* arg;
+
+        if ((arg = script_keyword(l->text, "loop")) != NULL) {
+            long n = atol(arg);
+            unsigned long long sim0 = ssd_get_virtual_time_us();
+            double start = script_now();
+            for (long k = 0; k < n && !sc->stop; k++) {
+                script_run(sc, i + 1, l->end, k);
+            }
+            l->wall_s += script_now() - start;
+            l->sim_us += ssd_get_virtual_time_us() - sim0;
+            l->runs++;
+            i = l->end;
+        } else if ((arg = script_keyword(l->text, "repeat")) != NULL) {
+            long n = atol(arg);
+            const char* cmd = strchr(arg, ' ') + 1;
+            const char* shown = script_keyword(cmd, "show");
+            for (long k = 0; k < n && !sc->stop; k++) {
+                script_exec(sc, l, shown ? shown : cmd, k, shown != NULL);
+            }
+        } else if ((arg = script_keyword(l->text, "show")) != NULL) {
+            script_exec(sc, l, arg, iter, true);
+        } else if (strcmp(l->text, "exit") == 0) {
+            sc->stop = true;
+        } else {
+            script_exec(sc, l, l->text, iter, false);
+        }
+    }
+}
+
+static int run_script(const char* path, bool verbose, const char* image) {
+    Script sc = { NULL, 0, verbose, false, -1, false, path };
+
+    if (script_load(&sc, path) != 0) {
+        return 1;
+    }
+    SsdContext* ctx = ssd_open(image);
+    if (ctx == NULL) {
+        free(sc.lines);
+        return 1;
+    }
+    ssd_use(ctx);
+
+    if (!verbose) {
+        sc.saved_stdout = bench_quiet_begin();
+    }
+    // mount는 스크립트 시간에서 제외
+    unsigned long long sim0 = ssd_get_virtual_time_us();
+    double start = script_now();
+    script_run(&sc, 0, sc.count, -1);
+    double wall = script_now() - start;
+    unsigned long long sim = ssd_get_virtual_time_us() - sim0;
+    if (!verbose) {
+        bench_quiet_end(sc.saved_stdout);
+    }
+
+    printf("\n========== Script %s ==========\n", path);
+    printf("%5s %9s %11s %11s  %s\n", "Line", "Runs", "Wall ms", "Sim ms", "Command");
+    for (uint32_t i = 0; i < sc.count; i++) {
+        ScriptLine* l = &sc.lines[i];
+        if (l->runs == 0) continue;
+        printf("%5u %9lu %11.2f %11.2f  %s\n", l->lineno, l->runs, l->wall_s * 1000.0, l->sim_us / 1000.0,
+               l->text);
+    }
+    printf("Total: %.2f ms wall, %.2f ms simulated NAND time", wall * 1000.0, sim / 1000.0);
+    if (wall > 0 && sim > 0) {
+        printf(" (%.1fx real time)", sim / 1e6 / wall);
+    }
+    printf("\n");
+    if (sc.failed) {
+        printf("Script FAILED (see stderr)\n");
+    }
+
+    int saved = verbose ? -1 : bench_quiet_begin();
+    ssd_close(ctx);
+    if (!verbose) bench_quiet_end(saved);
+    free(sc.lines);
+    return sc.failed ? 1 : 0;
+}
+
 int main(int argc, char* argv[]) {
+    const char* script = NULL;
+    const char* image = NULL;
+    bool verbose = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+            script = argv[++i];
+        } else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
+            image = argv[++i];
+        } else if (strcmp(argv[i], "-v") == 0) {
+            verbose = true;
+        } else {
+            fprintf(stderr, "사용법: %s [-f script.txt [-v] [-i image]]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (script != NULL) {
+        return run_script(script, verbose, image);
+    }
+
     printf("========================================\n");
     printf("  SSD Simulator with FTL & GC\n");
     printf("  Type 'help' for available commands\n");
@@ -509,8 +1185,11 @@ int main(int argc, char* argv[]) {
     
     while (1) {
         printf("ssd> ");
-        char cmd[1000];
-        fgets(cmd, sizeof(cmd), stdin);
+        char cmd[CMD_LINE_MAX];
+        if (fgets(cmd, sizeof(cmd), stdin) == NULL) {
+            strcpy(cmd, "exit");    // 입력 끝 (파이프)
+            printf("\n");
+        }
         cmd[strcspn(cmd, "\n")] = '\0';  // 줄바꿈 문자 제거
         
         if (strcmp(cmd, "exit") == 0) {
@@ -0,0 +1,212 @@
+/*
+ * tune.c - Online GC Auto-Tuning
+ */
+
+#include "tune.h"
+#include "ftl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+
+// ==================== INTERNAL HELPERS ====================
+
+static void tune_log(FTL *ftl, const char *fmt, ...) {
+    AutoTune *t = &ftl->tune;
+    TuneLogEntry *e = &t->log[t->log_count++ % TUNE_LOG_MAX];
+    va_list ap;
+
+    va_start(ap, fmt);
+    vsnprintf(e->msg, sizeof(e->msg), fmt, ap);
+    va_end(ap);
+    e->window = t->windows;
+    printf("[TUNE] window %lu: %s\n", t->windows, e->msg);
+}
+
+static void tune_window_start(FTL *ftl) {
+    AutoTune *t = &ftl->tune;
+
+    memset(t->lba_writes, 0, sizeof(t->lba_writes));
+    t->writes = 0;
+    t->nand_start = ftl->nand.total_page_writes;
+    t->victims = 0;
+    t->victim_valid = 0;
+}
+
+static int tune_cmp_desc(const void *a, const void *b) {
+    uint16_t x = *(const uint16_t *)a, y = *(const uint16_t *)b;
+    return (x < y) - (x > y);
+}
+
+// 이번 창에서 가장 많이 쓰인 TUNE_HOT_SHARE_PCT% LBA가 받은 쓰기 비율
+static double tune_window_skew(AutoTune *t) {
+    uint16_t counts[TUNE_LBA_MAX];
+    uint32_t lbas = TOTAL_LOGICAL_PAGES < TUNE_LBA_MAX ? TOTAL_LOGICAL_PAGES : TUNE_LBA_MAX;
+    uint32_t top = lbas * TUNE_HOT_SHARE_PCT / 100;
+    uint64_t hot = 0;
+
+    memcpy(counts, t->lba_writes, lbas * sizeof(uint16_t));
+    qsort(counts, lbas, sizeof(uint16_t), tune_cmp_desc);
+    for (uint32_t i = 0; i < top; i++) {
+        hot += counts[i];
+    }
+    return t->writes ? (double)hot / t->writes : 0.0;
+}
+
+static void tune_set_low(FTL *ftl, uint32_t low) {
+    ftl_set_gc_watermarks(ftl, low, low + TUNE_WM_GAP);
+}
+
+// ==================== CONTROLLER ====================
+
+static const char *tune_knob_name(TuneKnob k) {
+    switch (k) {
+        case TUNE_KNOB_POLICY:  return "policy";
+        case TUNE_KNOB_WM_DOWN: return "watermark down";
+        case TUNE_KNOB_WM_UP:   return "watermark up";
+        default:                return "none";
+    }
+}
+
+static void tune_start_trial(FTL *ftl, TuneKnob knob) {
+    AutoTune *t = &ftl->tune;
+
+    t->trial = knob;
+    t->trial_settle = 1;
+    t->trial_baseline = t->waf;
+    t->prev_policy = ftl->gc_policy.policy->name;
+    t->prev_low = ftl->gc_low_watermark;
+    t->decisions++;
+}
+
+// 안정화 창이 지난 뒤 WAF로 시험 중인 변경을 유지 / 되돌림
+static void tune_evaluate(FTL *ftl) {
+    AutoTune *t = &ftl->tune;
+
+    if (t->waf > t->trial_baseline * (1.0 + TUNE_WAF_TOLERANCE)) {
+        gc_policy_set(ftl, t->prev_policy, 0);
+        tune_set_low(ftl, t->prev_low);
+        t->backoff[t->trial] = TUNE_BACKOFF_WINDOWS;
+        t->reverts++;
+        tune_log(ftl, "revert %s (WAF %.3f -> %.3f), back to %s %u%%/%u%%", tune_knob_name(t->trial),
+                 t->trial_baseline, t->waf, t->prev_policy, t->prev_low, t->prev_low + TUNE_WM_GAP);
+    } else {
+        tune_log(ftl, "keep %s (WAF %.3f -> %.3f)", tune_knob_name(t->trial), t->trial_baseline, t->waf);
+    }
+    t->trial = TUNE_KNOB_NONE;
+    t->regime_skew = t->skew;
+}
+
+static void tune_decide(FTL *ftl) {
+    AutoTune *t = &ftl->tune;
+    const char *want = t->skew >= TUNE_SKEW_HOT ? "cost-benefit" : "greedy";
+    uint32_t low = ftl->gc_low_watermark;
+
+    if (strcmp(want, ftl->gc_policy.policy->name) != 0 && t->backoff[TUNE_KNOB_POLICY] == 0) {
+        tune_start_trial(ftl, TUNE_KNOB_POLICY);
+        gc_policy_set(ftl, want, 0);
+        tune_log(ftl, "policy %s -> %s (skew %.2f)", t->prev_policy, want, t->skew);
+    } else if (t->valid_ratio >= TUNE_VALID_HIGH && low > TUNE_WM_MIN && t->backoff[TUNE_KNOB_WM_DOWN] == 0) {
+        uint32_t to = low - TUNE_WM_MIN > TUNE_WM_STEP ? low - TUNE_WM_STEP : TUNE_WM_MIN;
+        tune_start_trial(ftl, TUNE_KNOB_WM_DOWN);
+        tune_set_low(ftl, to);
+        tune_log(ftl, "watermark %u%% -> %u%% (victim valid %.2f)", low, to, t->valid_ratio);
+    } else if (t->valid_ratio < TUNE_VALID_LOW && low < TUNE_WM_MAX && t->backoff[TUNE_KNOB_WM_UP] == 0) {
+        uint32_t to = TUNE_WM_MAX - low > TUNE_WM_STEP ? low + TUNE_WM_STEP : TUNE_WM_MAX;
+        tune_start_trial(ftl, TUNE_KNOB_WM_UP);
+        tune_set_low(ftl, to);
+        tune_log(ftl, "watermark %u%% -> %u%% (victim valid %.2f)", low, to, t->valid_ratio);
+    }
+}
+
+static void tune_window_end(FTL *ftl) {
+    AutoTune *t = &ftl->tune;
+    double skew = tune_window_skew(t);
+
+    t->waf = (double)(ftl->nand.total_page_writes - t->nand_start) / t->writes;
+    if (t->windows == 0) {
+        t->skew = skew;
+        t->regime_skew = skew;
+    } else {
+        t->skew = TUNE_EWMA_ALPHA * skew + (1.0 - TUNE_EWMA_ALPHA) * t->skew;
+    }
+    if (t->victims) {
+        double ratio = (double)t->victim_valid / t->victims / PAGES_PER_BLOCK;
+        t->valid_ratio = t->windows == 0 ? ratio : TUNE_EWMA_ALPHA * ratio + (1.0 - TUNE_EWMA_ALPHA) * t->valid_ratio;
+    }
+    t->windows++;
+    for (int k = 0; k < TUNE_KNOB_COUNT; k++) {
+        if (t->backoff[k]) t->backoff[k]--;
+    }
+
+    if (t->trial != TUNE_KNOB_NONE) {
+        if (t->trial_settle) {
+            t->trial_settle--;
+        } else {
+            tune_evaluate(ftl);
+        }
+        return;
+    }
+
+    // phase 변화: 예전 workload에서 되돌렸던 변경도 다시 시도
+    if (skew > t->regime_skew + TUNE_SKEW_SHIFT || skew < t->regime_skew - TUNE_SKEW_SHIFT) {
+        tune_log(ftl, "workload shift (skew %.2f -> %.2f)", t->regime_skew, skew);
+        memset(t->backoff, 0, sizeof(t->backoff));
+        t->skew = skew;
+        t->regime_skew = skew;
+    }
+    tune_decide(ftl);
+}
+
+// ==================== PUBLIC API ====================
+
+void tune_enable(FTL *ftl, bool on) {
+    AutoTune *t = &ftl->tune;
+
+    memset(t, 0, sizeof(AutoTune));
+    t->enabled = on;
+    tune_window_start(ftl);
+}
+
+void tune_note_write(FTL *ftl, uint32_t lba) {
+    AutoTune *t = &ftl->tune;
+
+    if (!t->enabled) {
+        return;
+    }
+    if (lba < TUNE_LBA_MAX && t->lba_writes[lba] < UINT16_MAX) {
+        t->lba_writes[lba]++;
+    }
+    if (++t->writes == TUNE_WINDOW_WRITES) {
+        tune_window_end(ftl);
+        tune_window_start(ftl);
+    }
+}
+
+void tune_note_victim(FTL *ftl, uint32_t valid_pages) {
+    if (ftl->tune.enabled) {
+        ftl->tune.victims++;
+        ftl->tune.victim_valid += valid_pages;
+    }
+}
+
+// ==================== STATISTICS ====================
+
+void tune_print_status(FTL *ftl) {
+    AutoTune *t = &ftl->tune;
+
+    printf("\n========== GC Auto-Tuning ==========\n");
+    printf("State:        %s, %lu windows of %d writes\n", t->enabled ? "on" : "off", t->windows,
+           TUNE_WINDOW_WRITES);
+    printf("Current:      %s, watermark %u%% -> %u%%\n", ftl->gc_policy.policy->name,
+           ftl->gc_low_watermark, ftl->gc_high_watermark);
+    printf("Observed:     WAF %.3f, skew %.2f, victim valid %.2f\n", t->waf, t->skew, t->valid_ratio);
+    printf("Decisions:    %lu (%lu reverted)%s\n", t->decisions, t->reverts,
+           t->trial != TUNE_KNOB_NONE ? ", trial in progress" : "");
+    uint32_t first = t->log_count > TUNE_LOG_MAX ? t->log_count - TUNE_LOG_MAX : 0;
+    for (uint32_t i = first; i < t->log_count; i++) {
+        const TuneLogEntry *e = &t->log[i % TUNE_LOG_MAX];
+        printf("  [%5lu] %s\n", e->window, e->msg);
+    }
+    printf("====================================\n");
+}
@@ -0,0 +1,100 @@
+/*
+ * tune.h - Online GC Auto-Tuning
+ *
+ * 호스트 쓰기 TUNE_WINDOW_WRITES개마다 한 창을 닫고 다음을 관찰한다.
+ * - 구간 WAF (창 동안의 NAND program / host write)
+ * - GC victim의 valid page 비율
+ * - 쓰기 skew (창 동안 가장 많이 쓰인 20% LBA가 받은 쓰기 비율, 균등이면 약 0.2)
+ * valid 비율과 skew는 창마다 지수 이동 평균으로 다듬는다.
+ *
+ * 제어 규칙 (한 번에 하나만 바꿈):
+ * - 정책: skew가 TUNE_SKEW_HOT 이상이면 cost-benefit (hot / cold 분리), 아니면 greedy
+ * - watermark: victim valid 비율이 높으면 (GC가 비쌈) 하위 watermark를 낮춰 invalid를
+ *   더 모은 뒤 회수하고, 낮으면 (GC가 쌈) 기본 여유 공간 쪽으로 되돌림. 상위 = 하위 + 간격
+ * 바꾼 뒤 한 창은 안정화로 버리고 그다음 창의 WAF를 바꾸기 전과 비교해서 나빠졌으면 되돌리고
+ * 같은 변경을 TUNE_BACKOFF_WINDOWS 동안 다시 시도하지 않는다. skew가 크게 바뀌면 (phase 변화)
+ * backoff를 풀고 다시 판단한다. 모든 결정은 [TUNE] 로그와 최근 기록 ring에 남긴다.
+ */
+
+#ifndef TUNE_H
+#define TUNE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ==================== TUNING CONFIGURATION ====================
+#define TUNE_WINDOW_WRITES      4096        // 관찰 창 (host writes)
+#define TUNE_LBA_MAX            1024        // skew 추정용 LBA별 카운터 (TOTAL_LOGICAL_PAGES 이상)
+#define TUNE_HOT_SHARE_PCT      20          // skew = 상위 20% LBA의 쓰기 비율
+#define TUNE_EWMA_ALPHA         0.5
+#define TUNE_SKEW_HOT           0.55        // 이 이상이면 skewed (cost-benefit)
+#define TUNE_SKEW_SHIFT         0.15        // 결정 당시 skew에서 이만큼 벗어나면 phase 변화
+#define TUNE_VALID_HIGH         0.25        // victim valid 비율이 이 이상이면 watermark 내림
+#define TUNE_VALID_LOW          0.10        // 이 미만이면 watermark 올림
+#define TUNE_WM_MIN             5           // 하위 watermark 범위 (%)
+#define TUNE_WM_MAX             GC_THRESHOLD
+#define TUNE_WM_STEP            2           // 범위 끝에서는 남은 만큼만
+#define TUNE_WM_GAP             (GC_HIGH_WATERMARK - GC_THRESHOLD)
+#define TUNE_WAF_TOLERANCE      0.03        // 변경 후 WAF가 3% 넘게 나빠지면 되돌림
+#define TUNE_BACKOFF_WINDOWS    8
+#define TUNE_LOG_MAX            32
+#define TUNE_LOG_LEN            96
+
+// ==================== DATA STRUCTURES ====================
+
+typedef enum {
+    TUNE_KNOB_NONE = 0,
+    TUNE_KNOB_POLICY,
+    TUNE_KNOB_WM_DOWN,
+    TUNE_KNOB_WM_UP,
+    TUNE_KNOB_COUNT
+} TuneKnob;
+
+typedef struct {
+    uint64_t window;            // 결정한 창 번호
+    char msg[TUNE_LOG_LEN];
+} TuneLogEntry;
+
+typedef struct {
+    bool enabled;
+
+    // 이번 창
+    uint16_t lba_writes[TUNE_LBA_MAX];
+    uint32_t writes;
+    uint64_t nand_start;        // 창 시작 시 NAND program 수
+    uint64_t victims;
+    uint64_t victim_valid;      // victim들의 valid page 합
+
+    // 창 단위 추정
+    uint64_t windows;
+    double waf;                 // 마지막 창의 구간 WAF
+    double skew;                // EWMA
+    double valid_ratio;         // EWMA (GC가 없던 창은 그대로)
+    double regime_skew;         // 지금 설정을 고를 때의 skew
+
+    // 시험 중인 변경 (안정화 1창 + 평가 1창)
+    TuneKnob trial;
+    uint32_t trial_settle;
+    double trial_baseline;      // 바꾸기 직전 창의 WAF
+    const char *prev_policy;
+    uint32_t prev_low;
+    uint32_t backoff[TUNE_KNOB_COUNT];
+
+    // 결정 기록
+    uint64_t decisions;
+    uint64_t reverts;
+    TuneLogEntry log[TUNE_LOG_MAX];
+    uint32_t log_count;         // 지금까지 남긴 수 (ring은 마지막 TUNE_LOG_MAX개)
+} AutoTune;
+
+struct FTL;
+
+// ==================== FUNCTION PROTOTYPES ====================
+
+void tune_enable(struct FTL *ftl, bool on);
+void tune_note_write(struct FTL *ftl, uint32_t lba);              // ftl_write 성공 후
+void tune_note_victim(struct FTL *ftl, uint32_t valid_pages);     // GC victim 하나를 옮긴 뒤
+
+void tune_print_status(struct FTL *ftl);
+
+#endif // TUNE_H
@@ -0,0 +1,315 @@
+/*
+ * zns.c - Zoned Namespace (ZNS) Host Interface
+ */
+
+#include "zns.h"
+#include "ftl.h"
+#include <stdio.h>
+#include <string.h>
+
+// ==================== ZONE LAYOUT ====================
+
+uint32_t zns_capacity(const Zns *zns) {
+    return zns->zones * zns->zone_pages;
+}
+
+const char *zns_state_name(ZoneState state) {
+    switch (state) {
+        case ZONE_EMPTY:         return "empty";
+        case ZONE_IMPLICIT_OPEN: return "implicit-open";
+        case ZONE_EXPLICIT_OPEN: return "explicit-open";
+        case ZONE_CLOSED:        return "closed";
+        case ZONE_FULL:          return "full";
+    }
+    return "?";
+}
+
+static bool zns_is_open(ZoneState state) {
+    return state == ZONE_IMPLICIT_OPEN || state == ZONE_EXPLICIT_OPEN;
+}
+
+static uint32_t zns_count_open(const Zns *zns) {
+    uint32_t n = 0;
+
+    for (uint32_t z = 0; z < zns->zones; z++) {
+        if (zns_is_open(zns->zone[z].state)) n++;
+    }
+    return n;
+}
+
+static uint32_t zns_count_active(const Zns *zns) {
+    uint32_t n = 0;
+
+    for (uint32_t z = 0; z < zns->zones; z++) {
+        if (zns_is_open(zns->zone[z].state) || zns->zone[z].state == ZONE_CLOSED) n++;
+    }
+    return n;
+}
+
+static int zns_reject(Zns *zns, const char *msg, uint32_t zone) {
+    zns->rejected++;
+    printf("[ZNS] Zone %u: %s\n", zone, msg);
+    return -1;
+}
+
+// 쓰기 전에 zone을 open 상태로 (open 한도에 걸리면 implicit open zone 하나를 닫음)
+static int zns_activate(Zns *zns, uint32_t z, bool explicit_open) {
+    Zone *zone = &zns->zone[z];
+
+    if (zone->state == ZONE_FULL) {
+        return zns_reject(zns, "zone is full", z);
+    }
+    if (zns_is_open(zone->state)) {
+        if (explicit_open) zone->state = ZONE_EXPLICIT_OPEN;
+        return 0;
+    }
+    if (zone->state == ZONE_EMPTY && zns_count_active(zns) >= zns->max_active) {
+        return zns_reject(zns, "too many active zones", z);
+    }
+    if (zns_count_open(zns) >= zns->max_open) {
+        uint32_t victim = ZNS_MAX_ZONES;
+        for (uint32_t i = 0; i < zns->zones && victim == ZNS_MAX_ZONES; i++) {
+            if (zns->zone[i].state == ZONE_IMPLICIT_OPEN) victim = i;
+        }
+        if (victim == ZNS_MAX_ZONES) {
+            return zns_reject(zns, "too many open zones", z);
+        }
+        zns->zone[victim].state = zns->zone[victim].wp ? ZONE_CLOSED : ZONE_EMPTY;
+        zns->implicit_closes++;
+    }
+    zone->state = explicit_open ? ZONE_EXPLICIT_OPEN : ZONE_IMPLICIT_OPEN;
+    return 0;
+}
+
+// write pointer 위치에 program (zone LBA = PBA)
+static uint32_t zns_program(FTL *ftl, uint32_t z, const uint8_t *data) {
+    Zns *zns = &ftl->zns;
+    Zone *zone = &zns->zone[z];
+    uint32_t lba = z * zns->zone_pages + zone->wp;
+
+    if (nand_write_page(&ftl->nand, lba, data, LBA_TAG_ZONE | lba) != 0) {
+        return 0xFFFFFFFF;
+    }
+    zone->wp++;
+    if (zone->wp == zns->zone_pages) {
+        zone->state = ZONE_FULL;
+    }
+    zns->host_writes++;
+    zns->model_us += NAND_T_XFER_US + NAND_T_PROG_US;
+    return lba;
+}
+
+// ==================== MODE SWITCH ====================
+
+// 프로그램된 블록만 erase하고 일반 FTL 상태를 빈 NAND 기준으로 다시 mount
+static void zns_format(FTL *ftl) {
+    ftl_unmount(ftl);
+    for (uint32_t b = 0; b < TOTAL_BLOCKS; b++) {
+        if (ftl->nand.blocks[b].valid_page_count || ftl->nand.blocks[b].invalid_page_count) {
+            nand_erase_block(&ftl->nand, b);
+        }
+    }
+    ftl_mount(ftl);
+}
+
+int zns_enable(FTL *ftl, uint32_t zone_blocks) {
+    if (zone_blocks == 0 || zone_blocks > TOTAL_BLOCKS) {
+        printf("[ZNS] Zone size must be 1 ~ %d blocks\n", TOTAL_BLOCKS);
+        return -1;
+    }
+    if (ftl->journal.enabled || ftl->slc.blocks || ftl->pack.enabled || ftl->pack.unit) {
+        printf("[ZNS] Turn off journal / SLC cache / compression / sub-page first\n");
+        return -1;
+    }
+
+    // zone page가 아닌 데이터가 있으면 포맷 (zone LBA = PBA라서 zone 크기가 바뀌어도 그대로 읽힘)
+    bool foreign = false;
+    for (uint32_t pba = 0; pba < TOTAL_PAGES && !foreign; pba++) {
+        const OOB *oob = &ftl->nand.blocks[pba / PAGES_PER_BLOCK].pages[pba % PAGES_PER_BLOCK].oob;
+        foreign = oob->state != PAGE_FREE && oob->lba != (LBA_TAG_ZONE | pba);
+    }
+    if (foreign) {
+        printf("[ZNS] Formatting NAND (conventional data is discarded)\n");
+        zns_format(ftl);
+    }
+
+    Zns *zns = &ftl->zns;
+    memset(zns, 0, sizeof(Zns));
+    zns->zone_blocks = zone_blocks;
+    zns->zone_pages = zone_blocks * PAGES_PER_BLOCK;
+    zns->zones = TOTAL_BLOCKS / zone_blocks;
+    zns->max_open = ZNS_MAX_OPEN_DEFAULT;
+    zns->max_active = ZNS_MAX_ACTIVE_DEFAULT;
+    zns->enable_nand_writes = ftl->nand.total_page_writes;
+
+    // write pointer = 마지막으로 program된 page 다음. 일반 mount가 invalid로 표시한 page는 다시 valid
+    for (uint32_t z = 0; z < zns->zones; z++) {
+        Zone *zone = &zns->zone[z];
+        for (uint32_t off = 0; off < zns->zone_pages; off++) {
+            uint32_t pba = z * zns->zone_pages + off;
+            if (nand_get_page_state(&ftl->nand, pba) == PAGE_FREE) continue;
+            nand_set_page_state(&ftl->nand, pba, PAGE_VALID);
+            zone->wp = off + 1;
+        }
+        zone->state = zone->wp == 0 ? ZONE_EMPTY : zone->wp == zns->zone_pages ? ZONE_FULL : ZONE_CLOSED;
+    }
+    zns->enabled = true;
+    return 0;
+}
+
+void zns_disable(FTL *ftl) {
+    printf("[ZNS] Formatting NAND for the conventional interface\n");
+    zns_format(ftl);
+}
+
+// ==================== ZONE I/O ====================
+
+int zns_write(FTL *ftl, uint32_t lba, const uint8_t *data) {
+    Zns *zns = &ftl->zns;
+    uint32_t z = lba / zns->zone_pages;
+
+    if (lba >= zns_capacity(zns)) {
+        return zns_reject(zns, "LBA out of range", z);
+    }
+    if (lba % zns->zone_pages != zns->zone[z].wp) {
+        zns->rejected++;
+        printf("[ZNS] Zone %u: write at LBA %u but write pointer is LBA %u\n",
+               z, lba, z * zns->zone_pages + zns->zone[z].wp);
+        return -1;
+    }
+    if (zns_activate(zns, z, false) != 0) {
+        return -1;
+    }
+    return zns_program(ftl, z, data) == 0xFFFFFFFF ? -1 : 0;
+}
+
+uint32_t zns_append(FTL *ftl, uint32_t zone, const uint8_t *data) {
+    Zns *zns = &ftl->zns;
+
+    if (zone >= zns->zones) {
+        zns_reject(zns, "no such zone", zone);
+        return 0xFFFFFFFF;
+    }
+    if (zns_activate(zns, zone, false) != 0) {
+        return 0xFFFFFFFF;
+    }
+    uint32_t lba = zns_program(ftl, zone, data);
+    if (lba != 0xFFFFFFFF) {
+        zns->appends++;
+    }
+    return lba;
+}
+
+int zns_read(FTL *ftl, uint32_t lba, uint8_t *data) {
+    Zns *zns = &ftl->zns;
+    uint32_t z = lba / zns->zone_pages;
+
+    if (lba >= zns_capacity(zns) || lba % zns->zone_pages >= zns->zone[z].wp) {
+        printf("[ZNS] LBA %u is above the write pointer\n", lba);
+        return -1;
+    }
+    // Finish로 건너뛴 영역은 0으로 읽힘
+    if (nand_get_page_state(&ftl->nand, lba) == PAGE_FREE) {
+        memset(data, 0, PAGE_SIZE);
+        return 0;
+    }
+    zns->model_us += NAND_T_READ_US + NAND_T_XFER_US;
+    return nand_read_page(&ftl->nand, lba, data) == 0 ? 0 : -1;
+}
+
+// ==================== ZONE MANAGEMENT ====================
+
+int zns_open(FTL *ftl, uint32_t zone) {
+    if (zone >= ftl->zns.zones) {
+        return zns_reject(&ftl->zns, "no such zone", zone);
+    }
+    return zns_activate(&ftl->zns, zone, true);
+}
+
+int zns_close(FTL *ftl, uint32_t zone) {
+    Zns *zns = &ftl->zns;
+
+    if (zone >= zns->zones) {
+        return zns_reject(zns, "no such zone", zone);
+    }
+    Zone *zn = &zns->zone[zone];
+    if (zn->state == ZONE_CLOSED) {
+        return 0;
+    }
+    if (!zns_is_open(zn->state)) {
+        return zns_reject(zns, "zone is not open", zone);
+    }
+    zn->state = zn->wp ? ZONE_CLOSED : ZONE_EMPTY;
+    return 0;
+}
+
+int zns_finish(FTL *ftl, uint32_t zone) {
+    Zns *zns = &ftl->zns;
+
+    if (zone >= zns->zones) {
+        return zns_reject(zns, "no such zone", zone);
+    }
+    Zone *zn = &zns->zone[zone];
+    if (zn->state != ZONE_FULL) {
+        zn->state = ZONE_FULL;
+        zn->wp = zns->zone_pages;
+        zns->finishes++;
+    }
+    return 0;
+}
+
+int zns_reset(FTL *ftl, uint32_t zone) {
+    Zns *zns = &ftl->zns;
+
+    if (zone >= zns->zones) {
+        return zns_reject(zns, "no such zone", zone);
+    }
+    Zone *zn = &zns->zone[zone];
+    for (uint32_t b = zone * zns->zone_blocks; b < (zone + 1) * zns->zone_blocks; b++) {
+        if (ftl->nand.blocks[b].valid_page_count || ftl->nand.blocks[b].invalid_page_count) {
+            nand_erase_block(&ftl->nand, b);
+            zns->model_us += NAND_T_BERS_US;
+        }
+    }
+    zn->state = ZONE_EMPTY;
+    zn->wp = 0;
+    zns->resets++;
+    return 0;
+}
+
+// ==================== STATISTICS ====================
+
+void zns_report(FTL *ftl) {
+    Zns *zns = &ftl->zns;
+
+    printf("\n========== Zone Report (%u zones x %u pages) ==========\n", zns->zones, zns->zone_pages);
+    printf("%-6s %-14s %10s %10s\n", "Zone", "State", "Start LBA", "WP");
+    for (uint32_t z = 0; z < zns->zones; z++) {
+        printf("%-6u %-14s %10u %10u\n", z, zns_state_name(zns->zone[z].state),
+               z * zns->zone_pages, z * zns->zone_pages + zns->zone[z].wp);
+    }
+    printf("Open: %u / %u, Active: %u / %u\n", zns_count_open(zns), zns->max_open,
+           zns_count_active(zns), zns->max_active);
+    printf("=======================================================\n");
+}
+
+void zns_print_statistics(FTL *ftl) {
+    Zns *zns = &ftl->zns;
+    uint32_t by_state[ZONE_FULL + 1] = {0};
+    uint64_t nand_writes = ftl->nand.total_page_writes - zns->enable_nand_writes;
+
+    for (uint32_t z = 0; z < zns->zones; z++) {
+        by_state[zns->zone[z].state]++;
+    }
+    printf("\n========== ZNS Statistics ==========\n");
+    printf("Zones:               %u x %u blocks (%u pages each)\n", zns->zones, zns->zone_blocks, zns->zone_pages);
+    printf("Zone States:         %u empty, %u open, %u closed, %u full\n", by_state[ZONE_EMPTY],
+           by_state[ZONE_IMPLICIT_OPEN] + by_state[ZONE_EXPLICIT_OPEN], by_state[ZONE_CLOSED], by_state[ZONE_FULL]);
+    printf("Host Writes:         %lu (%lu appends)\n", zns->host_writes, zns->appends);
+    printf("Resets / Finishes:   %lu / %lu\n", zns->resets, zns->finishes);
+    printf("Implicit Closes:     %lu, rejected commands: %lu\n", zns->implicit_closes, zns->rejected);
+    printf("Device WAF:          %.2f (no device GC)\n",
+           zns->host_writes ? (double)nand_writes / zns->host_writes : 0.0);
+    printf("Model Time:          %.1f ms\n", zns->model_us / 1000.0);
+    printf("====================================\n");
+}
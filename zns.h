@@ -0,0 +1,88 @@
+/*
+ * zns.h - Zoned Namespace (ZNS) Host Interface
+ *
+ * 일반 블록 인터페이스 대신 NAND 블록(또는 연속 블록 묶음)을 zone으로 노출한다.
+ * - zone 안에서는 write pointer 위치에만 쓸 수 있고 (Write), Zone Append는
+ *   device가 write pointer 위치를 골라 기록한 LBA를 돌려준다
+ * - Reset Zone = zone의 블록 erase, Finish = 남은 공간을 버리고 FULL로 전환
+ * - 동시에 open / active(open + closed)일 수 있는 zone 수 제한
+ * - 배치와 회수(GC)는 호스트 책임이므로 device GC, L2P 매핑, summary는 쓰지 않는다
+ *
+ * zone LBA는 zone 번호 * zone 크기 + offset이고, zone이 연속 블록이므로 PBA와 같다.
+ * OOB lba에는 LBA_TAG_ZONE | zone LBA를 기록해서 zns on 때 zone 상태를 다시 만든다.
+ * 일반 모드로 mount하면 zone page는 참조되지 않는 page로 취급된다.
+ */
+
+#ifndef ZNS_H
+#define ZNS_H
+
+#include "nand_flash.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// ==================== ZNS CONFIGURATION ====================
+#define ZNS_ZONE_BLOCKS_DEFAULT     1       // zone 하나를 이루는 erase block 수
+#define ZNS_MAX_OPEN_DEFAULT        4       // 동시에 open 가능한 zone
+#define ZNS_MAX_ACTIVE_DEFAULT      8       // open + closed zone 합계 한도
+#define ZNS_MAX_ZONES               TOTAL_BLOCKS
+
+// ==================== DATA STRUCTURES ====================
+
+typedef enum {
+    ZONE_EMPTY = 0,
+    ZONE_IMPLICIT_OPEN,         // Write / Append로 열림 (자원이 모자라면 device가 닫을 수 있음)
+    ZONE_EXPLICIT_OPEN,         // Open Zone 명령으로 열림
+    ZONE_CLOSED,                // 쓰다 만 상태로 닫힘 (active 자원은 유지)
+    ZONE_FULL
+} ZoneState;
+
+typedef struct {
+    ZoneState state;
+    uint32_t wp;                // zone 안 다음 쓰기 offset (page)
+} Zone;
+
+typedef struct {
+    bool enabled;
+    uint32_t zone_blocks;
+    uint32_t zone_pages;        // zone 크기 = zone_blocks * PAGES_PER_BLOCK
+    uint32_t zones;
+    uint32_t max_open;
+    uint32_t max_active;
+    Zone zone[ZNS_MAX_ZONES];
+
+    // 통계
+    uint64_t host_writes;       // Write + Append로 기록한 page
+    uint64_t appends;
+    uint64_t resets;
+    uint64_t finishes;
+    uint64_t implicit_closes;   // open 한도 때문에 device가 닫은 zone
+    uint64_t rejected;          // write pointer / 상태 / 한도 위반으로 거절한 명령
+    uint64_t model_us;          // zone 명령 모델 시간 합계
+    uint64_t enable_nand_writes;// zns on 시점의 NAND program 수 (device WAF 계산)
+} Zns;
+
+struct FTL;
+
+// ==================== FUNCTION PROTOTYPES ====================
+
+// zns 모드 전환. 일반 데이터가 있으면 NAND를 포맷, zone page만 있으면 zone 상태를 복구
+int zns_enable(struct FTL *ftl, uint32_t zone_blocks);
+void zns_disable(struct FTL *ftl);      // NAND 포맷 후 일반 FTL로 mount
+uint32_t zns_capacity(const Zns *zns);  // zone LBA 수
+
+// zone I/O (실패 시 -1 / 0xFFFFFFFF)
+int zns_write(struct FTL *ftl, uint32_t lba, const uint8_t *data);     // lba == write pointer여야 함
+uint32_t zns_append(struct FTL *ftl, uint32_t zone, const uint8_t *data); // 기록한 LBA 반환
+int zns_read(struct FTL *ftl, uint32_t lba, uint8_t *data);
+
+// zone 관리
+int zns_open(struct FTL *ftl, uint32_t zone);
+int zns_close(struct FTL *ftl, uint32_t zone);
+int zns_finish(struct FTL *ftl, uint32_t zone);
+int zns_reset(struct FTL *ftl, uint32_t zone);
+
+const char *zns_state_name(ZoneState state);
+void zns_report(struct FTL *ftl);
+void zns_print_statistics(struct FTL *ftl);
+
+#endif // ZNS_H